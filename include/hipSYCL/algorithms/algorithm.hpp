@@ -41,6 +41,8 @@
 #include "util/traits.hpp"
 #include "hipSYCL/algorithms/util/allocation_cache.hpp"
 #include "hipSYCL/algorithms/util/memory_streaming.hpp"
+#include "hipSYCL/algorithms/sort/merge_sort.hpp"
+#include "hipSYCL/algorithms/sort/radix_sort.hpp"
 
 namespace hipsycl::algorithms {
 
@@ -469,6 +471,94 @@ sycl::event none_of(sycl::queue &q,
   });
 }
 
+
+namespace detail {
+
+template <class KeyIt, class ValueIt, class Compare>
+sycl::event sort_impl(sycl::queue &q,
+                      util::allocation_group &scratch_allocations,
+                      KeyIt keys_first, KeyIt keys_last, ValueIt values_first,
+                      Compare comp) {
+  using key_type = typename std::iterator_traits<KeyIt>::value_type;
+  constexpr bool has_values = !std::is_same_v<ValueIt, sorting::no_values *>;
+
+  std::size_t problem_size = std::distance(keys_first, keys_last);
+  if(problem_size <= 1)
+    return sycl::event{};
+
+  constexpr bool is_radix_sortable =
+      sorting::radix::is_radix_sortable<key_type>() &&
+      util::is_contiguous<KeyIt>() &&
+      (!has_values || util::is_contiguous<ValueIt>());
+  constexpr auto order = is_radix_sortable
+                             ? sorting::radix::get_order<key_type, Compare>()
+                             : sorting::radix::order::unsupported;
+
+  if constexpr(order == sorting::radix::order::unsupported) {
+    return sorting::merge_sort(q, scratch_allocations, keys_first,
+                               problem_size, comp, values_first);
+  } else if constexpr(has_values) {
+    return sorting::radix_sort<order>(q, scratch_allocations, &(*keys_first),
+                                      problem_size, &(*values_first));
+  } else {
+    return sorting::radix_sort<order>(q, scratch_allocations, &(*keys_first),
+                                      problem_size);
+  }
+}
+
+}
+
+// Note: All sort variants are stable. Arithmetic keys in contiguous memory
+// that are compared using std::less or std::greater use radix sort, all
+// other cases use merge sort. Element types must be trivially copyable.
+// Requires an in-order queue.
+template <class RandomIt, class Compare>
+sycl::event sort(sycl::queue &q, util::allocation_group &scratch_allocations,
+                 RandomIt first, RandomIt last, Compare comp) {
+  return detail::sort_impl(q, scratch_allocations, first, last,
+                           static_cast<sorting::no_values *>(nullptr), comp);
+}
+
+template <class RandomIt>
+sycl::event sort(sycl::queue &q, util::allocation_group &scratch_allocations,
+                 RandomIt first, RandomIt last) {
+  return sort(q, scratch_allocations, first, last, std::less<>{});
+}
+
+template <class RandomIt, class Compare>
+sycl::event stable_sort(sycl::queue &q,
+                        util::allocation_group &scratch_allocations,
+                        RandomIt first, RandomIt last, Compare comp) {
+  return sort(q, scratch_allocations, first, last, comp);
+}
+
+template <class RandomIt>
+sycl::event stable_sort(sycl::queue &q,
+                        util::allocation_group &scratch_allocations,
+                        RandomIt first, RandomIt last) {
+  return sort(q, scratch_allocations, first, last);
+}
+
+/// Sorts the keys in [keys_first, keys_last) and applies the same
+/// permutation to the values starting at values_first.
+template <class KeyIt, class ValueIt, class Compare>
+sycl::event sort_by_key(sycl::queue &q,
+                        util::allocation_group &scratch_allocations,
+                        KeyIt keys_first, KeyIt keys_last, ValueIt values_first,
+                        Compare comp) {
+  return detail::sort_impl(q, scratch_allocations, keys_first, keys_last,
+                           values_first, comp);
+}
+
+template <class KeyIt, class ValueIt>
+sycl::event sort_by_key(sycl::queue &q,
+                        util::allocation_group &scratch_allocations,
+                        KeyIt keys_first, KeyIt keys_last,
+                        ValueIt values_first) {
+  return sort_by_key(q, scratch_allocations, keys_first, keys_last,
+                     values_first, std::less<>{});
+}
+
 }
 
 #endif
@@ -41,6 +41,8 @@
 #include "hipSYCL/algorithms/reduction/reduction_descriptor.hpp"
 #include "hipSYCL/algorithms/reduction/reduction_engine.hpp"
 #include "hipSYCL/algorithms/util/memory_streaming.hpp"
+#include "hipSYCL/algorithms/scan/decoupled_lookback_scan.hpp"
+#include "hipSYCL/algorithms/scan/threading_model_scan.hpp"
 
 namespace hipsycl::algorithms {
 
@@ -207,6 +209,41 @@ sycl::event transform_reduce_impl(sycl::queue &q,
 
 }
 
+template <bool IsInclusive, bool HasInit, class T, class Generator,
+          class OutputIt, class BinaryOp>
+sycl::event scan_impl(sycl::queue &q,
+                      util::allocation_group &scratch_allocations,
+                      std::size_t n, Generator gen, OutputIt d_first,
+                      BinaryOp op, T init) {
+  if(q.get_device().is_host())
+    return scanning::threading_model_scan<IsInclusive, HasInit>(
+        q, scratch_allocations, n, gen, d_first, op, init);
+
+  return scanning::scan<IsInclusive, HasInit>(q, scratch_allocations, n, gen,
+                                              d_first, op, init);
+}
+
+template <bool IsInclusive, bool HasInit, class T, class ForwardIt1,
+          class ForwardIt2, class BinaryOp, class UnaryTransformOp>
+sycl::event transform_scan_impl(sycl::queue &q,
+                                util::allocation_group &scratch_allocations,
+                                ForwardIt1 first, ForwardIt1 last,
+                                ForwardIt2 d_first, BinaryOp op,
+                                UnaryTransformOp transform, T init) {
+  if(first == last)
+    return sycl::event{};
+
+  std::size_t n = std::distance(first, last);
+  auto gen = [=](std::size_t i) -> T {
+    auto input = first;
+    std::advance(input, i);
+    return transform(*input);
+  };
+
+  return scan_impl<IsInclusive, HasInit>(q, scratch_allocations, n, gen,
+                                         d_first, op, init);
+}
+
 }
 
 // Note: All transform_reduce variants defined here behave slightly different than STL
@@ -289,6 +326,98 @@ sycl::event reduce(sycl::queue &q, util::allocation_group &scratch_allocations,
                 typename std::iterator_traits<ForwardIt>::value_type{});
 }
 
+// Note: All scan variants defined here behave slightly different than STL
+// variants:
+// * They return an event instead of the output iterator past the last element
+//   written.
+// * If first==last, returns an event that is complete, even if preceding
+//   enqueued operations are not yet complete.
+// * Require an in-order queue.
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryTransformOp, class T>
+sycl::event
+transform_inclusive_scan(sycl::queue &q,
+                         util::allocation_group &scratch_allocations,
+                         ForwardIt1 first, ForwardIt1 last, ForwardIt2 d_first,
+                         BinaryOp binary_op, UnaryTransformOp unary_op,
+                         T init) {
+  return detail::transform_scan_impl<true, true>(
+      q, scratch_allocations, first, last, d_first, binary_op, unary_op, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryTransformOp>
+sycl::event
+transform_inclusive_scan(sycl::queue &q,
+                         util::allocation_group &scratch_allocations,
+                         ForwardIt1 first, ForwardIt1 last, ForwardIt2 d_first,
+                         BinaryOp binary_op, UnaryTransformOp unary_op) {
+  using value_type = std::decay_t<decltype(unary_op(*first))>;
+  return detail::transform_scan_impl<true, false>(
+      q, scratch_allocations, first, last, d_first, binary_op, unary_op,
+      value_type{});
+}
+
+template <class ForwardIt1, class ForwardIt2, class T, class BinaryOp,
+          class UnaryTransformOp>
+sycl::event
+transform_exclusive_scan(sycl::queue &q,
+                         util::allocation_group &scratch_allocations,
+                         ForwardIt1 first, ForwardIt1 last, ForwardIt2 d_first,
+                         T init, BinaryOp binary_op,
+                         UnaryTransformOp unary_op) {
+  return detail::transform_scan_impl<false, true>(
+      q, scratch_allocations, first, last, d_first, binary_op, unary_op, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp, class T>
+sycl::event inclusive_scan(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first, BinaryOp binary_op, T init) {
+  return transform_inclusive_scan(q, scratch_allocations, first, last, d_first,
+                                  binary_op, [](auto x) { return x; }, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp>
+sycl::event inclusive_scan(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first, BinaryOp binary_op) {
+  using value_type = typename std::iterator_traits<ForwardIt1>::value_type;
+  return transform_inclusive_scan(q, scratch_allocations, first, last, d_first,
+                                  binary_op,
+                                  [](const value_type &x) { return x; });
+}
+
+template <class ForwardIt1, class ForwardIt2>
+sycl::event inclusive_scan(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first) {
+  using value_type = typename std::iterator_traits<ForwardIt1>::value_type;
+  return inclusive_scan(q, scratch_allocations, first, last, d_first,
+                        std::plus<value_type>{});
+}
+
+template <class ForwardIt1, class ForwardIt2, class T, class BinaryOp>
+sycl::event exclusive_scan(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first, T init, BinaryOp binary_op) {
+  return transform_exclusive_scan(q, scratch_allocations, first, last, d_first,
+                                  init, binary_op, [](auto x) { return x; });
+}
+
+template <class ForwardIt1, class ForwardIt2, class T>
+sycl::event exclusive_scan(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first, T init) {
+  return exclusive_scan(q, scratch_allocations, first, last, d_first, init,
+                        std::plus<T>{});
+}
+
 }
 
 #endif
@@ -0,0 +1,262 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_ALGORITHMS_DECOUPLED_LOOKBACK_SCAN_HPP
+#define HIPSYCL_ALGORITHMS_DECOUPLED_LOOKBACK_SCAN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#include "hipSYCL/sycl/libkernel/accessor.hpp"
+#include "hipSYCL/sycl/libkernel/atomic_ref.hpp"
+#include "hipSYCL/sycl/libkernel/nd_item.hpp"
+#include "hipSYCL/sycl/event.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/algorithms/reduction/wg_model/group_reduction_algorithms.hpp"
+
+namespace hipsycl::algorithms::scanning {
+
+namespace decoupled_lookback {
+
+// Status of a tile as published to the tiles following it
+enum tile_status : unsigned int {
+  invalid = 0,
+  aggregate_available = 1,
+  prefix_available = 2
+};
+
+using status_ref =
+    sycl::atomic_ref<unsigned int, sycl::memory_order::acq_rel,
+                     sycl::memory_scope::device,
+                     sycl::access::address_space::global_space>;
+
+template <class T, class BinaryOp>
+T accumulate_lookback(unsigned int tile_id, unsigned int *status,
+                      const T *aggregates, const T *inclusive_prefixes,
+                      BinaryOp op) {
+  // Tile 0 always publishes its inclusive prefix, so the lookback is
+  // guaranteed to terminate. Tiles are assigned in the order in which
+  // work groups start executing, so all predecessors are already running
+  // and will eventually publish their state.
+  auto wait_for_status = [&](unsigned int tile) {
+    unsigned int s;
+    do {
+      s = status_ref{status[tile]}.load();
+    } while(s == tile_status::invalid);
+    return s;
+  };
+
+  unsigned int predecessor = tile_id - 1;
+  unsigned int s = wait_for_status(predecessor);
+  T exclusive_prefix = (s == tile_status::prefix_available)
+                           ? inclusive_prefixes[predecessor]
+                           : aggregates[predecessor];
+
+  while(s != tile_status::prefix_available) {
+    --predecessor;
+    s = wait_for_status(predecessor);
+    exclusive_prefix = op((s == tile_status::prefix_available)
+                              ? inclusive_prefixes[predecessor]
+                              : aggregates[predecessor],
+                          exclusive_prefix);
+  }
+  return exclusive_prefix;
+}
+
+}
+
+/// Single-pass device-wide scan based on decoupled lookback.
+///
+/// Each work group processes one tile of local_size * items_per_work_item
+/// elements. Tiles are assigned dynamically in the order in which work groups
+/// start, so a work group only ever waits for tiles that are already being
+/// processed. After scanning its tile locally, a work group publishes the tile
+/// aggregate, accumulates the exclusive prefix by looking back at the state
+/// published by its predecessors and then publishes its inclusive prefix.
+///
+/// Input elements are obtained from gen(i), which allows fusing transformations
+/// into the scan. gen() is invoked twice per element, so in-place scans
+/// (d_first == input) are supported as long as gen() only reads element i.
+///
+/// If IsInclusive is false, HasInit must be true.
+/// Requires an in-order queue.
+template <bool IsInclusive, bool HasInit, class T, class Generator,
+          class OutputIt, class BinaryOp>
+sycl::event scan(sycl::queue &q, util::allocation_group &scratch_allocations,
+                 std::size_t problem_size, Generator gen, OutputIt d_first,
+                 BinaryOp op, T init, std::size_t local_size = 128,
+                 std::size_t items_per_work_item = 8) {
+  static_assert(IsInclusive || HasInit,
+                "Exclusive scans require an init value");
+  namespace group_reductions = reduction::wg_model::group_reductions;
+
+  const std::size_t tile_size = local_size * items_per_work_item;
+  const std::size_t num_tiles = (problem_size + tile_size - 1) / tile_size;
+
+  // The last entry is used as counter for dynamic tile assignment
+  unsigned int *status = scratch_allocations.obtain<unsigned int>(num_tiles + 1);
+  T *aggregates = scratch_allocations.obtain<T>(num_tiles);
+  T *inclusive_prefixes = scratch_allocations.obtain<T>(num_tiles);
+
+  q.parallel_for(sycl::range<1>{num_tiles + 1}, [=](sycl::id<1> idx) {
+    status[idx[0]] = decoupled_lookback::tile_status::invalid;
+  });
+
+  std::size_t local_mem = 0;
+  // Per-work item aggregates followed by the exclusive prefix of the tile
+  group_reductions::local_memory_request_bundle<T> values_request{
+      local_mem, local_size + 1};
+  // Tile id and whether the tile has an exclusive prefix
+  group_reductions::local_memory_request_bundle<unsigned int> tile_info_request{
+      local_mem, 2};
+  auto values_addr = values_request.get_address();
+  auto tile_info_addr = tile_info_request.get_address();
+
+  return q.submit([&](sycl::handler &cgh) {
+    // This is just there to register the appropriate amount of local
+    // memory; the kernel accesses it directly through the request bundles.
+    sycl::local_accessor<char> acc{sycl::range<1>{local_mem}, cgh};
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_tiles * local_size, local_size},
+        [=](sycl::nd_item<1> idx) {
+          using group_reductions::local_memory_request_bundle;
+
+          T *values = static_cast<T *>(
+              local_memory_request_bundle<>::get_device_address(values_addr));
+          unsigned int *tile_info = static_cast<unsigned int *>(
+              local_memory_request_bundle<>::get_device_address(
+                  tile_info_addr));
+
+          const std::size_t lid = idx.get_local_linear_id();
+
+          if(lid == 0) {
+            unsigned int *counter = status + num_tiles;
+            tile_info[0] = decoupled_lookback::status_ref{*counter}.fetch_add(
+                1u, sycl::memory_order::relaxed);
+          }
+          group_reductions::local_barrier(idx);
+
+          const unsigned int tile_id = tile_info[0];
+          const std::size_t tile_begin = tile_id * tile_size;
+          const std::size_t num_active_work_items =
+              std::min(local_size, (problem_size - tile_begin +
+                                    items_per_work_item - 1) /
+                                       items_per_work_item);
+
+          const std::size_t begin = tile_begin + lid * items_per_work_item;
+          const std::size_t end =
+              std::min(begin + items_per_work_item, problem_size);
+          const bool is_active = lid < num_active_work_items;
+
+          // Sequentially reduce the elements owned by this work item
+          if(is_active) {
+            T current = gen(begin);
+            for(std::size_t i = begin + 1; i < end; ++i)
+              current = op(current, gen(i));
+            values[lid] = current;
+          }
+          group_reductions::local_barrier(idx);
+
+          // Inclusive scan across the work items of the group. Inactive
+          // work items are always at the end, so they are never read by
+          // active ones.
+          for(std::size_t offset = 1; offset < local_size; offset *= 2) {
+            const bool needs_update = is_active && lid >= offset;
+            T current = values[lid];
+            if(needs_update)
+              current = op(values[lid - offset], current);
+            group_reductions::local_barrier(idx);
+            if(needs_update)
+              values[lid] = current;
+            group_reductions::local_barrier(idx);
+          }
+
+          if(lid == 0) {
+            const T tile_aggregate = values[num_active_work_items - 1];
+            decoupled_lookback::status_ref tile_status{status[tile_id]};
+            bool has_prefix = HasInit;
+
+            if(tile_id == 0) {
+              if constexpr(HasInit) {
+                values[local_size] = init;
+                inclusive_prefixes[0] = op(init, tile_aggregate);
+              } else {
+                inclusive_prefixes[0] = tile_aggregate;
+              }
+              tile_status.store(
+                  decoupled_lookback::tile_status::prefix_available);
+            } else {
+              aggregates[tile_id] = tile_aggregate;
+              tile_status.store(
+                  decoupled_lookback::tile_status::aggregate_available);
+
+              T exclusive_prefix = decoupled_lookback::accumulate_lookback(
+                  tile_id, status, aggregates, inclusive_prefixes, op);
+
+              inclusive_prefixes[tile_id] = op(exclusive_prefix, tile_aggregate);
+              tile_status.store(
+                  decoupled_lookback::tile_status::prefix_available);
+
+              values[local_size] = exclusive_prefix;
+              has_prefix = true;
+            }
+            tile_info[1] = has_prefix;
+          }
+          group_reductions::local_barrier(idx);
+
+          if(!is_active)
+            return;
+
+          bool has_prefix = tile_info[1];
+          T prefix = values[local_size];
+          if(lid > 0) {
+            prefix = has_prefix ? op(prefix, values[lid - 1]) : values[lid - 1];
+            has_prefix = true;
+          }
+
+          for(std::size_t i = begin; i < end; ++i) {
+            T current = gen(i);
+            auto output = d_first;
+            std::advance(output, i);
+            if constexpr(IsInclusive) {
+              prefix = has_prefix ? op(prefix, current) : current;
+              has_prefix = true;
+              *output = prefix;
+            } else {
+              *output = prefix;
+              prefix = op(prefix, current);
+            }
+          }
+        });
+  });
+}
+
+}
+
+#endif
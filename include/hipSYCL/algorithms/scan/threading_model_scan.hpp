@@ -0,0 +1,130 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_ALGORITHMS_THREADING_MODEL_SCAN_HPP
+#define HIPSYCL_ALGORITHMS_THREADING_MODEL_SCAN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#include "hipSYCL/sycl/event.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/algorithms/reduction/threading_model/thread_horizontal_reducer.hpp"
+
+namespace hipsycl::algorithms::scanning {
+
+/// Scan for CPU backends, where work items are executed by a small number of
+/// threads and fine-grained synchronization between work groups is expensive.
+///
+/// The input is split into one contiguous chunk per thread. Chunks are first
+/// reduced in parallel, then the chunk aggregates are scanned sequentially and
+/// finally each chunk is scanned sequentially starting from its prefix.
+/// This keeps memory accesses of each thread linear and only requires
+/// O(num_threads) scratch memory.
+///
+/// Semantics of gen(), IsInclusive and HasInit are the same as for
+/// the decoupled lookback scan. Requires an in-order queue.
+template <bool IsInclusive, bool HasInit, class T, class Generator,
+          class OutputIt, class BinaryOp>
+sycl::event threading_model_scan(sycl::queue &q,
+                                 util::allocation_group &scratch_allocations,
+                                 std::size_t problem_size, Generator gen,
+                                 OutputIt d_first, BinaryOp op, T init,
+                                 std::size_t min_chunk_size = 4096) {
+  static_assert(IsInclusive || HasInit,
+                "Exclusive scans require an init value");
+
+  auto scan_chunk = [=](std::size_t begin, std::size_t end, T prefix,
+                        bool has_prefix) {
+    for(std::size_t i = begin; i < end; ++i) {
+      T current = gen(i);
+      auto output = d_first;
+      std::advance(output, i);
+      if constexpr(IsInclusive) {
+        prefix = has_prefix ? op(prefix, current) : current;
+        has_prefix = true;
+        *output = prefix;
+      } else {
+        *output = prefix;
+        prefix = op(prefix, current);
+      }
+    }
+  };
+
+  reduction::threading_model::omp_thread_info_query thread_info_query;
+  const std::size_t max_num_chunks =
+      (problem_size + min_chunk_size - 1) / min_chunk_size;
+  const std::size_t num_threads = std::min(
+      static_cast<std::size_t>(thread_info_query.get_max_num_threads()),
+      max_num_chunks);
+
+  if(num_threads <= 1) {
+    return q.single_task([=]() { scan_chunk(0, problem_size, init, HasInit); });
+  }
+
+  const std::size_t chunk_size =
+      (problem_size + num_threads - 1) / num_threads;
+  const std::size_t num_chunks = (problem_size + chunk_size - 1) / chunk_size;
+
+  T *chunk_prefixes = scratch_allocations.obtain<T>(num_chunks);
+
+  q.parallel_for(sycl::range<1>{num_chunks}, [=](sycl::id<1> idx) {
+    const std::size_t begin = idx[0] * chunk_size;
+    const std::size_t end = std::min(begin + chunk_size, problem_size);
+
+    T current = gen(begin);
+    for(std::size_t i = begin + 1; i < end; ++i)
+      current = op(current, gen(i));
+    chunk_prefixes[idx[0]] = current;
+  });
+
+  // Turn chunk aggregates into exclusive chunk prefixes. If there is no init
+  // value, the first chunk does not have a prefix and its entry is left
+  // untouched.
+  q.single_task([=]() {
+    std::size_t first_chunk = HasInit ? 0 : 1;
+    T running_prefix = HasInit ? init : chunk_prefixes[0];
+    for(std::size_t i = first_chunk; i < num_chunks; ++i) {
+      T aggregate = chunk_prefixes[i];
+      chunk_prefixes[i] = running_prefix;
+      running_prefix = op(running_prefix, aggregate);
+    }
+  });
+
+  return q.parallel_for(sycl::range<1>{num_chunks}, [=](sycl::id<1> idx) {
+    const std::size_t begin = idx[0] * chunk_size;
+    const std::size_t end = std::min(begin + chunk_size, problem_size);
+
+    scan_chunk(begin, end, chunk_prefixes[idx[0]], HasInit || idx[0] > 0);
+  });
+}
+
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_ALGORITHMS_MERGE_SORT_HPP
+#define HIPSYCL_ALGORITHMS_MERGE_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "hipSYCL/sycl/event.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "radix_sort.hpp"
+
+namespace hipsycl::algorithms::sorting {
+
+namespace merge {
+
+constexpr std::size_t initial_run_size = 16;
+
+// Returns the first position in [begin, end) for which the element
+// is not ordered before x (if IsUpperBound is false) or for which x is
+// ordered before the element (if IsUpperBound is true).
+template <bool IsUpperBound, class RandomIt, class T, class Compare>
+std::size_t bound(RandomIt data, std::size_t begin, std::size_t end,
+                  const T &x, Compare comp) {
+  while(begin < end) {
+    std::size_t mid = begin + (end - begin) / 2;
+    bool go_right = IsUpperBound ? !comp(x, data[mid]) : comp(data[mid], x);
+    if(go_right)
+      begin = mid + 1;
+    else
+      end = mid;
+  }
+  return begin;
+}
+
+/// Sorts runs of initial_run_size elements in place using insertion sort.
+template <class KeyIt, class ValueIt, class Compare>
+sycl::event sort_initial_runs(sycl::queue &q, KeyIt keys, ValueIt values,
+                              std::size_t problem_size, Compare comp) {
+  constexpr bool has_values = !std::is_same_v<ValueIt, no_values *>;
+  const std::size_t num_runs =
+      (problem_size + initial_run_size - 1) / initial_run_size;
+
+  return q.parallel_for(sycl::range<1>{num_runs}, [=](sycl::id<1> idx) {
+    const std::size_t begin = idx[0] * initial_run_size;
+    const std::size_t end = std::min(begin + initial_run_size, problem_size);
+
+    for(std::size_t i = begin + 1; i < end; ++i) {
+      auto key = keys[i];
+      std::size_t j = i;
+      if constexpr(has_values) {
+        auto value = values[i];
+        for(; j > begin && comp(key, keys[j - 1]); --j) {
+          keys[j] = keys[j - 1];
+          values[j] = values[j - 1];
+        }
+        values[j] = value;
+      } else {
+        for(; j > begin && comp(key, keys[j - 1]); --j)
+          keys[j] = keys[j - 1];
+      }
+      keys[j] = key;
+    }
+  });
+}
+
+/// Merges pairs of adjacent sorted runs of run_size elements. Each work item
+/// moves one element to its final position, which it determines by a binary
+/// search in the other run of the pair. Ties are resolved in favor of the
+/// left run, so the merge is stable.
+template <class KeyInIt, class KeyOutIt, class ValueInIt, class ValueOutIt,
+          class Compare>
+sycl::event merge_runs(sycl::queue &q, KeyInIt keys_in, KeyOutIt keys_out,
+                       ValueInIt values_in, ValueOutIt values_out,
+                       std::size_t problem_size, std::size_t run_size,
+                       Compare comp) {
+  constexpr bool has_values = !std::is_same_v<ValueInIt, no_values *>;
+
+  return q.parallel_for(sycl::range<1>{problem_size}, [=](sycl::id<1> idx) {
+    const std::size_t i = idx[0];
+    const std::size_t left_begin = (i / (2 * run_size)) * (2 * run_size);
+    const std::size_t right_begin =
+        std::min(left_begin + run_size, problem_size);
+    const std::size_t right_end =
+        std::min(left_begin + 2 * run_size, problem_size);
+
+    const auto key = keys_in[i];
+    std::size_t pos = 0;
+    if(i < right_begin) {
+      pos = i + bound<false>(keys_in, right_begin, right_end, key, comp) -
+            right_begin;
+    } else {
+      pos = i - right_begin +
+            bound<true>(keys_in, left_begin, right_begin, key, comp);
+    }
+
+    keys_out[pos] = key;
+    if constexpr(has_values)
+      values_out[pos] = values_in[i];
+  });
+}
+
+}
+
+/// Stable merge sort for arbitrary comparators, optionally with associated
+/// values.
+///
+/// Runs of a few elements are first sorted in place. These are then merged
+/// pairwise, alternating between the input and a scratch buffer, until a
+/// single run remains. Key and value types need to be trivially copyable.
+/// Requires an in-order queue.
+template <class KeyIt, class Compare, class ValueIt = no_values *>
+sycl::event merge_sort(sycl::queue &q,
+                       util::allocation_group &scratch_allocations, KeyIt keys,
+                       std::size_t problem_size, Compare comp,
+                       ValueIt values = nullptr) {
+  using key_type = typename std::iterator_traits<KeyIt>::value_type;
+  using value_type = typename std::iterator_traits<ValueIt>::value_type;
+  constexpr bool has_values = !std::is_same_v<ValueIt, no_values *>;
+
+  if(problem_size <= 1)
+    return sycl::event{};
+
+  sycl::event last_event =
+      merge::sort_initial_runs(q, keys, values, problem_size, comp);
+  if(problem_size <= merge::initial_run_size)
+    return last_event;
+
+  key_type *keys_scratch = scratch_allocations.obtain<key_type>(problem_size);
+  value_type *values_scratch = nullptr;
+  if constexpr(has_values)
+    values_scratch = scratch_allocations.obtain<value_type>(problem_size);
+
+  bool is_result_in_scratch = false;
+  for(std::size_t run_size = merge::initial_run_size; run_size < problem_size;
+      run_size *= 2) {
+    if(is_result_in_scratch)
+      last_event = merge::merge_runs(q, keys_scratch, keys, values_scratch,
+                                     values, problem_size, run_size, comp);
+    else
+      last_event = merge::merge_runs(q, keys, keys_scratch, values,
+                                     values_scratch, problem_size, run_size,
+                                     comp);
+    is_result_in_scratch = !is_result_in_scratch;
+  }
+
+  if(is_result_in_scratch) {
+    last_event = q.parallel_for(sycl::range<1>{problem_size},
+                                [=](sycl::id<1> idx) {
+                                  keys[idx[0]] = keys_scratch[idx[0]];
+                                  if constexpr(has_values)
+                                    values[idx[0]] = values_scratch[idx[0]];
+                                });
+  }
+  return last_event;
+}
+
+}
+
+#endif
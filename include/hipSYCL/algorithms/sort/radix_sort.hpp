@@ -0,0 +1,432 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_ALGORITHMS_RADIX_SORT_HPP
+#define HIPSYCL_ALGORITHMS_RADIX_SORT_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "hipSYCL/sycl/libkernel/accessor.hpp"
+#include "hipSYCL/sycl/libkernel/atomic_ref.hpp"
+#include "hipSYCL/sycl/libkernel/bit_cast.hpp"
+#include "hipSYCL/sycl/libkernel/nd_item.hpp"
+#include "hipSYCL/sycl/event.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/algorithms/reduction/wg_model/group_reduction_algorithms.hpp"
+
+namespace hipsycl::algorithms::sorting {
+
+/// Tag type to request sorting keys without associated values
+struct no_values {};
+
+namespace radix {
+
+template <class Key>
+constexpr bool is_radix_sortable() {
+  return std::is_arithmetic_v<Key> && !std::is_same_v<Key, long double> &&
+         sizeof(Key) <= 8;
+}
+
+template<class Key>
+struct key_traits {
+  static_assert(is_radix_sortable<Key>(), "Key type cannot be radix sorted");
+
+  using bits_type = std::conditional_t<
+      sizeof(Key) == 1, unsigned char,
+      std::conditional_t<
+          sizeof(Key) == 2, unsigned short,
+          std::conditional_t<sizeof(Key) == 4, unsigned int,
+                             unsigned long long>>>;
+
+  static constexpr int num_bits = sizeof(bits_type) * CHAR_BIT;
+  static constexpr bits_type sign_bit = bits_type{1} << (num_bits - 1);
+
+  // Maps keys to unsigned integers such that the unsigned integer order
+  // matches the order of the keys
+  static bits_type to_radix(Key k) noexcept {
+    if constexpr(std::is_same_v<Key, bool>) {
+      return static_cast<bits_type>(k);
+    } else if constexpr(std::is_floating_point_v<Key>) {
+      // -0.0 and 0.0 compare equal and must keep their relative order
+      if(k == Key{0})
+        k = Key{0};
+      bits_type b = sycl::bit_cast<bits_type>(k);
+      return (b & sign_bit) ? static_cast<bits_type>(~b)
+                            : static_cast<bits_type>(b | sign_bit);
+    } else if constexpr(std::is_signed_v<Key>) {
+      return static_cast<bits_type>(sycl::bit_cast<bits_type>(k) ^ sign_bit);
+    } else {
+      return sycl::bit_cast<bits_type>(k);
+    }
+  }
+};
+
+enum class order { unsupported, ascending, descending };
+
+template <class Key, class Compare> constexpr order get_order() {
+  if constexpr(std::is_same_v<Compare, std::less<Key>> ||
+               std::is_same_v<Compare, std::less<>>)
+    return order::ascending;
+  else if constexpr(std::is_same_v<Compare, std::greater<Key>> ||
+                    std::is_same_v<Compare, std::greater<>>)
+    return order::descending;
+  else
+    return order::unsupported;
+}
+
+constexpr int bits_per_pass = 4;
+constexpr unsigned int num_bins = 1u << bits_per_pass;
+constexpr std::size_t items_per_work_item = 8;
+
+// Tile state for the lookback: The upper two bits contain the status flag,
+// the remaining bits the digit count.
+using tile_state_t = unsigned long long;
+constexpr int tile_status_shift = 62;
+constexpr tile_state_t tile_count_mask =
+    (tile_state_t{1} << tile_status_shift) - 1;
+constexpr tile_state_t aggregate_available = tile_state_t{1}
+                                             << tile_status_shift;
+constexpr tile_state_t prefix_available = tile_state_t{2} << tile_status_shift;
+
+using global_state_ref =
+    sycl::atomic_ref<tile_state_t, sycl::memory_order::acq_rel,
+                     sycl::memory_scope::device,
+                     sycl::access::address_space::global_space>;
+
+using local_counter_ref =
+    sycl::atomic_ref<unsigned int, sycl::memory_order::relaxed,
+                     sycl::memory_scope::work_group,
+                     sycl::access::address_space::local_space>;
+
+template <order Order, class Key>
+auto get_radix(Key k) noexcept {
+  using bits_type = typename key_traits<Key>::bits_type;
+  bits_type b = key_traits<Key>::to_radix(k);
+  if constexpr(Order == order::descending)
+    return static_cast<bits_type>(~b);
+  else
+    return b;
+}
+
+template <class Bits>
+unsigned int get_digit(Bits b, int pass) noexcept {
+  return static_cast<unsigned int>(b >> (pass * bits_per_pass)) &
+         (num_bins - 1);
+}
+
+// Sums up the digit counts of all preceding tiles
+inline tile_state_t accumulate_lookback(std::size_t tile_id, unsigned int digit,
+                                        tile_state_t *tile_states) {
+  tile_state_t exclusive_prefix = 0;
+  std::size_t predecessor = tile_id;
+  for(;;) {
+    --predecessor;
+    tile_state_t s;
+    do {
+      s = global_state_ref{tile_states[predecessor * num_bins + digit]}.load();
+    } while((s & ~tile_count_mask) == 0);
+
+    exclusive_prefix += s & tile_count_mask;
+    if((s & ~tile_count_mask) == prefix_available)
+      return exclusive_prefix;
+  }
+}
+
+/// Computes the digit histograms of all passes in one sweep over the input
+/// and turns them into the global start offset of each digit.
+template <order Order, class Key>
+void build_digit_offsets(sycl::queue &q, const Key *keys,
+                         std::size_t problem_size, std::size_t local_size,
+                         tile_state_t *digit_offsets) {
+  namespace group_reductions = reduction::wg_model::group_reductions;
+  constexpr int num_passes = key_traits<Key>::num_bits / bits_per_pass;
+  constexpr std::size_t histogram_size = num_passes * num_bins;
+
+  const std::size_t tile_size = local_size * items_per_work_item;
+  const std::size_t num_tiles = (problem_size + tile_size - 1) / tile_size;
+
+  q.parallel_for(sycl::range<1>{histogram_size},
+                 [=](sycl::id<1> idx) { digit_offsets[idx[0]] = 0; });
+
+  std::size_t local_mem = 0;
+  group_reductions::local_memory_request_bundle<unsigned int> histogram_request{
+      local_mem, histogram_size};
+  auto histogram_addr = histogram_request.get_address();
+
+  q.submit([&](sycl::handler &cgh) {
+    sycl::local_accessor<char> acc{sycl::range<1>{local_mem}, cgh};
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_tiles * local_size, local_size},
+        [=](sycl::nd_item<1> idx) {
+          unsigned int *histogram = static_cast<unsigned int *>(
+              group_reductions::local_memory_request_bundle<>::
+                  get_device_address(histogram_addr));
+          const std::size_t lid = idx.get_local_linear_id();
+
+          for(std::size_t i = lid; i < histogram_size; i += local_size)
+            histogram[i] = 0;
+          group_reductions::local_barrier(idx);
+
+          const std::size_t tile_begin = idx.get_group_linear_id() * tile_size;
+          const std::size_t tile_end =
+              std::min(tile_begin + tile_size, problem_size);
+          for(std::size_t i = tile_begin + lid; i < tile_end;
+              i += local_size) {
+            auto b = get_radix<Order>(keys[i]);
+            for(int pass = 0; pass < num_passes; ++pass)
+              local_counter_ref{histogram[pass * num_bins +
+                                          get_digit(b, pass)]}
+                  .fetch_add(1u);
+          }
+          group_reductions::local_barrier(idx);
+
+          for(std::size_t i = lid; i < histogram_size; i += local_size) {
+            if(histogram[i] > 0)
+              global_state_ref{digit_offsets[i]}.fetch_add(
+                  tile_state_t{histogram[i]}, sycl::memory_order::relaxed);
+          }
+        });
+  });
+
+  q.single_task([=]() {
+    for(int pass = 0; pass < num_passes; ++pass) {
+      tile_state_t current_offset = 0;
+      for(unsigned int digit = 0; digit < num_bins; ++digit) {
+        tile_state_t count = digit_offsets[pass * num_bins + digit];
+        digit_offsets[pass * num_bins + digit] = current_offset;
+        current_offset += count;
+      }
+    }
+  });
+}
+
+/// Stable scatter of all elements according to the digit of the given pass.
+/// Each work group ranks the elements of one tile in local memory and
+/// obtains the global position of each digit within the tile by looking back
+/// at the digit counts published by preceding tiles.
+template <order Order, class Key, class Value>
+sycl::event scatter_pass(sycl::queue &q, const Key *keys_in, Key *keys_out,
+                         const Value *values_in, Value *values_out,
+                         std::size_t problem_size, std::size_t local_size,
+                         int pass, const tile_state_t *digit_offsets,
+                         tile_state_t *tile_states) {
+  namespace group_reductions = reduction::wg_model::group_reductions;
+  constexpr bool has_values = !std::is_same_v<Value, no_values>;
+
+  const std::size_t tile_size = local_size * items_per_work_item;
+  const std::size_t num_tiles = (problem_size + tile_size - 1) / tile_size;
+
+  // The last entry is used as counter for dynamic tile assignment
+  q.parallel_for(sycl::range<1>{num_tiles * num_bins + 1},
+                 [=](sycl::id<1> idx) { tile_states[idx[0]] = 0; });
+
+  std::size_t local_mem = 0;
+  // Digit counts (digit-major), per-work item sums and the tile id
+  group_reductions::local_memory_request_bundle<unsigned int> counts_request{
+      local_mem, (num_bins + 1) * local_size + 1};
+  // Global position of the first element of each digit in this tile
+  group_reductions::local_memory_request_bundle<tile_state_t> bases_request{
+      local_mem, num_bins};
+  auto counts_addr = counts_request.get_address();
+  auto bases_addr = bases_request.get_address();
+
+  return q.submit([&](sycl::handler &cgh) {
+    sycl::local_accessor<char> acc{sycl::range<1>{local_mem}, cgh};
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_tiles * local_size, local_size},
+        [=](sycl::nd_item<1> idx) {
+          using group_reductions::local_memory_request_bundle;
+
+          unsigned int *counts = static_cast<unsigned int *>(
+              local_memory_request_bundle<>::get_device_address(counts_addr));
+          unsigned int *sums = counts + num_bins * local_size;
+          unsigned int *tile_info = sums + local_size;
+          tile_state_t *bases = static_cast<tile_state_t *>(
+              local_memory_request_bundle<>::get_device_address(bases_addr));
+
+          const std::size_t lid = idx.get_local_linear_id();
+
+          if(lid == 0) {
+            tile_info[0] = static_cast<unsigned int>(
+                global_state_ref{tile_states[num_tiles * num_bins]}.fetch_add(
+                    tile_state_t{1}, sycl::memory_order::relaxed));
+          }
+          group_reductions::local_barrier(idx);
+
+          const std::size_t tile_id = tile_info[0];
+          const std::size_t begin =
+              tile_id * tile_size + lid * items_per_work_item;
+          const std::size_t count =
+              begin < problem_size
+                  ? std::min(items_per_work_item, problem_size - begin)
+                  : 0;
+
+          Key keys[items_per_work_item];
+          unsigned int digit_counts[num_bins];
+          for(unsigned int d = 0; d < num_bins; ++d)
+            digit_counts[d] = 0;
+          for(std::size_t i = 0; i < count; ++i) {
+            keys[i] = keys_in[begin + i];
+            ++digit_counts[get_digit(get_radix<Order>(keys[i]), pass)];
+          }
+          for(unsigned int d = 0; d < num_bins; ++d)
+            counts[d * local_size + lid] = digit_counts[d];
+          group_reductions::local_barrier(idx);
+
+          // Exclusive scan of the digit-major counts. This ranks the elements
+          // of the tile by digit first and by work item second, which
+          // preserves the input order within each digit.
+          unsigned int *segment = counts + lid * num_bins;
+          unsigned int segment_sum = 0;
+          for(unsigned int i = 0; i < num_bins; ++i) {
+            unsigned int v = segment[i];
+            segment[i] = segment_sum;
+            segment_sum += v;
+          }
+          sums[lid] = segment_sum;
+          group_reductions::local_barrier(idx);
+
+          for(std::size_t offset = 1; offset < local_size; offset *= 2) {
+            unsigned int current = sums[lid];
+            if(lid >= offset)
+              current += sums[lid - offset];
+            group_reductions::local_barrier(idx);
+            sums[lid] = current;
+            group_reductions::local_barrier(idx);
+          }
+
+          const unsigned int segment_prefix = lid > 0 ? sums[lid - 1] : 0;
+          for(unsigned int i = 0; i < num_bins; ++i)
+            segment[i] += segment_prefix;
+          group_reductions::local_barrier(idx);
+
+          if(lid < num_bins) {
+            const unsigned int digit = lid;
+            const unsigned int digit_begin = counts[digit * local_size];
+            const unsigned int digit_end =
+                (digit + 1 < num_bins) ? counts[(digit + 1) * local_size]
+                                       : sums[local_size - 1];
+            const tile_state_t digit_count = digit_end - digit_begin;
+
+            global_state_ref state{tile_states[tile_id * num_bins + digit]};
+            tile_state_t exclusive_prefix = 0;
+            if(tile_id == 0) {
+              state.store(digit_count | prefix_available);
+            } else {
+              state.store(digit_count | aggregate_available);
+              exclusive_prefix =
+                  accumulate_lookback(tile_id, digit, tile_states);
+              state.store((exclusive_prefix + digit_count) | prefix_available);
+            }
+            bases[digit] = digit_offsets[pass * num_bins + digit] +
+                           exclusive_prefix - digit_begin;
+          }
+          group_reductions::local_barrier(idx);
+
+          for(unsigned int d = 0; d < num_bins; ++d)
+            digit_counts[d] = 0;
+          for(std::size_t i = 0; i < count; ++i) {
+            const unsigned int digit =
+                get_digit(get_radix<Order>(keys[i]), pass);
+            const std::size_t pos = bases[digit] +
+                                    counts[digit * local_size + lid] +
+                                    digit_counts[digit]++;
+            keys_out[pos] = keys[i];
+            if constexpr(has_values)
+              values_out[pos] = values_in[begin + i];
+          }
+        });
+  });
+}
+
+}
+
+/// Stable LSD radix sort for arithmetic keys, optionally with
+/// associated values.
+///
+/// All digit histograms are computed upfront in a single sweep over the
+/// input. Each pass then scatters the input in a single kernel using
+/// decoupled lookback across tiles to obtain per-tile digit offsets
+/// (onesweep). Since the number of passes is always even, the result ends up
+/// in the input buffers.
+///
+/// values may be nullptr if Value is no_values. Requires an in-order queue.
+template <radix::order Order, class Key, class Value = no_values>
+sycl::event radix_sort(sycl::queue &q,
+                       util::allocation_group &scratch_allocations, Key *keys,
+                       std::size_t problem_size, Value *values = nullptr,
+                       std::size_t local_size = 128) {
+  constexpr int num_passes =
+      radix::key_traits<Key>::num_bits / radix::bits_per_pass;
+  static_assert(num_passes % 2 == 0,
+                "Number of passes must be even for the result to end up in "
+                "the input buffers");
+  constexpr bool has_values = !std::is_same_v<Value, no_values>;
+
+  if(problem_size <= 1)
+    return sycl::event{};
+
+  const std::size_t tile_size = local_size * radix::items_per_work_item;
+  const std::size_t num_tiles = (problem_size + tile_size - 1) / tile_size;
+
+  Key *keys_scratch = scratch_allocations.obtain<Key>(problem_size);
+  Value *values_scratch = nullptr;
+  if constexpr(has_values)
+    values_scratch = scratch_allocations.obtain<Value>(problem_size);
+  radix::tile_state_t *digit_offsets =
+      scratch_allocations.obtain<radix::tile_state_t>(num_passes *
+                                                      radix::num_bins);
+  radix::tile_state_t *tile_states =
+      scratch_allocations.obtain<radix::tile_state_t>(
+          num_tiles * radix::num_bins + 1);
+
+  radix::build_digit_offsets<Order>(q, keys, problem_size, local_size,
+                                    digit_offsets);
+
+  Key *keys_in = keys;
+  Key *keys_out = keys_scratch;
+  Value *values_in = values;
+  Value *values_out = values_scratch;
+  sycl::event last_event;
+  for(int pass = 0; pass < num_passes; ++pass) {
+    last_event = radix::scatter_pass<Order>(
+        q, keys_in, keys_out, values_in, values_out, problem_size, local_size,
+        pass, digit_offsets, tile_states);
+    std::swap(keys_in, keys_out);
+    std::swap(values_in, values_out);
+  }
+  return last_event;
+}
+
+}
+
+#endif
@@ -29,6 +29,7 @@
 #define HIPSYCL_COMMON_FILESYSTEM_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace hipsycl {
@@ -44,12 +45,15 @@ std::string
 join_path(const std::string &base,
           const std::vector<std::string> &additional_components);
 
+/// Returns the filename component of a path
+std::string get_filename(const std::string& path);
+
 std::vector<std::string> list_regular_files(const std::string &directory);
 std::vector<std::string> list_regular_files(const std::string &directory,
                                             const std::string &extension);
 
 /// Writes data atomically to filename
-bool atomic_write(const std::string& filename, const std::string& data);
+bool atomic_write(const std::string& filename, std::string_view data);
 
 /// Removes a file, returns true if successful.
 bool remove(const std::string &filename);
@@ -32,6 +32,7 @@
 #include <cstddef>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <sstream>
@@ -165,6 +166,16 @@ public:
   }
 
   bool get_binary_attachment(const node* n, std::string& out) const {
+    std::string_view data;
+    if(!get_binary_attachment(n, data))
+      return false;
+    out = std::string{data};
+    return true;
+  }
+
+  // Returns a view of the binary attachment, which remains valid
+  // as long as the container exists.
+  bool get_binary_attachment(const node* n, std::string_view& out) const {
     std::size_t start = 0;
     std::size_t size = 0;
 
@@ -205,7 +216,7 @@ public:
       return false;
     }
 
-    out = _binary_appendix.substr(start, size);
+    out = std::string_view{_binary_appendix}.substr(start, size);
 
     return true;
   }
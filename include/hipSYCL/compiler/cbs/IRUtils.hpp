@@ -46,10 +46,12 @@ struct MDKind {
   static constexpr const char InnerLoop[] = "hipSYCL.loop.inner";
   static constexpr const char WorkItemLoop[] = "hipSYCL.loop.workitem";
   static constexpr const char LoopState[] = "hipSYCL.loop_state";
+  static constexpr const char SubGroupBarrier[] = "hipSYCL.sub_group_barrier";
 };
 
 namespace cbs {
 static constexpr const char BarrierIntrinsicName[] = "__hipsycl_cbs_barrier";
+static constexpr const char SubGroupBarrierIntrinsicName[] = "__hipsycl_cbs_sub_group_barrier";
 static constexpr const char LocalIdGlobalNameX[] = "__hipsycl_cbs_local_id_x";
 static constexpr const char LocalIdGlobalNameY[] = "__hipsycl_cbs_local_id_y";
 static constexpr const char LocalIdGlobalNameZ[] = "__hipsycl_cbs_local_id_z";
@@ -75,6 +77,11 @@ static const std::array<const char *, 3> NumGroupsGlobalNames{
     NumGroupsGlobalNameX, NumGroupsGlobalNameY, NumGroupsGlobalNameZ};
 
 static constexpr const char SscpDynamicLocalMemoryPtrName[] = "__hipsycl_cbs_sscp_dynamic_local_memory";
+static constexpr const char SscpCollectiveScratchPtrName[] = "__hipsycl_cbs_sscp_collective_scratch";
+static constexpr const char SscpSubGroupSizeName[] = "__hipsycl_cbs_sscp_sub_group_size";
+// lists kernels in which a sub-group barrier was found in divergent control flow
+static constexpr const char DivergentSubGroupBarriersName[] =
+    "hipSYCL.divergent_sub_group_barriers";
 } // namespace cbs
 
 static constexpr const char SscpAnnotationsName[] = "hipsycl.sscp.annotations";
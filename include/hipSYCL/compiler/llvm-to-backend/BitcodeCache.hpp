@@ -0,0 +1,70 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_LLVM_TO_BACKEND_BITCODE_CACHE_HPP
+#define HIPSYCL_LLVM_TO_BACKEND_BITCODE_CACHE_HPP
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hipsycl {
+namespace compiler {
+
+// Process-wide cache of bitcode files, such as builtin libraries, that are
+// linked into JIT-compiled modules.
+//
+// LLVM modules are tied to the LLVMContext of a single JIT compilation and
+// therefore cannot be shared between translators. The cache instead retains
+// the file contents in memory. Translators load modules lazily from the
+// cached buffers, such that only functions that are actually linked
+// get deserialized.
+//
+// This class is thread-safe.
+class BitcodeCache {
+public:
+  static BitcodeCache &get();
+
+  // Returns the contents of the file, reading it only on first access.
+  // Returns nullptr if the file cannot be read. The buffer remains valid
+  // for the lifetime of the process.
+  const llvm::MemoryBuffer *getFile(const std::string &Path);
+
+private:
+  BitcodeCache() = default;
+
+  std::mutex Mutex;
+  llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> Files;
+};
+
+}
+}
+
+#endif
@@ -34,6 +34,7 @@
 // LLVM code into the hipSYCL runtime.
 #include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -84,6 +85,25 @@ public:
 
   void setS2IRConstant(const std::string& name, const void* ValueBuffer);
 
+  // Replaces all uses of the kernel parameter with the provided value.
+  // ValueBuffer must point to at least 8 bytes containing the raw, zero-extended
+  // value. Only integer and floating point parameters can be specialized;
+  // requests for other parameter types are ignored.
+  void specializeKernelArgument(const std::string &KernelName, int ParamIndex,
+                                const void *ValueBuffer);
+
+  // Declares that the pointer passed to the kernel parameter is aligned
+  // to at least Alignment bytes.
+  void setKnownPtrParamAlignment(const std::string &KernelName, int ParamIndex,
+                                 int Alignment);
+  // Declares that the memory accessed through the kernel parameter is not
+  // accessed through any other kernel parameter.
+  void setNoAliasKernelParam(const std::string &KernelName, int ParamIndex);
+
+  const std::vector<std::string>& getKernels() const {
+    return OutliningEntrypoints;
+  }
+
   bool setBuildFlag(const std::string &Flag);
   bool setBuildOption(const std::string &Option, const std::string &Value);
   bool setBuildToolArguments(const std::string &ToolName, const std::vector<std::string> &Args);
@@ -135,8 +155,10 @@ public:
     using SymbolsToModuleIdMapperType =
         std::function<std::vector<LLVMModuleId>(const SymbolListType &SymbolList)>;
     // BitcodeStringRetriever will return the IR bitcode string as well as the imported symbols,
-    // given a unique LLVM module id.
-    using BitcodeStringRetrieverType = std::function<std::string (LLVMModuleId, SymbolListType&)>;
+    // given a unique LLVM module id. The bitcode must remain valid for the lifetime
+    // of the translator.
+    using BitcodeStringRetrieverType =
+        std::function<std::string_view(LLVMModuleId, SymbolListType &)>;
 
     ExternalSymbolResolver() = default;
     ExternalSymbolResolver(const SymbolsToModuleIdMapperType &SymbolMapper,
@@ -177,12 +199,14 @@ protected:
 
   // Link against bitcode contained in file or string. If ForcedTriple/ForcedDataLayout are non-empty,
   // sets triple and data layout in contained bitcode to the provided values.
+  // The bitcode is loaded lazily, so with LinkOnlyNeeded only the functions that are
+  // needed are deserialized. Files are read once and then kept in the BitcodeCache.
   
   bool linkBitcodeFile(llvm::Module &M, const std::string &BitcodeFile,
                        const std::string &ForcedTriple = "",
                        const std::string &ForcedDataLayout = "",
                        bool LinkOnlyNeeded = true);
-  bool linkBitcodeString(llvm::Module &M, const std::string &Bitcode,
+  bool linkBitcodeString(llvm::Module &M, std::string_view Bitcode,
                          const std::string &ForcedTriple = "",
                          const std::string &ForcedDataLayout = "",
                          bool LinkOnlyNeeded = true);
@@ -221,6 +245,8 @@ private:
   std::vector<std::string> OutliningEntrypoints;
   std::vector<std::string> Errors;
   std::unordered_map<std::string, std::function<void(llvm::Module &)>> S2IRConstantApplicators;
+  std::vector<std::function<void(llvm::Module &)>> KernelArgSpecializationApplicators;
+  std::vector<std::function<void(llvm::Module &)>> KernelParamAttributeApplicators;
   ExternalSymbolResolver SymbolResolver;
   bool HasExternalSymbolResolver = false;
 
@@ -86,6 +86,21 @@ inline llvm::Error loadModuleFromString(const std::string &LLVMIR, llvm::LLVMCon
   return llvm::Error::success();
 }
 
+// Function bodies are only deserialized once they are materialized,
+// e.g. by the linker. The buffer needs to outlive the module.
+inline llvm::Error loadLazyModuleFromBuffer(llvm::MemoryBufferRef Buffer, llvm::LLVMContext &ctx,
+                                            std::unique_ptr<llvm::Module> &out) {
+  auto BC = llvm::getLazyBitcodeModule(Buffer, ctx);
+
+  if(auto err = BC.takeError()) {
+    return err;
+  }
+
+  out = std::move(BC.get());
+
+  return llvm::Error::success();
+}
+
 template<class F>
 inline void constructPassBuilder(F&& handler) {
   llvm::LoopAnalysisManager LAM;
@@ -0,0 +1,71 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_HOST_JIT_LINKER_HPP
+#define HIPSYCL_HOST_JIT_LINKER_HPP
+
+// Note: This file is included by the runtime and must therefore
+// not include any LLVM headers.
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace hipsycl {
+namespace compiler {
+
+/// Links relocatable object files as generated by the in-process code
+/// generation of LLVMToHost into executable memory of the current process,
+/// such that no shared library needs to be written to disk and dlopen'ed.
+/// Undefined symbols of the object file are resolved against the symbols
+/// that are already loaded into the process.
+class HostJITLinker {
+public:
+  ~HostJITLinker();
+
+  /// Returns true if \c Binary is a relocatable object file that can
+  /// be loaded with this class (as opposed to e.g. a shared library).
+  static bool isRelocatableObject(std::string_view Binary);
+
+  /// Links the object file. Returns nullptr on error, in which case
+  /// \c ErrorOut will contain an error message.
+  static std::unique_ptr<HostJITLinker> create(std::string_view ObjectFile,
+                                               std::string &ErrorOut);
+
+  /// Returns the address of the symbol, or nullptr if not found.
+  void *getSymbol(const std::string &Name) const;
+
+private:
+  struct Impl;
+  HostJITLinker(std::unique_ptr<Impl> I);
+
+  std::unique_ptr<Impl> JITImpl;
+};
+
+} // namespace compiler
+} // namespace hipsycl
+
+#endif
@@ -34,11 +34,22 @@
 namespace hipsycl {
 namespace compiler {
 
+// Suffix of the additional kernel entry point that executes a contiguous range of
+// work groups. Needs to match the name that the omp backend looks up.
+static constexpr const char *HostGroupRangeKernelSuffix = "_group_range";
+
+// Up to this number of work items per group, the kernel is compiled
+// into the loop over the groups of the group range entry point.
+static constexpr std::int64_t MaxGroupSizeForGroupRangeInlining = 128;
+
 class HostKernelWrapperPass : public llvm::PassInfoMixin<HostKernelWrapperPass> {
   std::int64_t DynamicLocalMemSize;
+  std::int64_t KnownGroupSize;
 public:
-  explicit HostKernelWrapperPass(std::int64_t DynamicLocalMemSize)
-      : DynamicLocalMemSize{DynamicLocalMemSize} {}
+  /// \param KnownGroupSize The number of work items per group if known at JIT time,
+  /// otherwise 0.
+  explicit HostKernelWrapperPass(std::int64_t DynamicLocalMemSize, std::int64_t KnownGroupSize = 0)
+      : DynamicLocalMemSize{DynamicLocalMemSize}, KnownGroupSize{KnownGroupSize} {}
 
   llvm::PreservedAnalyses run(llvm::Function &F, llvm::FunctionAnalysisManager &AM);
   static bool isRequired() { return true; }
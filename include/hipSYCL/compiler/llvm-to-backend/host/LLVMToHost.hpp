@@ -37,6 +37,10 @@
 namespace hipsycl {
 namespace compiler {
 
+// Thread-safe, one-time initialization of the LLVM native target
+// required for in-process code generation and JIT linking.
+void initializeNativeTarget();
+
 class LLVMToHostTranslator : public LLVMToBackendTranslator{
 public:
   LLVMToHostTranslator(const std::vector<std::string>& KernelNames);
@@ -47,11 +51,20 @@ public:
   virtual bool toBackendFlavor(llvm::Module &M, PassHandler& PH) override;
   virtual bool translateToBackendFormat(llvm::Module &FlavoredModule, std::string &out) override;
 protected:
+  virtual bool applyBuildFlag(const std::string &Flag) override;
   virtual bool applyBuildOption(const std::string &Option, const std::string &Value) override;
   virtual bool isKernelAfterFlavoring(llvm::Function& F) override;
   virtual AddressSpaceMap getAddressSpaceMap() const override;
 private:
+  // Generates a relocatable object file without leaving the process
+  bool emitObjectInProcess(llvm::Module &FlavoredModule, std::string &out);
+  // Generates a shared library by invoking clang
+  bool emitSharedLibraryWithClang(llvm::Module &FlavoredModule, std::string &out);
+
   std::vector<std::string> KernelNames;
+  bool UseOutOfProcessCodegen = false;
+  // Number of consecutive work items forming a sub-group
+  unsigned SubGroupSize = 1;
 };
 
 }
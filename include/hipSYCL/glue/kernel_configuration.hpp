@@ -40,6 +40,8 @@
 #include <cassert>
 #include <optional>
 #include <unordered_map>
+#include <istream>
+#include <ostream>
 
 #include "hipSYCL/common/stable_running_hash.hpp"
 
@@ -72,7 +74,9 @@ enum class kernel_build_option : int {
 
   spirv_dynamic_local_mem_allocation_size,
 
-  musa_target_device
+  musa_target_device,
+
+  host_sub_group_size
 };
 
 enum class kernel_build_flag : int {
@@ -83,7 +87,13 @@ enum class kernel_build_flag : int {
   ptx_approx_div,
   ptx_approx_sqrt,
 
-  spirv_enable_intel_llvm_spirv_options
+  spirv_enable_intel_llvm_spirv_options,
+
+  host_out_of_process_codegen
+};
+
+enum class kernel_param_flag : int {
+  noalias
 };
 
 class string_build_config_mapper {
@@ -100,7 +110,8 @@ public:
       {"rocm-device-libs-path", kernel_build_option::amdgpu_rocm_device_libs_path},
       {"rocm-path", kernel_build_option::amdgpu_rocm_path},
       {"spirv-dynamic-local-mem-allocation-size", kernel_build_option::spirv_dynamic_local_mem_allocation_size},
-      {"musa-target-device", kernel_build_option::musa_target_device}
+      {"musa-target-device", kernel_build_option::musa_target_device},
+      {"host-sub-group-size", kernel_build_option::host_sub_group_size}
     };
 
     _flags = {
@@ -109,7 +120,8 @@ public:
       {"ptx-ftz", kernel_build_flag::ptx_ftz},
       {"ptx-approx-div", kernel_build_flag::ptx_approx_div},
       {"ptx-approx-sqrt", kernel_build_flag::ptx_approx_sqrt},
-      {"spirv-enable-intel-llvm-spirv-options", kernel_build_flag::spirv_enable_intel_llvm_spirv_options}
+      {"spirv-enable-intel-llvm-spirv-options", kernel_build_flag::spirv_enable_intel_llvm_spirv_options},
+      {"host-out-of-process-codegen", kernel_build_flag::host_out_of_process_codegen}
     };
 
     for(const auto& elem : _options) {
@@ -281,6 +293,49 @@ public:
     _build_flags.push_back(flag);
   }
 
+  // Bakes the value of a kernel parameter into the JIT binary.
+  // buffer_value contains the raw bytes of the argument, zero-extended
+  // to 64 bits.
+  void set_specialized_kernel_argument(int param_index, uint64_t buffer_value) {
+    for(auto& entry : _specialized_kernel_args) {
+      if(entry.first == param_index) {
+        entry.second = buffer_value;
+        return;
+      }
+    }
+    _specialized_kernel_args.push_back(std::make_pair(param_index, buffer_value));
+  }
+
+  // Guarantees that the pointer passed to the kernel parameter
+  // is aligned to at least the given number of bytes.
+  void set_known_alignment(int param_index, int alignment) {
+    for(auto& entry : _known_alignments) {
+      if(entry.first == param_index) {
+        entry.second = alignment;
+        return;
+      }
+    }
+    _known_alignments.push_back(std::make_pair(param_index, alignment));
+  }
+
+  void set_kernel_param_flag(int param_index, kernel_param_flag flag) {
+    for(const auto& entry : _kernel_param_flags)
+      if(entry.first == param_index && entry.second == flag)
+        return;
+    _kernel_param_flags.push_back(std::make_pair(param_index, flag));
+  }
+
+  // Removes all entries, but retains allocated storage
+  void clear() {
+    _s2_ir_configurations.clear();
+    _build_flags.clear();
+    _build_options.clear();
+    _specialized_kernel_args.clear();
+    _known_alignments.clear();
+    _kernel_param_flags.clear();
+    _base_configuration_result = {};
+  }
+
   template <class ValueT>
   void append_base_configuration(kernel_base_config_parameter key,
                                  const ValueT &value) {
@@ -326,6 +381,24 @@ public:
                         "", 0);
     }
 
+    for(const auto& entry : _specialized_kernel_args) {
+      uint64_t numeric_param_id = static_cast<uint64_t>(entry.first) | (1ull << 34);
+      add_entry_to_hash(result, &numeric_param_id, sizeof(numeric_param_id),
+                        &entry.second, sizeof(entry.second));
+    }
+
+    for(const auto& entry : _known_alignments) {
+      uint64_t numeric_param_id = static_cast<uint64_t>(entry.first) | (1ull << 35);
+      add_entry_to_hash(result, &numeric_param_id, sizeof(numeric_param_id),
+                        &entry.second, sizeof(entry.second));
+    }
+
+    for(const auto& entry : _kernel_param_flags) {
+      uint64_t numeric_param_id = static_cast<uint64_t>(entry.first) | (1ull << 36);
+      add_entry_to_hash(result, &numeric_param_id, sizeof(numeric_param_id),
+                        &entry.second, sizeof(entry.second));
+    }
+
     return result;
   }
 
@@ -333,6 +406,139 @@ public:
     return _s2_ir_configurations;
   }
 
+  // Writes a single-line textual representation of the configuration.
+  // The base configuration is only available as hash, so a deserialized
+  // configuration reproduces generate_id() and everything that is required
+  // for JIT compilation, but cannot be extended with further base
+  // configuration parameters consistently.
+  void serialize(std::ostream& ostr) const {
+    ostr << _base_configuration_result[0] << " "
+         << _base_configuration_result[1];
+
+    ostr << " " << _s2_ir_configurations.size();
+    for(const auto& entry : _s2_ir_configurations) {
+      ostr << " " << entry.get_name() << " " << entry.get_data_size() << " "
+           << to_hex(entry.get_data_buffer(), entry.get_data_size());
+    }
+
+    ostr << " " << _build_options.size();
+    for(const auto& entry : _build_options) {
+      ostr << " " << glue::to_string(entry.first);
+      if(entry.second.int_value.has_value())
+        ostr << " i " << entry.second.int_value.value();
+      else
+        ostr << " s " << to_hex(entry.second.string_value.value().data(),
+                                entry.second.string_value.value().size());
+    }
+
+    ostr << " " << _build_flags.size();
+    for(const auto& entry : _build_flags)
+      ostr << " " << glue::to_string(entry);
+
+    ostr << " " << _specialized_kernel_args.size();
+    for(const auto& entry : _specialized_kernel_args)
+      ostr << " " << entry.first << " " << entry.second;
+
+    ostr << " " << _known_alignments.size();
+    for(const auto& entry : _known_alignments)
+      ostr << " " << entry.first << " " << entry.second;
+
+    ostr << " " << _kernel_param_flags.size();
+    for(const auto& entry : _kernel_param_flags)
+      ostr << " " << entry.first << " " << static_cast<int>(entry.second);
+  }
+
+  static bool deserialize(std::istream& istr, kernel_configuration& out) {
+    kernel_configuration result;
+    istr >> result._base_configuration_result[0] >>
+        result._base_configuration_result[1];
+
+    std::size_t num_entries = 0;
+    istr >> num_entries;
+    for(std::size_t i = 0; i < num_entries && istr; ++i) {
+      std::string name, hex_value, value;
+      std::size_t size = 0;
+      istr >> name >> size >> hex_value;
+      if(!from_hex(hex_value, value) || value.size() != size)
+        return false;
+
+      if(size == sizeof(uint8_t))
+        result.set_s2_ir_constant(name, load<uint8_t>(value));
+      else if(size == sizeof(uint16_t))
+        result.set_s2_ir_constant(name, load<uint16_t>(value));
+      else if(size == sizeof(uint32_t))
+        result.set_s2_ir_constant(name, load<uint32_t>(value));
+      else if(size == sizeof(uint64_t))
+        result.set_s2_ir_constant(name, load<uint64_t>(value));
+      else
+        return false;
+    }
+
+    istr >> num_entries;
+    for(std::size_t i = 0; i < num_entries && istr; ++i) {
+      std::string name, kind;
+      istr >> name >> kind;
+      auto option = to_build_option(name);
+      if(!option.has_value())
+        return false;
+      if(kind == "i") {
+        uint64_t value = 0;
+        istr >> value;
+        result.set_build_option(option.value(), value);
+      } else if(kind == "s") {
+        std::string hex_value, value;
+        istr >> hex_value;
+        if(!from_hex(hex_value, value))
+          return false;
+        result.set_build_option(option.value(), value);
+      } else {
+        return false;
+      }
+    }
+
+    istr >> num_entries;
+    for(std::size_t i = 0; i < num_entries && istr; ++i) {
+      std::string name;
+      istr >> name;
+      auto flag = to_build_flag(name);
+      if(!flag.has_value())
+        return false;
+      result.set_build_flag(flag.value());
+    }
+
+    // The following sections are optional, so that configurations serialized
+    // before they were introduced remain readable.
+    read_optional_count(istr, num_entries);
+    for(std::size_t i = 0; i < num_entries && istr; ++i) {
+      int param_index = 0;
+      uint64_t value = 0;
+      istr >> param_index >> value;
+      result.set_specialized_kernel_argument(param_index, value);
+    }
+
+    read_optional_count(istr, num_entries);
+    for(std::size_t i = 0; i < num_entries && istr; ++i) {
+      int param_index = 0;
+      int alignment = 0;
+      istr >> param_index >> alignment;
+      result.set_known_alignment(param_index, alignment);
+    }
+
+    read_optional_count(istr, num_entries);
+    for(std::size_t i = 0; i < num_entries && istr; ++i) {
+      int param_index = 0;
+      int flag = 0;
+      istr >> param_index >> flag;
+      result.set_kernel_param_flag(param_index,
+                                   static_cast<kernel_param_flag>(flag));
+    }
+
+    if(istr.fail())
+      return false;
+    out = result;
+    return true;
+  }
+
   const auto& build_options() const {
     return _build_options;
   }
@@ -341,6 +547,18 @@ public:
     return _build_flags;
   }
 
+  const auto& specialized_kernel_args() const {
+    return _specialized_kernel_args;
+  }
+
+  const auto& known_alignments() const {
+    return _known_alignments;
+  }
+
+  const auto& kernel_param_flags() const {
+    return _kernel_param_flags;
+  }
+
 private:
   static const void* data_ptr(const char* data) {
     return data_ptr(std::string{data});
@@ -378,6 +596,56 @@ private:
     return sizeof(T);
   }
 
+  static std::string to_hex(const void* data, std::size_t size) {
+    static constexpr char digits[] = "0123456789abcdef";
+    // Ensure that the token is never empty
+    if(size == 0)
+      return "-";
+    std::string result;
+    for(std::size_t i = 0; i < size; ++i) {
+      auto byte = static_cast<const unsigned char *>(data)[i];
+      result += digits[byte >> 4];
+      result += digits[byte & 0xf];
+    }
+    return result;
+  }
+
+  static bool from_hex(const std::string& hex, std::string& out) {
+    out.clear();
+    if(hex == "-")
+      return true;
+    if(hex.size() % 2 != 0)
+      return false;
+    auto nibble = [](char c) -> int {
+      if(c >= '0' && c <= '9')
+        return c - '0';
+      if(c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+      return -1;
+    };
+    for(std::size_t i = 0; i < hex.size(); i += 2) {
+      int high = nibble(hex[i]);
+      int low = nibble(hex[i + 1]);
+      if(high < 0 || low < 0)
+        return false;
+      out += static_cast<char>((high << 4) | low);
+    }
+    return true;
+  }
+
+  static void read_optional_count(std::istream& istr, std::size_t& count) {
+    count = 0;
+    if(!(istr >> count) && istr.eof())
+      istr.clear(std::ios::eofbit);
+  }
+
+  template<class T>
+  static T load(const std::string& data) {
+    T v;
+    memcpy(&v, data.data(), sizeof(T));
+    return v;
+  }
+
   static void add_entry_to_hash(id_type &hash, const void *key_data,
                          std::size_t key_size, const void *data,
                          std::size_t data_size) {
@@ -392,6 +660,9 @@ private:
   std::vector<s2_ir_configuration_entry> _s2_ir_configurations;
   std::vector<kernel_build_flag> _build_flags;
   std::vector<std::pair<kernel_build_option, int_or_string>> _build_options;
+  std::vector<std::pair<int, uint64_t>> _specialized_kernel_args;
+  std::vector<std::pair<int, int>> _known_alignments;
+  std::vector<std::pair<int, kernel_param_flag>> _kernel_param_flags;
 
   id_type _base_configuration_result = {};
 };
@@ -35,11 +35,14 @@
 #include "hipSYCL/compiler/llvm-to-backend/LLVMToBackend.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
 #include "hipSYCL/glue/kernel_configuration.hpp"
 #include "hipSYCL/runtime/application.hpp"
 #include <cstddef>
 #include <vector>
+#include <memory>
 #include <atomic>
+#include <chrono>
 #include <fstream>
 #include <string>
 
@@ -182,7 +185,7 @@ private:
     return ir_modules_to_link;
   }
 
-  std::string retrieve_bitcode(llvm_module_id id, symbol_list_t& imported_symbols) const {
+  std::string_view retrieve_bitcode(llvm_module_id id, symbol_list_t& imported_symbols) const {
 
     const auto* hcf_image_node = reinterpret_cast<common::hcf_container::node*>(id);
 
@@ -196,7 +199,9 @@ private:
     rt::hcf_object_id hcf_id = v->second;
     imported_symbols = hcf_image_node->get_as_list("imported-symbols");
 
-    std::string bitcode;
+    // Refers to the HCF data owned by the hcf_cache, which outlives
+    // the JIT compilation.
+    std::string_view bitcode;
     rt::hcf_cache::get().get_hcf(hcf_id)->get_binary_attachment(hcf_image_node, bitcode);
 
     return bitcode;
@@ -225,6 +230,25 @@ inline rt::result compile(compiler::LLVMToBackendTranslator *translator,
     translator->setS2IRConstant(entry.get_name(), entry.get_data_buffer());
   }
 
+  for(const auto& entry : config.specialized_kernel_args()) {
+    for(const auto& kernel_name : translator->getKernels())
+      translator->specializeKernelArgument(kernel_name, entry.first,
+                                           &entry.second);
+  }
+
+  for(const auto& entry : config.known_alignments()) {
+    for(const auto& kernel_name : translator->getKernels())
+      translator->setKnownPtrParamAlignment(kernel_name, entry.first,
+                                            entry.second);
+  }
+
+  for(const auto& entry : config.kernel_param_flags()) {
+    if(entry.second == glue::kernel_param_flag::noalias) {
+      for(const auto& kernel_name : translator->getKernels())
+        translator->setNoAliasKernelParam(kernel_name, entry.first);
+    }
+  }
+
   for(const auto& option : config.build_options()) {
     std::string option_name = glue::to_string(option.first);
     std::string option_value =
@@ -240,7 +264,19 @@ inline rt::result compile(compiler::LLVMToBackendTranslator *translator,
   }
 
   // Transform code
-  if(!translator->fullTransformation(source, output)) {
+  auto start = std::chrono::steady_clock::now();
+  bool is_success = translator->fullTransformation(source, output);
+  auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+  static std::atomic<long long> total_jit_time_us = 0;
+  total_jit_time_us += duration_us;
+  HIPSYCL_DEBUG_INFO << "jit::compile: JIT compilation took "
+                     << duration_us / 1000.0 << " ms, total JIT time: "
+                     << total_jit_time_us / 1000.0 << " ms" << std::endl;
+
+  if(!is_success) {
     // In case of failure, if a dump directory for IR is set,
     // dump the IR
     auto failure_dump_directory =
@@ -333,6 +369,28 @@ inline rt::result compile(compiler::LLVMToBackendTranslator* translator,
                  output);
 }
 
+/// Compiles a kernel configuration that was recorded in a previous run.
+/// \param create_translator Backend-specific translator factory, e.g.
+/// compiler::createLLVMToPtxTranslator
+template <class TranslatorFactory>
+inline rt::result
+compile_recorded_configuration(TranslatorFactory &&create_translator,
+                               const common::hcf_container *hcf,
+                               const rt::recorded_kernel_configuration &entry,
+                               std::string &output) {
+  std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+      create_translator(entry.kernel_names);
+  if(!translator) {
+    return rt::make_error(
+        __hipsycl_here(),
+        rt::error_info{"jit::compile_recorded_configuration: Could not "
+                       "construct backend translator"});
+  }
+
+  return compile(translator.get(), hcf, entry.image_name, entry.config,
+                 output);
+}
+
 }
 }
 }
@@ -410,22 +410,22 @@ private:
     std::array<const void*, 1> args{&k};
     std::size_t arg_size = sizeof(k);
 
-    std::string kernel_name = generate_kernel(k);
+    rt::sscp_launch_site& site = generate_kernel(k);
 
     assert(_configuration);
-    auto err = invoker->submit_kernel(
-        *op, __hipsycl_local_sscp_hcf_object_id, num_groups, group_size,
-        local_mem_size, const_cast<void **>(args.data()), &arg_size,
-        args.size(), kernel_name, *_configuration);
+    auto err = invoker->submit_kernel_from_launch_site(
+        *op, site, num_groups, group_size, local_mem_size,
+        const_cast<void **>(args.data()), &arg_size, args.size(),
+        *_configuration);
 
     if(!err.is_success()) {
       rt::register_error(err);
     }
   }
 
-  // Generate SSCP kernel and return name of the generated kernel
+  // Generate SSCP kernel and return the launch site of the generated kernel
   template<class Kernel>
-  static std::string generate_kernel(const Kernel& k) {
+  static rt::sscp_launch_site& generate_kernel(const Kernel& k) {
     if (__hipsycl_sscp_is_device) {
       __hipsycl_sscp_kernel(k);
     }
@@ -436,7 +436,15 @@ private:
     __hipsycl_sscp_extract_kernel_name<Kernel>(
         &__hipsycl_sscp_kernel<Kernel>,
         &__hipsycl_sscp_kernel_name[0]);
-    return std::string{&__hipsycl_sscp_kernel_name[0]};
+    // Only constructed for the first launch, such that subsequent launches
+    // neither need to construct the kernel name nor look up the kernel.
+    // Intentionally leaked: It is constructed after the runtime, so it
+    // would otherwise be destroyed before kernels that are still queued
+    // are drained during runtime shutdown.
+    static rt::sscp_launch_site *site = new rt::sscp_launch_site{
+        __hipsycl_local_sscp_hcf_object_id,
+        std::string{&__hipsycl_sscp_kernel_name[0]}};
+    return *site;
   }
 
   std::function<void (rt::dag_node*)> _invoker;
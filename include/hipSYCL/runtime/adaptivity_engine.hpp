@@ -30,14 +30,61 @@
 
 #include "hipSYCL/glue/kernel_configuration.hpp"
 #include "hipSYCL/runtime/util.hpp"
+#include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/kernel_cache.hpp"
 
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace hipsycl {
 namespace rt {
 
+/// Tracks the values of kernel arguments across launches in order to detect
+/// arguments that are invariant, and can therefore be baked into JIT binaries
+/// without causing a JIT compilation for every launch.
+///
+/// This class is thread-safe.
+class kernel_argument_value_tracker {
+public:
+  static kernel_argument_value_tracker& get();
+
+  /// Registers a kernel launch.
+  /// \param values Argument values for each kernel parameter.
+  /// \param is_candidate Whether each parameter should be tracked at all.
+  /// \param is_invariant_out For each parameter, will be set to whether
+  /// it should be specialized for the current value.
+  void register_launch(const hcf_kernel_info *kernel,
+                       const std::vector<uint64_t> &values,
+                       const std::vector<bool> &is_candidate,
+                       std::size_t launch_threshold,
+                       std::vector<bool> &is_invariant_out);
+
+private:
+  kernel_argument_value_tracker() = default;
+
+  struct argument_state {
+    uint64_t current_value = 0;
+    std::size_t num_launches_with_current_value = 0;
+    std::size_t num_specialized_values = 0;
+    bool is_current_value_specialized = false;
+  };
+
+  // Arguments that have been specialized for this many different
+  // values are no longer considered invariant, to avoid repeated
+  // JIT compilation for values that change slowly but steadily.
+  static constexpr std::size_t max_specialized_values_per_argument = 4;
+
+  std::mutex _mutex;
+  std::unordered_map<const hcf_kernel_info *, std::vector<argument_state>>
+      _arguments;
+};
+
 class kernel_adaptivity_engine {
 public:
   kernel_adaptivity_engine(
+    device_id dev,
     hcf_object_id hcf_object,
     const std::string& backend_kernel_name,
     const hcf_kernel_info* kernel_info,
@@ -51,8 +98,18 @@ public:
   glue::kernel_configuration::id_type
   finalize_binary_configuration(glue::kernel_configuration &config);
 
+  /// Computes a fingerprint that identifies the binary configuration
+  /// that finalize_binary_configuration() would produce for a configuration
+  /// with id \c config_id, without constructing that configuration.
+  /// Returns false if the binary configuration cannot be derived from the
+  /// launch parameters alone, e.g. because it depends on argument values
+  /// tracked across launches.
+  bool get_launch_fingerprint(const glue::kernel_configuration::id_type &config_id,
+                              glue::kernel_configuration::id_type &out);
+
   std::string select_image_and_kernels(std::vector<std::string>* kernel_names_out);
 private:
+  device_id _dev;
   hcf_object_id _hcf;
   const std::string& _kernel_name;
   const hcf_kernel_info* _kernel_info;
@@ -64,6 +121,9 @@ private:
   std::size_t _local_mem_size;
 
   int _adaptivity_level;
+
+  void specialize_kernel_arguments(glue::kernel_configuration &config);
+  void infer_pointer_properties(glue::kernel_configuration &config);
 };
 
 }
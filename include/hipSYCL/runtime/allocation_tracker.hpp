@@ -0,0 +1,84 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_ALLOCATION_TRACKER_HPP
+#define HIPSYCL_ALLOCATION_TRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <shared_mutex>
+#include <tuple>
+
+#include "device_id.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Keeps track of the address ranges of all allocations made by
+/// backend allocators, such that the runtime can find out to which
+/// allocation an arbitrary pointer belongs. Devices might have distinct
+/// address spaces, so allocations are tracked per device.
+///
+/// Tracking is only enabled if ACPP_ADAPTIVITY_LEVEL >= 2, which is the
+/// only configuration that queries allocations. Otherwise, all
+/// functions are no-ops and queries always fail.
+///
+/// This class is thread-safe.
+class allocation_tracker {
+public:
+  static bool is_enabled();
+
+  static void register_allocation(device_id dev, const void *ptr,
+                                  std::size_t size);
+  static void unregister_allocation(device_id dev, const void *ptr);
+
+  /// Finds the allocation on device dev that contains ptr.
+  /// Returns false if ptr does not belong to any known allocation.
+  static bool query_allocation(device_id dev, const void *ptr,
+                               const void *&base_out, std::size_t &size_out);
+
+private:
+  allocation_tracker();
+  static allocation_tracker& get();
+
+  // backend, device index, base address
+  using allocation_key = std::tuple<backend_id, int, uintptr_t>;
+  static allocation_key make_key(device_id dev, uintptr_t address) {
+    return allocation_key{dev.get_backend(), dev.get_id(), address};
+  }
+
+  bool _is_enabled;
+  mutable std::shared_mutex _mutex;
+  // -> allocation size
+  std::map<allocation_key, std::size_t> _allocations;
+};
+
+}
+}
+
+#endif
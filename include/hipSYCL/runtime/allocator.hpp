@@ -50,15 +50,18 @@ struct pointer_info {
 class backend_allocator
 {
 public:
-  virtual void *allocate(size_t min_alignment, size_t size_bytes) = 0;
+  // These register allocations with the allocation_tracker,
+  // and forward to the backend-specific raw_* implementations.
+  void *allocate(size_t min_alignment, size_t size_bytes);
   // Optimized host memory - may be page-locked, device mapped if supported
-  virtual void* allocate_optimized_host(size_t min_alignment, size_t bytes) = 0;
-  virtual void free(void *mem) = 0;
-  
+  void* allocate_optimized_host(size_t min_alignment, size_t bytes);
+  void free(void *mem);
 
   /// Allocate memory accessible both from the host and the backend
-  virtual void *allocate_usm(size_t bytes) = 0;
+  void *allocate_usm(size_t bytes);
   virtual bool is_usm_accessible_from(backend_descriptor b) const = 0;
+  // The device whose address space allocations of this allocator belong to
+  virtual device_id get_device() const = 0;
 
   // Query the given pointer for its properties. If pointer is unknown,
   // returns non-success result.
@@ -68,6 +71,13 @@ public:
                             int advise) const = 0;
 
   virtual ~backend_allocator(){}
+
+protected:
+  virtual void *raw_allocate(size_t min_alignment, size_t size_bytes) = 0;
+  virtual void *raw_allocate_optimized_host(size_t min_alignment,
+                                            size_t bytes) = 0;
+  virtual void raw_free(void *mem) = 0;
+  virtual void *raw_allocate_usm(size_t bytes) = 0;
 };
 
 }
@@ -28,7 +28,11 @@
 #ifndef HIPSYCL_RUNTIME_BACKEND_HPP
 #define HIPSYCL_RUNTIME_BACKEND_HPP
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -37,6 +41,9 @@
 #include "backend_loader.hpp"
 
 namespace hipsycl {
+namespace common {
+class hcf_container;
+}
 namespace rt {
 
 class backend_executor;
@@ -44,6 +51,8 @@ class backend_allocator;
 class backend_hardware_manager;
 class hw_model;
 class kernel_cache;
+class result;
+struct recorded_kernel_configuration;
 
 class backend
 {
@@ -75,14 +84,29 @@ public:
   // priority. It is backend-specific if or how this will affect execution.
   virtual std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) = 0;
+
+  // This is optional; backends with SSCP JIT support can use it to compile
+  // a kernel configuration that was recorded in a previous run, without
+  // having to submit a kernel. The resulting binary is the same that the
+  // backend would have produced for this configuration at submission time.
+  //
+  // If unsupported by the backend, returns an error.
+  virtual result jit_compile_recorded_configuration(
+      const common::hcf_container *hcf,
+      const recorded_kernel_configuration &entry,
+      std::string &binary_out) const;
 };
 
+/// Owns all backends. Backends are created concurrently unless
+/// ACPP_RT_PARALLEL_BACKEND_INIT=0. With ACPP_RT_LAZY_BACKEND_INIT=1, only
+/// the CPU backend is created at startup; other backends are created once
+/// they are requested with get(), or when all backends are enumerated
+/// with for_each_backend().
+///
+/// This class is thread-safe.
 class backend_manager
 {
 public:
-  using backend_list_type =
-      std::vector<std::unique_ptr<backend>>;
-
   backend_manager();
   ~backend_manager();
   
@@ -93,14 +117,73 @@ public:
   template<class F>
   void for_each_backend(F f)
   {
-    for(auto& b : _backends){
-      f(b.get());
+    initialize_all_backends();
+    for(auto& slot : _backends){
+      if(backend* b = slot->get_if_initialized())
+        f(b);
     }
   }
 
+  /// Returns the backend if it has already been created, nullptr otherwise.
+  /// Unlike get(), never causes backend creation.
+  backend* get_if_initialized(backend_id) const;
+  /// Returns true if the backend has not been created yet due to
+  /// ACPP_RT_LAZY_BACKEND_INIT, but may still be created later.
+  bool is_initialization_pending(backend_id) const;
+  /// Registers a callback that is invoked for every backend that is
+  /// created from now on. The callback is invoked from the thread that
+  /// creates the backend while backend creation is locked, so it must
+  /// be cheap and must not access the backend_manager. Callbacks remain
+  /// registered for the lifetime of the backend_manager.
+  void add_initialization_listener(std::function<void(backend *)> listener);
+
 private:
+  class backend_slot {
+  public:
+    backend_slot(std::size_t loader_index, std::optional<backend_id> id)
+        : _loader_index{loader_index}, _expected_id{id} {}
+
+    // Returns nullptr if the backend has not been created (yet),
+    // or if its creation has failed.
+    backend *get_if_initialized() const {
+      if (!_is_initialized.load(std::memory_order_acquire))
+        return nullptr;
+      return _backend.get();
+    }
+
+    bool is_initialized() const {
+      return _is_initialized.load(std::memory_order_acquire);
+    }
+
+    // Must only be invoked once
+    void set_backend(std::unique_ptr<backend> b) {
+      _backend = std::move(b);
+      _is_initialized.store(true, std::memory_order_release);
+    }
+
+    std::size_t get_loader_index() const { return _loader_index; }
+    // The backend id as inferred from the plugin name, if known
+    const std::optional<backend_id> &get_expected_id() const {
+      return _expected_id;
+    }
+
+  private:
+    std::size_t _loader_index;
+    std::optional<backend_id> _expected_id;
+    std::unique_ptr<backend> _backend;
+    std::atomic<bool> _is_initialized{false};
+  };
+
+  // Creates the backends of all given slots that are not yet initialized.
+  void initialize_backends(const std::vector<backend_slot *> &slots) const;
+  void initialize_all_backends() const;
+
   backend_loader _loader;
-  backend_list_type _backends;
+  // The list of slots is fixed after construction
+  std::vector<std::unique_ptr<backend_slot>> _backends;
+  mutable std::mutex _initialization_mutex;
+  // Protected by _initialization_mutex
+  std::vector<std::function<void(backend *)>> _initialization_listeners;
 
   std::unique_ptr<hw_model> _hw_model;
   std::shared_ptr<kernel_cache> _kernel_cache;
@@ -29,12 +29,14 @@
 #define HIPSYCL_BACKEND_LOADER_HPP
 
 
+#include <optional>
 #include <string>
 #include <vector>
 #include <utility>
 
 namespace hipsycl::rt {
 class backend;
+enum class backend_id;
 }
 
 #ifndef _WIN32
@@ -66,6 +68,10 @@ public:
   backend *create(std::size_t index) const;
   backend *create(const std::string &name) const;
 
+  // Maps the name of a plugin to the id of the backend it provides,
+  // if it is one of the backends that are part of AdaptiveCpp.
+  static std::optional<backend_id> get_backend_id(const std::string &name);
+
 private:
   using handle_t = void*;
   std::vector<std::pair<std::string, handle_t>> _handles;
@@ -34,6 +34,7 @@
 #include "util.hpp"
 #include "kernel_cache.hpp"
 #include "operations.hpp"
+#include "sscp_launch_site.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -62,6 +63,19 @@ public:
                                const std::string &kernel_name,
                                const glue::kernel_configuration& config) = 0;
 
+  /// Submits the kernel of the given launch site. Backends can override
+  /// this to cache resolved launch information in the site across launches;
+  /// the default implementation is equivalent to submit_kernel().
+  virtual result submit_kernel_from_launch_site(
+      const kernel_operation &op, sscp_launch_site &site,
+      const rt::range<3> &num_groups, const rt::range<3> &group_size,
+      unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+      std::size_t num_args, const glue::kernel_configuration &config) {
+    return submit_kernel(op, site.get_hcf_object(), num_groups, group_size,
+                         local_mem_size, args, arg_sizes, num_args,
+                         site.get_kernel_name(), config);
+  }
+
   virtual rt::range<3> select_group_size(const rt::range<3> &global_range,
                                          const rt::range<3> &group_size) const {
     rt::range<3> selected_group_size = group_size;
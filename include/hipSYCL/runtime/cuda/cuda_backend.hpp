@@ -62,6 +62,11 @@ public:
 
   virtual std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) override;
+
+  virtual result jit_compile_recorded_configuration(
+      const common::hcf_container *hcf,
+      const recorded_kernel_configuration &entry,
+      std::string &binary_out) const override;
 private:
   mutable cuda_hardware_manager _hw_manager;
   mutable lazily_constructed_executor<multi_queue_executor> _executor;
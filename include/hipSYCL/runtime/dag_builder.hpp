@@ -63,6 +63,20 @@ public:
                                const requirements_list &requirements,
                                const execution_hints &hints = {});
 
+  /// Attempts to construct a node that bypasses the DAG and the scheduler,
+  /// such that it can be submitted directly to an executor by the caller.
+  /// This only succeeds if all buffer requirements can be satisfied
+  /// without data transfers or allocations on their target device, and all
+  /// conflicting accesses have already been submitted.
+  /// In this case, the requirements are processed as the scheduler would,
+  /// and the new node is registered as data user.
+  /// Otherwise, nullptr is returned and \c op remains untouched.
+  ///
+  /// \c hints must contain a bind_to_device hint.
+  dag_node_ptr build_instant_node(std::unique_ptr<operation> &op,
+                                  const requirements_list &requirements,
+                                  const execution_hints &hints);
+
   dag finish_and_reset();
 
   std::size_t get_current_dag_size() const;
@@ -70,6 +84,8 @@ private:
   bool is_conflicting_access(const memory_requirement *mem_req,
                              const data_user &user) const;
 
+  void add_conflicts_as_requirements(dag_node_ptr req_node) const;
+
   dag_node_ptr build_node(std::unique_ptr<operation> op,
                           const requirements_list &requirements,
                           const execution_hints &hints);
@@ -62,6 +62,17 @@ public:
   node_list_t get_group(std::size_t node_group_id);
 
   void register_submitted_ops(dag_node_ptr);
+
+  // Builds a node for instant submission that bypasses the DAG and
+  // scheduler, if its buffer requirements allow for this. Returns nullptr
+  // and leaves op untouched otherwise. See dag_builder::build_instant_node().
+  dag_node_ptr build_instant_node(std::unique_ptr<operation> &op,
+                                  const requirements_list &requirements,
+                                  const execution_hints &hints);
+  // Keeps an instantly submitted node alive until it has completed.
+  // This is required for nodes that are referenced by data users or
+  // that own resources used during execution.
+  void register_instant_submission(dag_node_ptr node);
 private:
   void trigger_flush_opportunity();
 
@@ -29,6 +29,12 @@
 #ifndef HIPSYCL_DAG_UNBOUND_SCHEDULER_HPP
 #define HIPSYCL_DAG_UNBOUND_SCHEDULER_HPP
 
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "dag_node.hpp"
 #include "dag_direct_scheduler.hpp"
 
@@ -37,15 +43,68 @@ namespace rt {
 
 class runtime;
 
+/// Scheduler that assigns devices to nodes that are not bound to a device
+/// and then forwards them to the dag_direct_scheduler.
+///
+/// With scheduler_type::unbound, devices are assigned round-robin.
+/// With scheduler_type::load_aware, each eligible device is scored by the
+/// estimated time until the node could complete on it: The time for the
+/// data transfers that its buffer requirements would need (based on the
+/// memcpy_model), the estimated runtime of the work that this scheduler has
+/// assigned to the device and that is still outstanding, and the estimated
+/// runtime of the node itself.
+/// Runtime estimates of kernels are learned per kernel name and device from
+/// instrumentation timestamps, if nodes request them (e.g. with profiling
+/// queues).
 class dag_unbound_scheduler {
 public:
   dag_unbound_scheduler(runtime* rt);
 
   void submit(dag_node_ptr node);
 private:
+  // Nodes are tracked weakly, so that the scheduler does not
+  // prolong the lifetime of nodes and the data they reference.
+  struct outstanding_node {
+    std::weak_ptr<dag_node> node;
+    double estimated_runtime_ns;
+  };
+
+  struct device_load {
+    std::deque<outstanding_node> outstanding_nodes;
+    double outstanding_runtime_ns = 0.0;
+  };
+
+  struct runtime_estimate {
+    double mean_ns = 0.0;
+    std::size_t num_samples = 0;
+  };
+
+  struct kernel_measurement {
+    std::weak_ptr<dag_node> node;
+    std::string kernel_name;
+    std::size_t device_index;
+  };
+
+  device_id select_load_aware(dag_node_ptr node,
+                              const std::vector<device_id> &eligible_devices);
+  double estimate_transfer_time_ns(dag_node_ptr node, device_id dev) const;
+  double estimate_runtime_ns(const std::string &kernel_name,
+                             std::size_t device_index) const;
+  void update_device_load(device_load &load);
+  void process_kernel_measurements();
+  std::size_t get_device_index(device_id dev);
+
   std::vector<device_id> _devices;
   rt::dag_direct_scheduler _direct_scheduler;
   runtime* _rt;
+  std::size_t _round_robin_counter = 0;
+
+  // Indexed by position in _devices
+  std::vector<device_load> _device_loads;
+  std::vector<runtime_estimate> _average_runtimes;
+  std::unordered_map<std::string, std::vector<runtime_estimate>>
+      _kernel_runtimes;
+  std::vector<kernel_measurement> _pending_measurements;
 };
 
 }
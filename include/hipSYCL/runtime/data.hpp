@@ -56,7 +56,20 @@ public:
     available,
   };
 
-  range_store(range<3> size);
+  /// How the state of the pages is stored.
+  /// * \c dense keeps one entry per page. Operations scale with the number
+  ///   of pages in the affected range.
+  /// * \c sparse keeps a list of disjoint boxes of available pages.
+  ///   Operations scale with the number of boxes, which is independent of
+  ///   the number of pages and typically small, since accesses usually
+  ///   cover few large contiguous regions.
+  enum class representation
+  {
+    dense,
+    sparse
+  };
+
+  range_store(range<3> size, representation rep = representation::dense);
 
   void add(const rect& r);
   
@@ -84,7 +97,21 @@ public:
   bool entire_range_empty(const rect& r) const
   { return entire_range_equals(r, data_state::empty); }
 
+  representation get_representation() const
+  { return _representation; }
+
 private:
+  void sparse_intersections_with(const rect& r,
+                                 data_state desired_state,
+                                 std::vector<rect>& out) const;
+
+  bool sparse_entire_range_equals(const rect& r,
+                                  data_state desired_state) const;
+
+  void sparse_add(const rect& r);
+
+  void sparse_remove(const rect& r);
+
   template<class Entry_selection_predicate>
   range<3> find_max_contiguous_rect_extent(
     id<3> begin,
@@ -209,7 +236,11 @@ private:
   }
 
   range<3> _size;
+  representation _representation;
+  // Used by the dense representation
   std::vector<data_state> _contained_data;
+  // Used by the sparse representation: Disjoint boxes of available pages
+  std::vector<rect> _available_boxes;
 };
 
 
@@ -223,37 +254,70 @@ struct data_user
 };
 
 
+/// Tracks the users (DAG nodes) of a data region.
+///
+/// To avoid linear scans over all users on buffers that are accessed
+/// by many kernels operating on disjoint sub-ranges, users are indexed
+/// by the pages they access along the slowest dimension of the page table
+/// that spans more than one page. The index is a hierarchy of buckets:
+/// Level l splits the pages of this dimension into 2^l buckets,
+/// and each user is stored at the deepest level where its page range
+/// fits into a single bucket. Looking up users that may
+/// intersect with a given range therefore only needs to visit
+/// one bucket range per level. Users that only read are stored
+/// separately from users that write, since two reads never conflict.
 class data_user_tracker
 {
 public:
-  using user_iterator = std::vector<data_user>::iterator;
-  using const_user_iterator = std::vector<data_user>::const_iterator;
-
-  data_user_tracker() = default;
+  data_user_tracker();
+  /// \param page_size The page size of the data region in elements
+  /// \param num_pages The number of pages of the data region
+  data_user_tracker(range<3> page_size, range<3> num_pages);
   data_user_tracker(const data_user_tracker& other);
   data_user_tracker(data_user_tracker&& other);
-  data_user_tracker& operator=(data_user_tracker other);
+  data_user_tracker& operator=(const data_user_tracker& other);
   data_user_tracker& operator=(data_user_tracker&& other);
 
   const std::vector<data_user> get_users() const;
 
+  /// Invokes f for all users. The order is unspecified.
   template<class F>
   void for_each_user(F f){
     std::lock_guard<std::mutex> lock{_lock};
-    // Iterate in reverse order over the users since
-    // this will iterate over the newest users first.
-    // This is a more advantageous pattern e.g. during
-    // DAG construction as it allows finding the relevant users
-    // quicker.
-    for(int i = _users.size() - 1; i >= 0; --i) {
-      f(_users[i]);
-    }
+    for(auto& bucket : _read_users.buckets)
+      for_each_in_bucket(bucket, f);
+    for(auto& bucket : _write_users.buckets)
+      for_each_in_bucket(bucket, f);
+  }
+
+  /// Invokes f for all users that may conflict with an access
+  /// of the given mode and range, i.e. a superset of the users
+  /// whose accessed pages intersect with the given range and where
+  /// at least one of the accesses writes.
+  template<class F>
+  void for_each_potentially_conflicting_user(id<3> offset, range<3> range,
+                                             sycl::access::mode mode, F f) {
+    std::lock_guard<std::mutex> lock{_lock};
+    std::size_t page_begin, page_end;
+    get_index_page_range(offset, range, page_begin, page_end);
+
+    if(mode != sycl::access::mode::read)
+      for_each_in_page_range(_read_users, page_begin, page_end,
+                             [&](std::vector<data_user> &bucket) {
+                               for_each_in_bucket(bucket, f);
+                             });
+    for_each_in_page_range(_write_users, page_begin, page_end,
+                           [&](std::vector<data_user> &bucket) {
+                             for_each_in_bucket(bucket, f);
+                           });
   }
 
   bool has_user(dag_node_ptr user) const;
 
   void release_dead_users();
 
+  /// Registers a new user. Existing users whose accessed pages
+  /// intersect with the new user are removed if replaces_user returns true.
   template<class Predicate>
   void add_user(dag_node_ptr user, 
                 sycl::access::mode mode, 
@@ -263,15 +327,82 @@ public:
                 Predicate replaces_user) {
     std::lock_guard<std::mutex> lock{_lock};
 
-    _users.erase(std::remove_if(_users.begin(), _users.end(), replaces_user), 
-      _users.end());
-
-    _users.push_back(
-      data_user{std::weak_ptr<dag_node>(user), mode, target, offset, range});
+    std::size_t page_begin, page_end;
+    get_index_page_range(offset, range, page_begin, page_end);
+
+    auto erase_replaced_users = [&](bucket_hierarchy &h) {
+      for_each_in_page_range(h, page_begin, page_end,
+                             [&](std::vector<data_user> &bucket) {
+                               std::size_t old_size = bucket.size();
+                               bucket.erase(std::remove_if(bucket.begin(),
+                                                           bucket.end(),
+                                                           replaces_user),
+                                            bucket.end());
+                               h.num_users -= old_size - bucket.size();
+                             });
+    };
+    erase_replaced_users(_read_users);
+    erase_replaced_users(_write_users);
+
+    bucket_hierarchy &h =
+        (mode == sycl::access::mode::read) ? _read_users : _write_users;
+    h.buckets[get_bucket(page_begin, page_end)].push_back(
+        data_user{std::weak_ptr<dag_node>(user), mode, target, offset, range});
+    ++h.num_users;
   }
 
 private:
-  std::vector<data_user> _users;
+  struct bucket_hierarchy {
+    // Buckets of all levels; level l occupies indices [2^l - 1, 2^(l+1) - 1)
+    std::vector<std::vector<data_user>> buckets;
+    std::size_t num_users = 0;
+  };
+
+  template<class F>
+  static void for_each_in_bucket(std::vector<data_user>& bucket, F& f) {
+    // Iterate in reverse order since this will iterate over
+    // the newest users first. This is a more advantageous pattern
+    // e.g. during DAG construction as it allows finding the relevant
+    // users quicker.
+    for(std::size_t i = bucket.size(); i > 0; --i)
+      f(bucket[i - 1]);
+  }
+
+  template<class F>
+  void for_each_in_page_range(bucket_hierarchy &h, std::size_t page_begin,
+                              std::size_t page_end, F &&f) {
+    if(h.num_users == 0 || page_begin >= page_end)
+      return;
+    std::size_t leaf_begin = get_leaf(page_begin);
+    std::size_t leaf_end = get_leaf(page_end - 1);
+    for(int level = 0; level < _num_levels; ++level) {
+      int shift = _num_levels - 1 - level;
+      std::size_t level_offset = (std::size_t{1} << level) - 1;
+      for(std::size_t b = leaf_begin >> shift; b <= leaf_end >> shift; ++b)
+        f(h.buckets[level_offset + b]);
+    }
+  }
+
+  std::size_t get_leaf(std::size_t page) const {
+    return page * (std::size_t{1} << (_num_levels - 1)) / _num_index_pages;
+  }
+
+  // Returns the index of the bucket in which a user accessing
+  // the given pages is stored
+  std::size_t get_bucket(std::size_t page_begin, std::size_t page_end) const;
+
+  // Returns the accessed pages along the index dimension
+  void get_index_page_range(id<3> offset, range<3> range,
+                            std::size_t &page_begin,
+                            std::size_t &page_end) const;
+
+  range<3> _page_size;
+  int _index_dim;
+  std::size_t _num_index_pages;
+  int _num_levels;
+
+  bucket_hierarchy _read_users;
+  bucket_hierarchy _write_users;
   mutable std::mutex _lock;
 };
 
@@ -404,16 +535,22 @@ public:
   /// dimension must be a multiple of the page size
   /// \param page_size The size (numbers of elements) of the granularity of data
   /// management
-  data_region(
-      range<3> num_elements, std::size_t element_size, range<3> page_size)
+  /// \param page_table_representation How the state of pages is tracked for
+  /// each allocation
+  data_region(range<3> num_elements, std::size_t element_size,
+              range<3> page_size,
+              range_store::representation page_table_representation =
+                  range_store::representation::dense)
       : _element_size{element_size}, _page_size{page_size},
-        _num_elements{num_elements} {
+        _num_elements{num_elements},
+        _page_table_representation{page_table_representation} {
 
     for(std::size_t i = 0; i < 3; ++i){
       assert(page_size[i] > 0);
       _num_pages[i] = (num_elements[i] + page_size[i] - 1) / page_size[i];
       assert(_num_pages[i] > 0);
     }
+    _user_tracker = data_user_tracker{_page_size, _num_pages};
 
     HIPSYCL_DEBUG_INFO << "data_region: constructed with page table dimensions "
                        << _num_pages[0] << " " << _num_pages[1] << " "
@@ -589,6 +726,19 @@ public:
               const range_store::rect& data_range,
               std::vector<std::pair<device_id, range_store::rect>>& update_sources) const
   {
+    if(!try_get_update_source_candidates(d, data_range, update_sources)){
+      assert(false && "Could not find valid data source for updating data buffer - "
+              "this can happen if several data transfers are required to update accessed range, "
+              "which is not yet supported.");
+    }
+  }
+
+  /// Like get_update_source_candidates(), but returns false instead of
+  /// asserting if no allocation holds the entire range.
+  bool try_get_update_source_candidates(
+      const device_id &d, const range_store::rect &data_range,
+      std::vector<std::pair<device_id, range_store::rect>> &update_sources)
+      const {
     update_sources.clear();
 
     page_range pr = get_page_range(data_range.first, data_range.second);
@@ -603,11 +753,7 @@ public:
       }
       return true;
     });
-    if(update_sources.empty()){
-      assert(false && "Could not find valid data source for updating data buffer - "
-              "this can happen if several data transfers are required to update accessed range, "
-              "which is not yet supported.");
-    }
+    return !update_sources.empty();
   }
 
   data_user_tracker& get_users()
@@ -710,7 +856,8 @@ private:
     assert(!has_allocation(d));
 
     data_allocation<Memory_descriptor> new_alloc{
-        d, memory_context, range_store{_num_pages}, takes_ownership, allocator};
+        d, memory_context, range_store{_num_pages, _page_table_representation},
+        takes_ownership, allocator};
 
     if constexpr(InitialState == initial_data_state::invalid) {
       new_alloc.invalid_pages.add(std::make_pair(id<3>{0, 0, 0}, _num_pages));
@@ -731,6 +878,7 @@ private:
   range<3> _page_size;
   range<3> _num_pages;
   range<3> _num_elements;
+  range_store::representation _page_table_representation;
 
   data_user_tracker _user_tracker;
 };
@@ -31,19 +31,126 @@
 #include <thread>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <mutex>
-#include <functional>
-#include <queue>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 
 namespace hipsycl {
 namespace rt {
 
+/// A move-only, type-erased void() callable. Callables that fit into
+/// the internal buffer are stored inline, so that enqueuing typical
+/// lambdas does not require a separate memory allocation.
+class worker_task
+{
+public:
+  static constexpr std::size_t inline_buffer_size = 48;
+
+  worker_task() = default;
+
+  template <class F, std::enable_if_t<!std::is_same_v<std::decay_t<F>,
+                                                       worker_task>, int> = 0>
+  worker_task(F &&f) {
+    using callable_type = std::decay_t<F>;
+
+    if constexpr (is_stored_inline<callable_type>()) {
+      new (&_storage) callable_type(std::forward<F>(f));
+      _ops = &inline_ops<callable_type>;
+    } else {
+      callable_type *heap_callable = new callable_type(std::forward<F>(f));
+      new (&_storage) callable_type *(heap_callable);
+      _ops = &heap_ops<callable_type>;
+    }
+  }
+
+  worker_task(worker_task &&other) noexcept
+  : _ops{other._ops} {
+    if(_ops) {
+      _ops->move(&_storage, &other._storage);
+      other._ops = nullptr;
+    }
+  }
+
+  worker_task &operator=(worker_task &&other) noexcept {
+    if(this != &other) {
+      reset();
+      _ops = other._ops;
+      if(_ops) {
+        _ops->move(&_storage, &other._storage);
+        other._ops = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  worker_task(const worker_task &) = delete;
+  worker_task &operator=(const worker_task &) = delete;
+
+  ~worker_task() { reset(); }
+
+  void operator()() {
+    if(_ops)
+      _ops->invoke(&_storage);
+  }
+
+  explicit operator bool() const { return _ops != nullptr; }
+
+private:
+  struct operations {
+    void (*invoke)(void *storage);
+    // Move-constructs into uninitialized dest, and destroys src
+    void (*move)(void *dest, void *src);
+    void (*destroy)(void *storage);
+  };
+
+  template <class Callable> static constexpr bool is_stored_inline() {
+    return sizeof(Callable) <= inline_buffer_size &&
+           alignof(Callable) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Callable>;
+  }
+
+  template <class Callable>
+  static constexpr operations inline_ops = {
+      [](void *storage) { (*static_cast<Callable *>(storage))(); },
+      [](void *dest, void *src) {
+        Callable *src_callable = static_cast<Callable *>(src);
+        new (dest) Callable(std::move(*src_callable));
+        src_callable->~Callable();
+      },
+      [](void *storage) { static_cast<Callable *>(storage)->~Callable(); }};
+
+  template <class Callable>
+  static constexpr operations heap_ops = {
+      [](void *storage) { (**static_cast<Callable **>(storage))(); },
+      [](void *dest, void *src) {
+        new (dest) Callable *(*static_cast<Callable **>(src));
+      },
+      [](void *storage) { delete *static_cast<Callable **>(storage); }};
+
+  void reset() {
+    if(_ops) {
+      _ops->destroy(&_storage);
+      _ops = nullptr;
+    }
+  }
+
+  const operations *_ops = nullptr;
+  std::aligned_storage_t<inline_buffer_size, alignof(std::max_align_t)>
+      _storage;
+};
+
 /// A worker thread that processes a queue in the background.
+///
+/// Tasks can be enqueued concurrently from multiple threads. Enqueuing
+/// is lock-free; only if the worker thread has gone to sleep due to lack
+/// of work does the producer need to wake it up.
 class worker_thread
 {
 public:
-  using async_function = std::function<void ()>;
+  using async_function = worker_task;
 
   /// Construct object
   worker_thread();
@@ -61,7 +168,8 @@ public:
   /// \param f The function to enqueue for execution
   void operator()(async_function f);
 
-  /// \return The number of enqueued operations
+  /// \return The number of enqueued operations, including the one
+  /// currently being executed.
   std::size_t queue_size() const;
 
   /// Stop the worker thread
@@ -73,14 +181,39 @@ private:
   /// supplied.
   void work();
 
+  // Multi-producer single-consumer queue, based on
+  // D. Vyukov's node-based MPSC queue
+  struct task_node {
+    std::atomic<task_node*> next{nullptr};
+    async_function task;
+  };
+
+  void push(task_node* node);
+  // Only called by the worker thread. Returns false if the queue is empty,
+  // or a producer has not yet finished linking its node.
+  bool try_pop(async_function& out);
+  bool is_queue_empty() const;
+
   std::thread _worker_thread;
 
   std::atomic<bool> _continue;
 
-  std::condition_variable _condition_wait;
-  mutable std::mutex _mutex;
+  // Producers enqueue at the head
+  alignas(64) std::atomic<task_node*> _head;
+  // Consumer dequeues at the tail. The tail node is always a stub that
+  // does not carry a task.
+  alignas(64) task_node* _tail;
+
+  // Number of tasks that have been enqueued, but not yet completed
+  alignas(64) std::atomic<std::size_t> _num_pending_tasks;
+
+  std::atomic<bool> _is_worker_sleeping;
+  std::atomic<std::size_t> _num_waiting_threads;
 
-  std::queue<async_function> _enqueued_operations;
+  // Used for parking the worker thread, and threads in wait()
+  std::mutex _mutex;
+  std::condition_variable _work_available;
+  std::condition_variable _all_tasks_completed;
 };
 
 }
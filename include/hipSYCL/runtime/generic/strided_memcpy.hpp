@@ -0,0 +1,136 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_STRIDED_MEMCPY_HPP
+#define HIPSYCL_STRIDED_MEMCPY_HPP
+
+#include <cstddef>
+
+#include "hipSYCL/runtime/operations.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Describes a memcpy_operation as num_slices x num_rows rows of row_size
+/// contiguous bytes each. Pitches are in bytes. Dimensions that are
+/// contiguous in both source and destination are folded into the row,
+/// so e.g. copying complete rows of a 2D buffer results in a single row
+/// and can be executed as a 1D memcpy.
+struct strided_memcpy_layout {
+  std::size_t row_size = 0;
+  std::size_t num_rows = 1;
+  std::size_t num_slices = 1;
+
+  std::size_t src_row_pitch = 0;
+  std::size_t src_slice_pitch = 0;
+  std::size_t dest_row_pitch = 0;
+  std::size_t dest_slice_pitch = 0;
+
+  strided_memcpy_layout() = default;
+
+  strided_memcpy_layout(const memcpy_operation& op) {
+    const range<3> transfer_range = op.get_num_transferred_elements();
+    const range<3> src_shape = op.source().get_allocation_shape();
+    const range<3> dest_shape = op.dest().get_allocation_shape();
+    const std::size_t element_size = op.source().get_element_size();
+
+    struct dimension {
+      std::size_t count;
+      std::size_t src_pitch;
+      std::size_t dest_pitch;
+    };
+
+    // Outer dimensions, from the innermost to the outermost
+    dimension dims[2] = {
+        {transfer_range[1], src_shape[2] * element_size,
+         dest_shape[2] * element_size},
+        {transfer_range[0], src_shape[1] * src_shape[2] * element_size,
+         dest_shape[1] * dest_shape[2] * element_size}};
+
+    row_size = transfer_range[2] * element_size;
+
+    int num_dims = 0;
+    for(const dimension& d : dims) {
+      if(d.count == 1)
+        continue;
+      // Dimensions can only be folded into the row as long as
+      // there is no gap between consecutive rows on either side.
+      if(num_dims == 0 && d.src_pitch == row_size && d.dest_pitch == row_size)
+        row_size *= d.count;
+      else
+        dims[num_dims++] = d;
+    }
+
+    if(num_dims > 0) {
+      num_rows = dims[0].count;
+      src_row_pitch = dims[0].src_pitch;
+      dest_row_pitch = dims[0].dest_pitch;
+    }
+    if(num_dims > 1) {
+      num_slices = dims[1].count;
+      src_slice_pitch = dims[1].src_pitch;
+      dest_slice_pitch = dims[1].dest_pitch;
+    } else {
+      // Keep pitches valid for APIs that always expect 3D descriptions
+      src_slice_pitch = src_row_pitch * num_rows;
+      dest_slice_pitch = dest_row_pitch * num_rows;
+    }
+    if(num_dims == 0) {
+      src_row_pitch = row_size;
+      dest_row_pitch = row_size;
+      src_slice_pitch = row_size;
+      dest_slice_pitch = row_size;
+    }
+  }
+
+  /// \return 1 if the copy is contiguous, 2 or 3 if it requires
+  /// rows or slices of rows, respectively.
+  int get_dimension() const {
+    if(num_slices > 1)
+      return 3;
+    if(num_rows > 1)
+      return 2;
+    return 1;
+  }
+
+  std::size_t get_num_total_rows() const {
+    return num_rows * num_slices;
+  }
+
+  std::size_t get_src_row_offset(std::size_t slice, std::size_t row) const {
+    return slice * src_slice_pitch + row * src_row_pitch;
+  }
+
+  std::size_t get_dest_row_offset(std::size_t slice, std::size_t row) const {
+    return slice * dest_slice_pitch + row * dest_row_pitch;
+  }
+};
+
+}
+}
+
+#endif
@@ -61,6 +61,11 @@ public:
   virtual std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) override;
 
+  virtual result jit_compile_recorded_configuration(
+      const common::hcf_container *hcf,
+      const recorded_kernel_configuration &entry,
+      std::string &binary_out) const override;
+
   hip_event_pool* get_event_pool(device_id dev) const;
 private:
   mutable hip_hardware_manager _hw_manager;
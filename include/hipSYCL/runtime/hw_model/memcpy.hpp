@@ -28,6 +28,10 @@
 #ifndef HIPSYCL_MEMCPY_HPP
 #define HIPSYCL_MEMCPY_HPP
 
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include "../operations.hpp"
 #include "../util.hpp"
@@ -37,19 +41,111 @@ namespace rt {
 
 class backend_manager;
 
+/// Models the cost of data transfers between pairs of devices
+/// as latency + size / bandwidth.
+///
+/// Parameters for a (source, destination) device pair are fitted to measured
+/// transfers, which can come from
+/// * a calibration microbenchmark that is run once per device pair
+///   if ACPP_RT_MEMCPY_MODEL_CALIBRATION is enabled. Results are persisted
+///   in the tuning database directory and reused by subsequent runs.
+/// * online measurements of memcpy operations using instrumentation
+///   timestamps if ACPP_RT_MEMCPY_MODEL_ONLINE_MEASUREMENT is enabled.
+/// Device pairs without measurements use defaults that only depend on
+/// whether source and destination are the same device or belong to the same
+/// hardware platform.
 class memcpy_model
 {
 public:
-  memcpy_model(backend_manager* mgr){}
+  memcpy_model(backend_manager* mgr);
+  ~memcpy_model();
 
+  /// Returns the estimated duration of the transfer in nanoseconds
   cost_type estimate_runtime_cost(const memory_location &source,
                                   const memory_location &dest,
                                   range<3> num_elements) const;
 
+  /// Returns the candidate with the lowest estimated transfer cost.
+  /// If calibration is enabled, this first calibrates all device pairs
+  /// under consideration that have not been calibrated yet.
   memory_location
   choose_source(const std::vector<memory_location> &candidate_sources,
-                const memory_location &target, range<3> num_elements) const;
+                const memory_location &target, range<3> num_elements);
 
+  /// Adds a measured transfer to the model.
+  void add_measurement(device_id source, device_id dest, std::size_t num_bytes,
+                       double nanoseconds);
+
+  /// Registers a submitted memcpy whose instrumentation timestamps
+  /// will be fed into the model once it has completed. The node must have
+  /// requested start and finish timestamps. op must be owned by node.
+  void track_transfer(dag_node_ptr node, const memcpy_operation *op);
+
+  /// Runs the calibration microbenchmark for the given device pair.
+  result calibrate(device_id source, device_id dest);
+
+private:
+  struct link_key {
+    int source_backend;
+    int source_device;
+    int dest_backend;
+    int dest_device;
+
+    friend bool operator==(const link_key &a, const link_key &b) {
+      return a.source_backend == b.source_backend &&
+             a.source_device == b.source_device &&
+             a.dest_backend == b.dest_backend && a.dest_device == b.dest_device;
+    }
+  };
+
+  struct link_key_hash {
+    std::size_t operator()(const link_key &k) const {
+      std::size_t h = 0;
+      for (int v : {k.source_backend, k.source_device, k.dest_backend,
+                    k.dest_device})
+        h = h * 31 + std::hash<int>{}(v);
+      return h;
+    }
+  };
+
+  // Sums for a linear least-squares fit of duration (ns) over size (bytes)
+  struct link_statistics {
+    double num_samples = 0.0;
+    double sum_bytes = 0.0;
+    double sum_ns = 0.0;
+    double sum_bytes_squared = 0.0;
+    double sum_bytes_ns = 0.0;
+  };
+
+  struct link_parameters {
+    double latency_ns;
+    double bytes_per_ns;
+  };
+
+  struct tracked_transfer {
+    dag_node_ptr node;
+    const memcpy_operation *op;
+  };
+
+  static link_key make_key(device_id source, device_id dest);
+  link_parameters get_parameters(device_id source, device_id dest) const;
+  void process_tracked_transfers();
+  void add_measurement_impl(const link_key &key, std::size_t num_bytes,
+                            double nanoseconds);
+
+  void load();
+  void store() const;
+
+  backend_manager* _backend_mgr;
+  std::string _persistent_file;
+  bool _calibrate;
+
+  mutable std::mutex _mutex;
+  std::unordered_map<link_key, link_statistics, link_key_hash> _links;
+  // Device pairs for which calibration was attempted in this process
+  std::vector<link_key> _calibrated_links;
+  std::vector<tracked_transfer> _tracked_transfers;
+  bool _is_modified = false;
 };
 
 
@@ -0,0 +1,104 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_RT_JIT_CACHE_ENTRY_HPP
+#define HIPSYCL_RT_JIT_CACHE_ENTRY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "settings.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// A binary stored in, or obtained from, the JIT cache. Depending on how
+/// the binary was obtained, the data is either owned by this object,
+/// or a read-only memory mapping of a persistent cache file.
+class jit_cache_binary {
+public:
+  virtual ~jit_cache_binary() = default;
+  virtual std::string_view get_data() const = 0;
+};
+
+class owned_jit_cache_binary : public jit_cache_binary {
+public:
+  owned_jit_cache_binary() = default;
+  owned_jit_cache_binary(std::string data)
+  : _data{std::move(data)} {}
+
+  virtual std::string_view get_data() const override { return _data; }
+
+  std::string& get_storage() { return _data; }
+private:
+  std::string _data;
+};
+
+/// Persistent JIT cache files begin with a header describing how the payload
+/// is encoded:
+///
+/// magic (8 bytes) | algorithm (u16) | reserved (u16) | reserved (u32) |
+/// uncompressed size (u64) | payload size (u64) | checksum (u64) | payload
+///
+/// All integers are stored in little endian. The checksum is computed
+/// over the uncompressed payload. Files without a valid magic
+/// are treated as raw binaries, as written by older versions.
+struct jit_cache_entry_header {
+  static constexpr std::size_t size = 40;
+  static constexpr char magic[8] = {'A', 'C', 'P', 'P', 'J', 'I', 'T', '1'};
+
+  jit_cache_compression algorithm = jit_cache_compression::none;
+  uint64_t uncompressed_size = 0;
+  uint64_t payload_size = 0;
+  uint64_t checksum = 0;
+};
+
+/// Whether \c algorithm is available in this build of the runtime
+bool is_jit_cache_compression_supported(jit_cache_compression algorithm);
+
+/// Writes \c data to \c filename in the persistent cache format, compressing
+/// it using \c algorithm. If the algorithm is not supported, or compression does
+/// not reduce the size, the data is stored uncompressed.
+/// The file is replaced atomically.
+/// Returns the number of bytes written, or 0 on error.
+std::size_t write_jit_cache_entry(const std::string &filename,
+                                  std::string_view data,
+                                  jit_cache_compression algorithm);
+
+/// Reads a persistent cache file. Uncompressed entries are memory-mapped
+/// and exposed without copying; compressed entries are decompressed
+/// into memory. Returns nullptr if the file does not exist, or is corrupt.
+std::shared_ptr<const jit_cache_binary>
+read_jit_cache_entry(const std::string &filename);
+
+}
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_RT_JIT_CACHE_INDEX_HPP
+#define HIPSYCL_RT_JIT_CACHE_INDEX_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace hipsycl {
+namespace rt {
+
+/// Index of the persistent, on-disk JIT cache. For each cache file,
+/// the index tracks its size, last access time and hit count. This allows
+/// answering cache lookups without touching the file system for each entry,
+/// and evicting least-recently used entries once the cache exceeds its
+/// maximum size.
+///
+/// The index is stored in the cache directory and shared by all processes
+/// using the cache. Modifications are merged with the on-disk state under an
+/// advisory file lock, and the index file is replaced atomically.
+/// The index is only loaded, or created, upon first use, such that
+/// applications that never access the persistent cache do not touch the
+/// cache directory.
+///
+/// This class is thread-safe.
+class jit_cache_index {
+public:
+  struct entry {
+    std::size_t size = 0;
+    uint64_t last_access = 0;
+    uint64_t hit_count = 0;
+  };
+
+  /// \c max_size of 0 means that the cache size is unlimited.
+  jit_cache_index(const std::string &cache_dir, std::size_t max_size);
+  ~jit_cache_index();
+
+  /// Whether the index contains the given cache file (filename relative to
+  /// the cache directory). Reloads the index from disk if another process
+  /// has modified it since it was last loaded. To keep misses cheap, the
+  /// index file is checked for modifications at most once per
+  /// on_disk_check_interval.
+  bool contains(const std::string &filename);
+  /// Records a cache hit. Access statistics are only written
+  /// to disk upon the next insertion or flush().
+  void record_hit(const std::string &filename);
+  /// Adds a new cache file to the index, and evicts least-recently
+  /// used entries if the maximum cache size is exceeded.
+  void insert(const std::string &filename, std::size_t size);
+  /// Removes an entry from the index, e.g. because the file
+  /// turned out to be missing or corrupted.
+  void remove(const std::string &filename);
+  /// Writes pending access statistics to disk.
+  void flush();
+
+  std::size_t get_total_size();
+  std::size_t get_num_entries();
+
+  static constexpr const char* index_filename = "index";
+  static constexpr std::chrono::milliseconds on_disk_check_interval{100};
+private:
+  using entry_map = std::unordered_map<std::string, entry>;
+
+  // These functions must be called while holding _mutex
+  // Loads or creates the index upon first use
+  void ensure_initialized();
+  // Whether the index file has been modified since we last read or
+  // wrote it. Only queries the file system if on_disk_check_interval has
+  // elapsed since the last query.
+  bool is_on_disk_state_modified();
+  bool load_from_disk(entry_map &out);
+  bool store_to_disk(const entry_map &entries) const;
+  void rebuild_from_directory(entry_map &out) const;
+  void evict(entry_map &entries, const std::string& protected_entry) const;
+  // Returns modification time and size of the index file
+  std::pair<int64_t, std::size_t> get_on_disk_state() const;
+  // Merges pending statistics and modifications into the on-disk index
+  // under the cross-process lock, and applies f to the merged entries
+  // before storing them.
+  template<class F>
+  void modify_on_disk_index(F&& f);
+
+  std::string _cache_dir;
+  std::string _index_file;
+  std::string _lock_file;
+  std::size_t _max_size;
+
+  entry_map _entries;
+  // Statistics recorded since the last flush
+  entry_map _pending_hits;
+  // State of the index file when it was last read or written by us
+  std::pair<int64_t, std::size_t> _on_disk_state{-1, 0};
+  std::chrono::steady_clock::time_point _last_on_disk_check;
+  bool _is_initialized = false;
+
+  mutable std::mutex _mutex;
+};
+
+}
+}
+
+#endif
@@ -26,8 +26,13 @@
  */
 
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <future>
 #include <cassert>
 #include <memory>
 #include "hipSYCL/common/hcf_container.hpp"
@@ -35,6 +40,8 @@
 #include "hipSYCL/glue/kernel_configuration.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/jit_cache_entry.hpp"
+#include "hipSYCL/runtime/jit_cache_index.hpp"
 
 #ifndef HIPSYCL_RT_KERNEL_CACHE_HPP
 #define HIPSYCL_RT_KERNEL_CACHE_HPP
@@ -102,7 +109,9 @@ public:
 
   enum argument_type {
     pointer,
-    other
+    other,
+    integer,
+    floating_point
   };
 
   enum annotation_type {
@@ -284,8 +293,10 @@ public:
   /// Should return true if the compilation was successful. The binary output of JIT compilation
   /// should be stored in the string reference.
   /// \c c Is expected to turn the JIT-compiled binary into a code_object*. Has signature
-  /// code_object*(const std::string&). It is expected to return nullptr on error. The JIT-compiled
-  /// binary will be passed in as string reference.
+  /// code_object*(std::string_view) or code_object*(const std::string&). It is expected to
+  /// return nullptr on error. If \c c accepts a std::string_view, binaries loaded from the
+  /// persistent cache are handed over without copying; the view is only valid for the
+  /// duration of the call.
   template <class CodeObjectConstructor, class JitCompiler>
   const code_object *get_or_construct_jit_code_object(code_object_id id_of_code_object,
                                                       code_object_id id_of_binary,
@@ -298,43 +309,199 @@ public:
     }
     HIPSYCL_DEBUG_INFO << "kernel_cache: Cache MISS for id "
                       << glue::kernel_configuration::to_string(id_of_code_object) << "\n";
-    
-    std::string compiled_binary;
-    // TODO: We might want to allow JIT compilation in parallel at some point
-    std::lock_guard<std::mutex> lock{_mutex};
 
-    if(!persistent_cache_lookup(id_of_binary, compiled_binary)){
-      if(!jit_compile(compiled_binary))
-        return nullptr;
-
-      if(_is_first_jit_compilation) {
-        _is_first_jit_compilation = false;
-        HIPSYCL_DEBUG_WARNING
-            << "kernel_cache: This application run has resulted in new "
-               "binaries being JIT-compiled. This indicates that the runtime "
-               "optimization process has not yet reached peak performance. You "
-               "may want to run the application again until this warning no "
-               "longer appears to achieve optimal performance."
-            << std::endl;
+    // JIT compilation happens outside of _mutex, such that JIT requests for
+    // different binaries can be processed in parallel. The first requester of a
+    // binary id carries out the compilation; concurrent requesters of the same
+    // binary id wait for the result of the compilation in flight.
+    binary_future in_flight_binary;
+    std::promise<binary_ptr> binary_promise;
+    bool is_compiling_thread = false;
+    binary_ptr compiled_binary;
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      // Someone else might have constructed the object in the meantime
+      if(auto* code_object = get_code_object_impl(id_of_code_object))
+        return code_object;
+
+      auto it = _in_flight_jit_compilations.find(id_of_binary);
+      auto prefetched = _prefetched_binaries.find(id_of_binary);
+      if(it != _in_flight_jit_compilations.end()) {
+        in_flight_binary = it->second;
+      } else if(prefetched != _prefetched_binaries.end()) {
+        compiled_binary = prefetched->second;
+      } else {
+        in_flight_binary = binary_promise.get_future().share();
+        _in_flight_jit_compilations[id_of_binary] = in_flight_binary;
+        is_compiling_thread = true;
       }
-      persistent_cache_store(id_of_binary, compiled_binary);
     }
-    
-    const code_object* new_object = c(compiled_binary);
+
+    if(compiled_binary) {
+      HIPSYCL_DEBUG_INFO << "kernel_cache: Using prefetched binary "
+                         << glue::kernel_configuration::to_string(id_of_binary)
+                         << std::endl;
+    } else if(is_compiling_thread) {
+      compiled_binary =
+          compile_in_flight_binary(id_of_binary, jit_compile, binary_promise);
+    } else {
+      HIPSYCL_DEBUG_INFO
+          << "kernel_cache: Waiting for JIT compilation in flight for binary "
+          << glue::kernel_configuration::to_string(id_of_binary) << std::endl;
+      compiled_binary = in_flight_binary.get();
+    }
+
+    if(!compiled_binary)
+      return nullptr;
+
+    // Code object construction is typically cheap compared to JIT compilation,
+    // so we can afford to serialize it. This also guarantees that we never
+    // construct the same code object twice.
+    std::lock_guard<std::mutex> lock{_mutex};
+    // A prefetched binary is consumed by the first code object built from it.
+    // It remains in the persistent cache for later requests.
+    _prefetched_binaries.erase(id_of_binary);
+    if(auto* code_object = get_code_object_impl(id_of_code_object))
+      return code_object;
+
+    const code_object* new_object = nullptr;
+    if constexpr(std::is_invocable_v<CodeObjectConstructor, std::string_view>)
+      new_object = c(compiled_binary->get_data());
+    else
+      new_object = c(std::string{compiled_binary->get_data()});
     if(new_object)
       _code_objects[id_of_code_object] = code_object_ptr{new_object};
     
     return new_object;
   }
 
+  /// JIT-compiles a binary ahead of time, such that it is available once
+  /// the code object is needed. Does nothing if the binary is already cached
+  /// or currently being compiled. Concurrent calls to
+  /// get_or_construct_jit_code_object() for the same binary wait for
+  /// the prefetch to finish instead of compiling again.
+  /// \c jit_compile has the same semantics as for
+  /// get_or_construct_jit_code_object().
+  /// Returns false if JIT compilation was attempted and failed.
+  template <class JitCompiler>
+  bool prefetch_jit_binary(code_object_id id_of_binary,
+                           JitCompiler &&jit_compile) {
+    // Binaries in the persistent cache can be loaded cheaply
+    // once they are needed.
+    if(is_in_persistent_cache(id_of_binary))
+      return true;
+
+    std::promise<binary_ptr> binary_promise;
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      if(_in_flight_jit_compilations.count(id_of_binary) ||
+         _prefetched_binaries.count(id_of_binary))
+        return true;
+      _in_flight_jit_compilations[id_of_binary] =
+          binary_promise.get_future().share();
+    }
+
+    binary_ptr binary = compile_in_flight_binary(id_of_binary, jit_compile,
+                                                 binary_promise, true);
+    return binary != nullptr;
+  }
+
   // Unload entire cache and release resources to prepare runtime shutdown.
+  // Increments the epoch, since all code objects are destroyed.
   void unload();
 
+  // Code objects and kernels obtained from them remain valid as long as
+  // the epoch does not change.
+  std::size_t get_epoch() const {
+    return _epoch.load(std::memory_order_acquire);
+  }
+
   // Stitches together the persisten cache path with the id of the binary to a unique path.
   static std::string get_persistent_cache_file(code_object_id id_of_binary);
+
+  // Direct access to the persistent on-disk cache, e.g. for tools
+  // that populate the cache ahead of time.
+  bool is_in_persistent_cache(code_object_id id_of_binary) const;
+  void store_in_persistent_cache(code_object_id id_of_binary,
+                                 std::string_view binary) const;
 private:
-  bool persistent_cache_lookup(code_object_id id_of_binary, std::string& out) const;
-  void persistent_cache_store(code_object_id id_of_binary, const std::string& data) const;
+  using binary_ptr = std::shared_ptr<const jit_cache_binary>;
+  using binary_future = std::shared_future<binary_ptr>;
+
+  // Limits the number of JIT compilations that run concurrently
+  // according to the rt_max_parallel_jit_compilations setting.
+  class jit_slot_guard {
+  public:
+    jit_slot_guard(kernel_cache& cache);
+    ~jit_slot_guard();
+  private:
+    kernel_cache& _cache;
+  };
+
+  // Looks up the binary in the persistent cache, or JIT-compiles
+  // it if it is not present. Returns nullptr on failure.
+  // Must not be called while holding _mutex.
+  template<class JitCompiler>
+  binary_ptr obtain_binary(code_object_id id_of_binary, JitCompiler& jit_compile) {
+    jit_slot_guard slot{*this};
+    if(binary_ptr cached_binary = persistent_cache_lookup(id_of_binary))
+      return cached_binary;
+
+    auto compiled_binary = std::make_shared<owned_jit_cache_binary>();
+    if(!jit_compile(compiled_binary->get_storage()))
+      return nullptr;
+
+    bool expected = true;
+    if(_is_first_jit_compilation.compare_exchange_strong(expected, false)) {
+      HIPSYCL_DEBUG_WARNING
+          << "kernel_cache: This application run has resulted in new "
+             "binaries being JIT-compiled. This indicates that the runtime "
+             "optimization process has not yet reached peak performance. You "
+             "may want to run the application again until this warning no "
+             "longer appears to achieve optimal performance."
+          << std::endl;
+    }
+    persistent_cache_store(id_of_binary, compiled_binary->get_data());
+
+    return compiled_binary;
+  }
+
+  // Obtains the binary on behalf of the thread that has registered the
+  // in-flight compilation of id_of_binary. On every exit path, including
+  // exceptions thrown by jit_compile, the promise is fulfilled and the
+  // in-flight entry is removed. Otherwise, threads waiting for this
+  // compilation would block forever. Waiting threads observe a failed
+  // compilation as nullptr; the exception is rethrown in this thread only.
+  // If is_prefetch is set, a successfully compiled binary is published in
+  // _prefetched_binaries at the same time the in-flight entry is removed.
+  template<class JitCompiler>
+  binary_ptr compile_in_flight_binary(code_object_id id_of_binary,
+                                      JitCompiler &jit_compile,
+                                      std::promise<binary_ptr> &promise,
+                                      bool is_prefetch = false) {
+    binary_ptr binary;
+    try {
+      binary = obtain_binary(id_of_binary, jit_compile);
+    } catch(...) {
+      promise.set_value(nullptr);
+      finish_in_flight_compilation(id_of_binary, nullptr);
+      throw;
+    }
+    promise.set_value(binary);
+    finish_in_flight_compilation(id_of_binary, is_prefetch ? binary : nullptr);
+    return binary;
+  }
+
+  void finish_in_flight_compilation(code_object_id id_of_binary,
+                                    binary_ptr prefetched_binary) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _in_flight_jit_compilations.erase(id_of_binary);
+    if(prefetched_binary)
+      _prefetched_binaries[id_of_binary] = prefetched_binary;
+  }
+
+  binary_ptr persistent_cache_lookup(code_object_id id_of_binary) const;
+  void persistent_cache_store(code_object_id id_of_binary, std::string_view data) const;
   
   const code_object* get_code_object_impl(code_object_id id) const;
 
@@ -361,8 +528,25 @@ private:
 
   std::unordered_map<code_object_id, code_object_ptr, glue::kernel_id_hash>
       _code_objects;
-  
-  bool _is_first_jit_compilation = true;
+  std::unordered_map<code_object_id, binary_future, glue::kernel_id_hash>
+      _in_flight_jit_compilations;
+  // Binaries that have been JIT-compiled ahead of time, but whose
+  // code objects have not yet been constructed
+  std::unordered_map<code_object_id, binary_ptr, glue::kernel_id_hash>
+      _prefetched_binaries;
+
+  std::mutex _jit_slot_mutex;
+  std::condition_variable _jit_slot_available;
+  std::size_t _num_active_jit_compilations = 0;
+
+  std::atomic<bool> _is_first_jit_compilation{true};
+  std::atomic<std::size_t> _epoch{0};
+
+  // Constructed at startup so that the index is preloaded
+  // by the time the first lookup occurs.
+  std::unique_ptr<jit_cache_index> _persistent_cache_index;
+protected:
+  kernel_cache();
 };
 
 namespace detail {
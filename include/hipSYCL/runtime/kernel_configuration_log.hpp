@@ -0,0 +1,165 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_RT_KERNEL_CONFIGURATION_LOG_HPP
+#define HIPSYCL_RT_KERNEL_CONFIGURATION_LOG_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "hipSYCL/glue/kernel_configuration.hpp"
+#include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Everything that is needed to reproduce a JIT compilation
+/// outside of the application run that triggered it.
+struct recorded_kernel_configuration {
+  backend_id backend;
+  hcf_object_id hcf_object;
+  std::string image_name;
+  std::vector<std::string> kernel_names;
+  // The final configuration, as passed to glue::jit::compile().
+  // config.generate_id() is the id of the binary in the persistent cache.
+  glue::kernel_configuration config;
+};
+
+/// Kernel configuration logs are text files with one recorded configuration
+/// per line, such that logs from multiple processes can simply be
+/// concatenated. Lines starting with '#' are comments. Lines that cannot
+/// be parsed are skipped with a warning.
+/// Returns false if the file cannot be opened.
+bool read_kernel_configuration_log(
+    const std::string &filename,
+    std::vector<recorded_kernel_configuration> &out);
+
+/// Appends entries to the log, creating it if it does not exist.
+bool append_to_kernel_configuration_log(
+    const std::string &filename,
+    const std::vector<recorded_kernel_configuration> &entries);
+
+std::string serialize(const recorded_kernel_configuration& entry);
+bool deserialize(const std::string &line, recorded_kernel_configuration &out);
+
+class backend_manager;
+
+/// Appends every kernel configuration that is seen for the first time
+/// to the log given by ACPP_RT_RECORD_KERNEL_CONFIGURATIONS.
+/// Configurations that are already in the log are not recorded again,
+/// so the same log can be reused across many runs.
+class kernel_configuration_recorder {
+public:
+  static kernel_configuration_recorder& get();
+
+  bool is_enabled() const { return _is_enabled; }
+
+  /// \param binary_id The id of the binary, i.e. config.generate_id()
+  /// \param get_image_and_kernel_names Callable with signature
+  /// std::string(std::vector<std::string>&), as used by the
+  /// SSCP submission code paths. Only invoked if the configuration has not
+  /// yet been recorded.
+  template <class ImageAndKernelNamesGetter>
+  void record(backend_id backend, hcf_object_id hcf_object,
+              const glue::kernel_configuration::id_type &binary_id,
+              const glue::kernel_configuration &config,
+              ImageAndKernelNamesGetter &&get_image_and_kernel_names) {
+    if(!_is_enabled)
+      return;
+
+    if(!mark_as_recorded(binary_id))
+      return;
+
+    recorded_kernel_configuration entry;
+    entry.backend = backend;
+    entry.hcf_object = hcf_object;
+    entry.image_name = get_image_and_kernel_names(entry.kernel_names);
+    entry.config = config;
+
+    append(entry);
+  }
+private:
+  kernel_configuration_recorder();
+
+  // Returns false if the binary id has already been recorded.
+  bool mark_as_recorded(const glue::kernel_configuration::id_type &binary_id);
+  void append(const recorded_kernel_configuration &entry);
+
+  bool _is_enabled;
+  std::string _log_file;
+  std::mutex _mutex;
+  std::unordered_set<glue::kernel_configuration::id_type, glue::kernel_id_hash>
+      _recorded_binaries;
+};
+
+/// JIT-compiles all configurations from a kernel configuration log
+/// on a background thread, such that kernels find their binaries
+/// already available when they are first submitted. Entries whose
+/// binaries are already in the persistent kernel cache are skipped.
+/// Entries for backends that have not been created yet due to
+/// ACPP_RT_LAZY_BACKEND_INIT are deferred until the backend is created;
+/// the replayer never causes backend creation itself.
+class kernel_configuration_replayer {
+public:
+  kernel_configuration_replayer(backend_manager &backends,
+                                const std::string &log_file);
+  /// Waits for the entry currently being compiled, if any,
+  /// and skips all remaining entries.
+  ~kernel_configuration_replayer();
+
+private:
+  // Shared with the backend initialization listener, which may outlive
+  // the replayer.
+  struct backend_initialization_state {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t num_initialized_backends = 0;
+    bool stop_requested = false;
+  };
+
+  void replay(std::vector<recorded_kernel_configuration> entries);
+  // Returns true if the entry has been compiled successfully.
+  bool replay_entry(const backend *b,
+                    const recorded_kernel_configuration &entry);
+
+  backend_manager *_backends;
+  std::atomic<bool> _stop_requested;
+  std::shared_ptr<backend_initialization_state> _initialization_state;
+  std::thread _worker;
+};
+
+}
+}
+
+#endif
@@ -38,15 +38,16 @@ class musa_allocator : public backend_allocator
 public:
   musa_allocator(backend_descriptor desc, int musa_device);
 
-  virtual void* allocate(size_t min_alignment, size_t size_bytes) override;
+  virtual void* raw_allocate(size_t min_alignment, size_t size_bytes) override;
 
-  virtual void *allocate_optimized_host(size_t min_alignment,
-                                        size_t bytes) override;
+  virtual void *raw_allocate_optimized_host(size_t min_alignment,
+                                            size_t bytes) override;
   
-  virtual void free(void *mem) override;
+  virtual void raw_free(void *mem) override;
 
-  virtual void *allocate_usm(size_t bytes) override;
+  virtual void *raw_allocate_usm(size_t bytes) override;
   virtual bool is_usm_accessible_from(backend_descriptor b) const override;
+  virtual device_id get_device() const override;
 
   virtual result query_pointer(const void* ptr, pointer_info& out) const override;
 
@@ -29,11 +29,14 @@
 #ifndef HIPSYCL_OCL_HARDWARE_MANAGER_HPP
 #define HIPSYCL_OCL_HARDWARE_MANAGER_HPP
 
+#include <array>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include <CL/opencl.hpp>
 
+#include "../error.hpp"
 #include "../hardware.hpp"
 #include "ocl_allocator.hpp"
 #include "ocl_usm.hpp"
@@ -84,6 +87,13 @@ public:
   cl::Context get_cl_context() const;
 
   void init_allocator(ocl_hardware_manager* mgr);
+
+  /// Obtains the built-in kernel for strided copies of elements of
+  /// element_size bytes, which must be 1, 2, 4, 8 or 16. The built-in
+  /// kernels are compiled from OpenCL C on first use and do not
+  /// rely on the SSCP compiler.
+  result get_strided_memcpy_kernel(std::size_t element_size,
+                                   cl::Kernel &out);
 private:
   int _dev_id;
   int _platform_id;
@@ -91,6 +101,15 @@ private:
   cl::Device _dev;
   std::shared_ptr<ocl_usm> _usm_provider;
   ocl_allocator _alloc;
+
+  struct builtin_kernels {
+    std::once_flag build_flag;
+    result build_result;
+    std::array<cl::Kernel, 5> strided_memcpy;
+  };
+  // Shared between copies of the same hardware context
+  std::shared_ptr<builtin_kernels> _builtin_kernels =
+      std::make_shared<builtin_kernels>();
 };
 
 class ocl_hardware_manager : public backend_hardware_manager
@@ -36,6 +36,8 @@
 
 #include "hipSYCL/runtime/event.hpp"
 #include "hipSYCL/runtime/generic/async_worker.hpp"
+#include "hipSYCL/runtime/generic/host_timestamped_event.hpp"
+#include "hipSYCL/runtime/generic/strided_memcpy.hpp"
 #include "hipSYCL/runtime/ocl/ocl_code_object.hpp"
 
 namespace hipsycl {
@@ -84,9 +86,21 @@ public:
       std::size_t *arg_sizes, std::size_t num_args,
       const glue::kernel_configuration &config);
 
+  /// Returns the reference event for profiling timestamps, or nullptr if
+  /// it could not be created. It is created on first use, so queues without
+  /// instrumented operations never need to synchronize with the device for it.
+  const host_timestamped_event* get_timing_reference();
+
+  /// Whether the queue records profiling information, which is required
+  /// for execution timestamps. See ACPP_RT_OCL_ENABLE_PROFILING.
+  bool is_profiling_enabled() const;
 private:
   void register_submitted_op(cl::Event);
 
+  result submit_strided_memcpy_kernel(const strided_memcpy_layout &layout,
+                                      void *dest, const void *src,
+                                      cl::Event *evt_out);
+
   // These member variables have to be thread-safe.
   ocl_hardware_manager* _hw_manager;
   const std::size_t _device_index;
@@ -97,6 +111,11 @@ private:
 
   std::shared_ptr<kernel_cache> _kernel_cache;
 
+  bool _is_profiling_enabled = false;
+  host_timestamped_event _reference_event;
+  bool _is_reference_event_valid = false;
+  std::once_flag _reference_event_init;
+
   // Non-thread safe state should go here
   struct protected_state {
   public:
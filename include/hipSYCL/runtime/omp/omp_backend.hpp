@@ -33,9 +33,12 @@
 #include "omp_allocator.hpp"
 #include "omp_hardware_manager.hpp"
 
+#include <memory>
+
 namespace hipsycl {
 namespace rt {
 
+class omp_thread_pool;
 
 class omp_backend : public backend
 {
@@ -52,13 +55,21 @@ public:
 
   virtual std::string get_name() const override;
   
-  virtual ~omp_backend(){}
+  virtual ~omp_backend();
 
   std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) override;
+
+  virtual result jit_compile_recorded_configuration(
+      const common::hcf_container *hcf,
+      const recorded_kernel_configuration &entry,
+      std::string &binary_out) const override;
 private:
   mutable omp_allocator _allocator;
   mutable omp_hardware_manager _hw;
+  // Only exists if the thread pool has been enabled; must outlive
+  // all queues.
+  std::unique_ptr<omp_thread_pool> _thread_pool;
   mutable lazily_constructed_executor<multi_queue_executor> _executor;
 };
 
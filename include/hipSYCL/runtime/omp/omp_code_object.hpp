@@ -28,7 +28,9 @@
 #ifndef HIPSYCL_OMP_CODE_OBJECT_HPP
 #define HIPSYCL_OMP_CODE_OBJECT_HPP
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "hipSYCL/glue/kernel_configuration.hpp"
@@ -39,6 +41,10 @@
 
 
 namespace hipsycl {
+namespace compiler {
+class HostJITLinker;
+}
+
 namespace rt {
 
 class omp_sscp_executable_object : public code_object {
@@ -57,8 +63,16 @@ public:
   };
 
   using omp_sscp_kernel = void(const work_group_info *, void **);
-
-  omp_sscp_executable_object(const std::string &shared_lib_path,
+  // Executes all work groups with linear ids (x fastest) in
+  // [first_group, end_group). The group id in the work group info is ignored.
+  using omp_sscp_group_range_kernel = void(const work_group_info *, void **,
+                                           std::size_t first_group,
+                                           std::size_t end_group);
+
+  /// \c binary may either be a shared library, or a relocatable object
+  /// file as produced by the in-process host code generation. The latter
+  /// is linked directly into executable memory.
+  omp_sscp_executable_object(std::string_view binary,
                              hcf_object_id hcf_source,
                              const std::vector<std::string> &kernel_names,
                              const glue::kernel_configuration &config);
@@ -80,9 +94,13 @@ public:
 
   virtual void *get_module() const;
   virtual omp_sscp_kernel *get_kernel(const std::string& backend_kernel_name) const;
+  // Returns nullptr if the binary does not provide a group range entry point
+  virtual omp_sscp_group_range_kernel *
+  get_group_range_kernel(const std::string &backend_kernel_name) const;
 
 private:
-  result build(const std::string &source, const std::vector<std::string> &kernel_names);
+  result build(std::string_view source, const std::vector<std::string> &kernel_names);
+  void *get_symbol(const std::string &name) const;
 
   hcf_object_id _hcf;
   glue::kernel_configuration::id_type _id;
@@ -90,7 +108,12 @@ private:
 
   result _build_result;
   void *_module;
+  // Only used if the binary was linked in-process; _module then
+  // points to this object.
+  std::unique_ptr<compiler::HostJITLinker> _jit_module;
   std::unordered_map<std::string, omp_sscp_kernel*> _kernels;
+  std::unordered_map<std::string, omp_sscp_group_range_kernel *>
+      _group_range_kernels;
 };
 
 } // namespace rt
@@ -33,6 +33,11 @@
 namespace hipsycl {
 namespace rt {
 
+/// \return The sub-group size of SSCP kernels on the host, as configured
+/// by ACPP_RT_OMP_SSCP_SUB_GROUP_SIZE. A setting of 0 is resolved to the
+/// native SIMD width of the CPU for 32-bit elements.
+std::size_t get_omp_sscp_sub_group_size();
+
 class omp_hardware_context : public hardware_context
 {
 public:
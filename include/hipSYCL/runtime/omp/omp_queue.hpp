@@ -37,6 +37,7 @@ namespace hipsycl {
 namespace rt {
 
 class omp_queue;
+class omp_thread_pool;
 
 class omp_sscp_code_object_invoker : public sscp_code_object_invoker {
 public:
@@ -53,6 +54,12 @@ public:
                                std::size_t *arg_sizes, std::size_t num_args,
                                const std::string &kernel_name,
                                const glue::kernel_configuration& config) override;
+
+  virtual result submit_kernel_from_launch_site(
+      const kernel_operation &op, sscp_launch_site &site,
+      const rt::range<3> &num_groups, const rt::range<3> &group_size,
+      unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+      std::size_t num_args, const glue::kernel_configuration &config) override;
   
   virtual rt::range<3> select_group_size(const rt::range<3> &num_groups,
                                          const rt::range<3> &group_size) const override;
@@ -64,7 +71,9 @@ private:
 class omp_queue : public inorder_queue
 {
 public:
-  omp_queue(backend_id id);
+  /// \param pool If not null, SSCP kernels are executed on this thread pool
+  /// instead of in an OpenMP parallel region.
+  omp_queue(backend_id id, omp_thread_pool *pool = nullptr);
   virtual ~omp_queue();
 
   /// Inserts an event into the stream
@@ -93,7 +102,8 @@ public:
       const std::string &kernel_name, const rt::range<3> &num_groups,
       const rt::range<3> &group_size, unsigned local_mem_size, void **args,
       std::size_t *arg_sizes, std::size_t num_args,
-      const glue::kernel_configuration &config);
+      const glue::kernel_configuration &config,
+      sscp_launch_site *launch_site = nullptr);
 
   worker_thread& get_worker();
 private:
@@ -102,6 +112,7 @@ private:
 
   omp_sscp_code_object_invoker _sscp_code_object_invoker;
   std::shared_ptr<kernel_cache> _kernel_cache;
+  omp_thread_pool *_thread_pool;
 };
 
 }
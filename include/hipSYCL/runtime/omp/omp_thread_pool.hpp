@@ -0,0 +1,125 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HIPSYCL_OMP_THREAD_POOL_HPP
+#define HIPSYCL_OMP_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+/// Persistent thread pool that the omp backend can use instead of OpenMP
+/// to execute the work groups of a kernel.
+///
+/// Work items of a parallel_for() are split into chunks. Every participating
+/// thread initially owns a contiguous range of chunks and processes them
+/// from the front; threads that run out of work steal half of the remaining
+/// range of another thread from the back. This keeps scheduling overhead
+/// low for uniform kernels while balancing kernels whose work groups have
+/// highly irregular runtimes.
+///
+/// Each participant owns a page-aligned local memory arena that is only
+/// ever grown, so that repeated kernel launches do not reallocate it.
+/// The thread calling parallel_for() participates as worker 0.
+class omp_thread_pool
+{
+public:
+  /// \param num_threads The number of participating threads, including
+  /// the thread that calls parallel_for(). If 0, the OpenMP default
+  /// number of threads (or the hardware concurrency) is used.
+  explicit omp_thread_pool(std::size_t num_threads = 0);
+  ~omp_thread_pool();
+
+  omp_thread_pool(const omp_thread_pool&) = delete;
+  omp_thread_pool& operator=(const omp_thread_pool&) = delete;
+
+  /// Invoked with a half-open range [begin, end) of work items and a
+  /// pointer to the local memory arena of the executing thread.
+  using chunk_function =
+      std::function<void(std::size_t begin, std::size_t end,
+                         void *local_memory)>;
+
+  /// Executes f on all work items in [0, num_items) and returns once all
+  /// of them have completed. Concurrent calls are serialized.
+  /// \param local_memory_size The minimum size in bytes of the
+  /// local memory arena that is passed to f.
+  void parallel_for(std::size_t num_items, std::size_t local_memory_size,
+                    const chunk_function &f);
+
+  std::size_t get_num_threads() const { return _workers.size(); }
+private:
+  struct job {
+    std::size_t num_items;
+    std::size_t chunk_size;
+    const chunk_function *f;
+  };
+
+  struct alignas(64) worker {
+    // Packed [begin, end) range of chunks that have not yet been started,
+    // begin in the upper, end in the lower 32 bits.
+    std::atomic<std::uint64_t> chunks{0};
+
+    std::vector<char> local_memory;
+    void *aligned_local_memory = nullptr;
+    std::size_t local_memory_capacity = 0;
+  };
+
+  void start_threads();
+  void thread_main(std::size_t worker_id);
+  void run_job(std::size_t worker_id);
+  bool pop_chunk(worker &w, std::uint32_t &chunk);
+  bool steal_chunks(std::size_t thief_id);
+  void reserve_local_memory(worker &w, std::size_t size);
+
+  std::vector<std::unique_ptr<worker>> _workers;
+  std::vector<std::thread> _threads;
+  std::size_t _page_size;
+
+  // Serializes concurrent parallel_for() calls
+  std::mutex _submission_mutex;
+
+  job _job;
+  std::atomic<std::uint64_t> _generation;
+  std::atomic<std::size_t> _num_busy_threads;
+  std::atomic<bool> _shutdown;
+
+  std::mutex _wakeup_mutex;
+  std::condition_variable _wakeup;
+};
+
+}
+}
+
+#endif
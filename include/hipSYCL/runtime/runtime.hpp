@@ -32,6 +32,7 @@
 #include "dag_manager.hpp"
 #include "backend.hpp"
 #include "settings.hpp"
+#include "kernel_configuration_log.hpp"
 
 #include <memory>
 #include <iostream>
@@ -62,6 +63,9 @@ private:
   // when the dag_manager is destructed!
   backend_manager _backends;
   dag_manager _dag_manager;
+  // Must be destroyed before the backends, as it may be
+  // JIT-compiling using them in the background.
+  std::unique_ptr<kernel_configuration_replayer> _replayer;
 };
 
 
@@ -34,6 +34,7 @@
 #include <optional>
 #include <string>
 #include <cstdlib>
+#include <cstdint>
 #include <algorithm>
 #include <sstream>
 #include <iostream>
@@ -41,8 +42,10 @@
 namespace hipsycl {
 namespace rt {
 
-enum class scheduler_type { direct, unbound };
+enum class scheduler_type { direct, unbound, load_aware };
 enum class default_selector_behavior { strict, multigpu, system };
+// Values are stored in persistent JIT cache files and must remain stable
+enum class jit_cache_compression : uint16_t { none = 0, zlib = 1 };
 
 struct device_visibility_condition{
   int device_index_equality = -1;
@@ -69,6 +72,7 @@ bool has_device_visibility_mask(const visibility_mask_t& mask, backend_id backen
 std::istream &operator>>(std::istream &istr, scheduler_type &out);
 std::istream &operator>>(std::istream &istr, visibility_mask_t &out);
 std::istream &operator>>(std::istream &istr, default_selector_behavior& out);
+std::istream &operator>>(std::istream &istr, jit_cache_compression& out);
 
 template <class T>
 bool try_get_environment_variable(const std::string& name, T& out) {
@@ -120,8 +124,22 @@ enum class setting {
   gc_trigger_batch_size,
   ocl_no_shared_context,
   ocl_show_all_devices,
+  ocl_enable_profiling,
   no_jit_cache_population,
   adaptivity_level,
+  max_parallel_jit_compilations,
+  omp_out_of_process_codegen,
+  jit_cache_max_size,
+  jit_cache_compression,
+  record_kernel_configurations,
+  replay_kernel_configurations,
+  argument_specialization_threshold,
+  memcpy_model_calibration,
+  memcpy_model_online_measurement,
+  omp_thread_pool,
+  omp_sscp_sub_group_size,
+  parallel_backend_init,
+  lazy_backend_init,
 };
 
 template <setting S> struct setting_trait {};
@@ -153,8 +171,34 @@ HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::sscp_failed_ir_dump_directory,
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::gc_trigger_batch_size, "rt_gc_trigger_batch_size", std::size_t)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ocl_no_shared_context, "rt_ocl_no_shared_context", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ocl_show_all_devices, "rt_ocl_show_all_devices", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ocl_enable_profiling, "rt_ocl_enable_profiling", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::no_jit_cache_population, "rt_no_jit_cache_population", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::adaptivity_level, "adaptivity_level", int)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::max_parallel_jit_compilations,
+                              "rt_max_parallel_jit_compilations", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_out_of_process_codegen,
+                              "rt_omp_out_of_process_codegen", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jit_cache_max_size, "jit_cache_max_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jit_cache_compression,
+                              "jit_cache_compression", jit_cache_compression)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::record_kernel_configurations,
+                              "rt_record_kernel_configurations", std::string)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::replay_kernel_configurations,
+                              "rt_replay_kernel_configurations", std::string)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::argument_specialization_threshold,
+                              "rt_argument_specialization_threshold", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::memcpy_model_calibration,
+                              "rt_memcpy_model_calibration", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::memcpy_model_online_measurement,
+                              "rt_memcpy_model_online_measurement", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_thread_pool,
+                              "rt_omp_thread_pool", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_sscp_sub_group_size,
+                              "rt_omp_sscp_sub_group_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::parallel_backend_init,
+                              "rt_parallel_backend_init", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::lazy_backend_init,
+                              "rt_lazy_backend_init", bool)
 
 class settings
 {
@@ -189,10 +233,38 @@ public:
       return _ocl_no_shared_context;
     } else if constexpr(S == setting::ocl_show_all_devices) {
       return _ocl_show_all_devices;
+    } else if constexpr(S == setting::ocl_enable_profiling) {
+      return _ocl_enable_profiling;
     } else if constexpr(S == setting::no_jit_cache_population) {
       return _no_jit_cache_population;
     } else if constexpr(S == setting::adaptivity_level) {
       return _adaptivity_level;
+    } else if constexpr(S == setting::max_parallel_jit_compilations) {
+      return _max_parallel_jit_compilations;
+    } else if constexpr(S == setting::omp_out_of_process_codegen) {
+      return _omp_out_of_process_codegen;
+    } else if constexpr(S == setting::jit_cache_max_size) {
+      return _jit_cache_max_size;
+    } else if constexpr(S == setting::jit_cache_compression) {
+      return _jit_cache_compression;
+    } else if constexpr(S == setting::record_kernel_configurations) {
+      return _record_kernel_configurations;
+    } else if constexpr(S == setting::replay_kernel_configurations) {
+      return _replay_kernel_configurations;
+    } else if constexpr(S == setting::argument_specialization_threshold) {
+      return _argument_specialization_threshold;
+    } else if constexpr(S == setting::memcpy_model_calibration) {
+      return _memcpy_model_calibration;
+    } else if constexpr(S == setting::memcpy_model_online_measurement) {
+      return _memcpy_model_online_measurement;
+    } else if constexpr(S == setting::omp_thread_pool) {
+      return _omp_thread_pool;
+    } else if constexpr(S == setting::omp_sscp_sub_group_size) {
+      return _omp_sscp_sub_group_size;
+    } else if constexpr(S == setting::parallel_backend_init) {
+      return _parallel_backend_init;
+    } else if constexpr(S == setting::lazy_backend_init) {
+      return _lazy_backend_init;
     }
     return typename setting_trait<S>::type{};
   }
@@ -234,10 +306,39 @@ public:
         get_environment_variable_or_default<setting::ocl_no_shared_context>(false);
     _ocl_show_all_devices =
         get_environment_variable_or_default<setting::ocl_show_all_devices>(false);
+    _ocl_enable_profiling =
+        get_environment_variable_or_default<setting::ocl_enable_profiling>(false);
     _no_jit_cache_population =
         get_environment_variable_or_default<setting::no_jit_cache_population>(false);
     _adaptivity_level =
         get_environment_variable_or_default<setting::adaptivity_level>(1);
+    _max_parallel_jit_compilations = get_environment_variable_or_default<
+        setting::max_parallel_jit_compilations>(0);
+    _omp_out_of_process_codegen = get_environment_variable_or_default<
+        setting::omp_out_of_process_codegen>(false);
+    _jit_cache_max_size =
+        get_environment_variable_or_default<setting::jit_cache_max_size>(0);
+    _jit_cache_compression =
+        get_environment_variable_or_default<setting::jit_cache_compression>(
+            jit_cache_compression::none);
+    _record_kernel_configurations = get_environment_variable_or_default<
+        setting::record_kernel_configurations>(std::string{});
+    _replay_kernel_configurations = get_environment_variable_or_default<
+        setting::replay_kernel_configurations>(std::string{});
+    _argument_specialization_threshold = get_environment_variable_or_default<
+        setting::argument_specialization_threshold>(8);
+    _memcpy_model_calibration = get_environment_variable_or_default<
+        setting::memcpy_model_calibration>(false);
+    _memcpy_model_online_measurement = get_environment_variable_or_default<
+        setting::memcpy_model_online_measurement>(false);
+    _omp_thread_pool =
+        get_environment_variable_or_default<setting::omp_thread_pool>(false);
+    _omp_sscp_sub_group_size = get_environment_variable_or_default<
+        setting::omp_sscp_sub_group_size>(1);
+    _parallel_backend_init = get_environment_variable_or_default<
+        setting::parallel_backend_init>(true);
+    _lazy_backend_init =
+        get_environment_variable_or_default<setting::lazy_backend_init>(false);
   }
 
 private:
@@ -264,8 +365,22 @@ private:
   visibility_mask_t _visibility_mask;
   bool _ocl_no_shared_context;
   bool _ocl_show_all_devices;
+  bool _ocl_enable_profiling;
   bool _no_jit_cache_population;
   int _adaptivity_level;
+  std::size_t _max_parallel_jit_compilations;
+  bool _omp_out_of_process_codegen;
+  std::size_t _jit_cache_max_size;
+  jit_cache_compression _jit_cache_compression;
+  std::string _record_kernel_configurations;
+  std::string _replay_kernel_configurations;
+  std::size_t _argument_specialization_threshold;
+  bool _memcpy_model_calibration;
+  bool _memcpy_model_online_measurement;
+  bool _omp_thread_pool;
+  std::size_t _omp_sscp_sub_group_size;
+  bool _parallel_backend_init;
+  bool _lazy_backend_init;
 };
 
 }
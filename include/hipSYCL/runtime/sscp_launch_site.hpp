@@ -0,0 +1,144 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_SSCP_LAUNCH_SITE_HPP
+#define HIPSYCL_SSCP_LAUNCH_SITE_HPP
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "hipSYCL/glue/kernel_configuration.hpp"
+#include "device_id.hpp"
+#include "kernel_cache.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Launch state of a single SSCP kernel that is kept across launches.
+/// The kernel launcher creates one launch site per kernel with static
+/// storage duration, which allows backends to remember everything they
+/// have resolved for a launch (kernel info, code object, kernel entry
+/// points, argument mapping) and to skip the lookups in hcf_cache and
+/// kernel_cache when the kernel is launched again with the same
+/// configuration.
+///
+/// Entries are immutable once published and remain alive for the
+/// lifetime of the launch site, even when they are replaced, so lookups
+/// do not take any locks.
+class sscp_launch_site {
+public:
+  using fingerprint_type = glue::kernel_configuration::id_type;
+
+  /// Base class for the backend-specific information stored in the site.
+  /// An entry is only valid for the device and configuration fingerprint
+  /// it was published for, and only as long as the kernel_cache epoch has
+  /// not changed since, because unloading the kernel_cache destroys the
+  /// code objects the entry refers to.
+  class entry {
+  public:
+    entry(const device_id &dev, const fingerprint_type &fingerprint,
+          std::size_t kernel_cache_epoch)
+        : _dev{dev}, _fingerprint{fingerprint},
+          _kernel_cache_epoch{kernel_cache_epoch} {}
+    virtual ~entry() = default;
+
+    bool matches(const device_id &dev,
+                 const fingerprint_type &fingerprint) const {
+      return _fingerprint == fingerprint && _dev == dev;
+    }
+
+    bool is_valid(std::size_t kernel_cache_epoch) const {
+      return _kernel_cache_epoch == kernel_cache_epoch;
+    }
+
+    std::size_t get_kernel_cache_epoch() const { return _kernel_cache_epoch; }
+  private:
+    device_id _dev;
+    fingerprint_type _fingerprint;
+    std::size_t _kernel_cache_epoch;
+  };
+
+  sscp_launch_site(hcf_object_id hcf_object, const std::string &kernel_name);
+
+  hcf_object_id get_hcf_object() const { return _hcf_object; }
+  const std::string &get_kernel_name() const { return _kernel_name; }
+
+  /// Returns the kernel info from the hcf_cache, or nullptr if the kernel
+  /// is unknown. Only the first successful call accesses the hcf_cache.
+  const hcf_kernel_info *get_kernel_info();
+
+  /// Returns the entry that was published for the device and fingerprint,
+  /// or nullptr if there is none or if it was published in a different
+  /// kernel_cache epoch. \c Entry must be the type that the backend of
+  /// \c dev uses for its entries.
+  template <class Entry>
+  const Entry *find(const device_id &dev, const fingerprint_type &fingerprint,
+                    std::size_t kernel_cache_epoch) const {
+    for (const auto &slot : _slots) {
+      const entry *e = slot.load(std::memory_order_acquire);
+      // Slots are filled in order, so there are no entries beyond
+      // the first empty slot.
+      if (!e)
+        return nullptr;
+      if (e->matches(dev, fingerprint))
+        return e->is_valid(kernel_cache_epoch)
+                   ? static_cast<const Entry *>(e)
+                   : nullptr;
+    }
+    return nullptr;
+  }
+
+  /// Makes the entry available to subsequent find() calls. An entry for
+  /// the same device and fingerprint from an earlier kernel_cache epoch is
+  /// replaced. If a valid entry exists already, or if the maximum number
+  /// of entries has been reached, the entry is discarded.
+  void publish(const device_id &dev, const fingerprint_type &fingerprint,
+               std::unique_ptr<entry> e);
+
+private:
+  // Kernels that are launched with many different configurations
+  // fall back to the regular lookups beyond this number of entries.
+  static constexpr std::size_t max_entries = 8;
+
+  hcf_object_id _hcf_object;
+  std::string _kernel_name;
+
+  std::atomic<const hcf_kernel_info *> _kernel_info;
+  std::array<std::atomic<const entry *>, max_entries> _slots;
+
+  std::mutex _mutex;
+  std::vector<std::unique_ptr<entry>> _entries;
+};
+
+}
+}
+
+#endif
@@ -39,17 +39,19 @@ namespace rt {
 class ze_allocator : public backend_allocator 
 {
 public:
-  ze_allocator(const ze_hardware_context* dev, const ze_hardware_manager* hw_manager);
+  ze_allocator(const ze_hardware_context *dev,
+               const ze_hardware_manager *hw_manager, device_id dev_id);
 
-  virtual void* allocate(size_t min_alignment, size_t size_bytes) override;
+  virtual void* raw_allocate(size_t min_alignment, size_t size_bytes) override;
 
-  virtual void *allocate_optimized_host(size_t min_alignment,
-                                        size_t bytes) override;
+  virtual void *raw_allocate_optimized_host(size_t min_alignment,
+                                            size_t bytes) override;
   
-  virtual void free(void *mem) override;
+  virtual void raw_free(void *mem) override;
 
-  virtual void *allocate_usm(size_t bytes) override;
+  virtual void *raw_allocate_usm(size_t bytes) override;
   virtual bool is_usm_accessible_from(backend_descriptor b) const override;
+  virtual device_id get_device() const override;
 
   virtual result query_pointer(const void* ptr, pointer_info& out) const override;
 
@@ -61,6 +63,7 @@ private:
   uint32_t _global_mem_ordinal;
 
   const ze_hardware_manager* _hw_manager;
+  device_id _dev_id;
 };
 
 }
@@ -60,6 +60,11 @@ public:
   std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) override;
 
+  virtual result jit_compile_recorded_configuration(
+      const common::hcf_container *hcf,
+      const recorded_kernel_configuration &entry,
+      std::string &binary_out) const override;
+
   virtual ~ze_backend(){}
 
 private:
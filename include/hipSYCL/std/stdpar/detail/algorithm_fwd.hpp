@@ -140,6 +140,24 @@ HIPSYCL_STDPAR_ENTRYPOINT
 bool none_of(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
             UnaryPredicate p );
 
+
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par_unseq, RandomIt first,
+                                    RandomIt last);
+
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par_unseq, RandomIt first,
+                                    RandomIt last, Compare comp);
+
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par_unseq,
+                                           RandomIt first, RandomIt last);
+
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par_unseq,
+                                           RandomIt first, RandomIt last,
+                                           Compare comp);
+
 }
 
 #endif
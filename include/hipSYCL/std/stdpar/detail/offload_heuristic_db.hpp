@@ -67,9 +67,15 @@ struct find_if_not {};
 struct all_of {};
 struct any_of {};
 struct none_of {};
+struct sort {};
+struct stable_sort {};
 
 struct transform_reduce {};
 struct reduce {};
+struct inclusive_scan {};
+struct exclusive_scan {};
+struct transform_inclusive_scan {};
+struct transform_exclusive_scan {};
 } // namespace algorithm_type
 
 
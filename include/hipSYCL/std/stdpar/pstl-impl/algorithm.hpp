@@ -464,6 +464,97 @@ bool none_of(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
                                   HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
 }
 
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par_unseq, RandomIt first,
+                                    RandomIt last) {
+  auto offloader = [&](auto& queue) {
+    // Note: The scratch allocation_group expires at the end of this scope
+    // while the kernels might still be running. This is safe because we have
+    // one allocation cache per thread-local in-order queue, so subsequent
+    // operations that are fed from the same cache are ordered after the sort.
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::sort(queue, sort_scratch_group, first, last);
+  };
+
+  auto fallback = [&]() {
+    std::sort(hipsycl::stdpar::par_unseq_host_fallback, first, last);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(hipsycl::stdpar::algorithm_type::sort{},
+                               std::distance(first, last), offloader, fallback,
+                               first,
+                               HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par_unseq, RandomIt first,
+                                    RandomIt last, Compare comp) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::sort(queue, sort_scratch_group, first, last, comp);
+  };
+
+  auto fallback = [&]() {
+    std::sort(hipsycl::stdpar::par_unseq_host_fallback, first, last, comp);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(hipsycl::stdpar::algorithm_type::sort{},
+                               std::distance(first, last), offloader, fallback,
+                               first,
+                               HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par_unseq,
+                                           RandomIt first, RandomIt last) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::stable_sort(queue, sort_scratch_group, first, last);
+  };
+
+  auto fallback = [&]() {
+    std::stable_sort(hipsycl::stdpar::par_unseq_host_fallback, first, last);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(hipsycl::stdpar::algorithm_type::stable_sort{},
+                               std::distance(first, last), offloader, fallback,
+                               first,
+                               HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par_unseq,
+                                           RandomIt first, RandomIt last,
+                                           Compare comp) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::stable_sort(queue, sort_scratch_group, first, last,
+                                     comp);
+  };
+
+  auto fallback = [&]() {
+    std::stable_sort(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                     comp);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(hipsycl::stdpar::algorithm_type::stable_sort{},
+                               std::distance(first, last), offloader, fallback,
+                               first,
+                               HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
 }
 
 #endif
@@ -296,6 +296,259 @@ T reduce(hipsycl::stdpar::par_unseq, ForwardIt first,
       binary_op);
 }
 
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 inclusive_scan(hipsycl::stdpar::par_unseq, ForwardIt1 first,
+                          ForwardIt1 last, ForwardIt2 d_first) {
+  auto offloader = [&](auto& queue) {
+    // Note: The scratch allocation_group expires at the end of this scope
+    // while the kernels might still be running. This is safe because we have
+    // one allocation cache per thread-local in-order queue, so subsequent
+    // operations that are fed from the same cache are ordered after the scan.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::inclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::inclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first,
+                               last, d_first);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(hipsycl::stdpar::algorithm_type::inclusive_scan{},
+                         std::distance(first, last), ForwardIt2, offloader,
+                         fallback, first,
+                         HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 inclusive_scan(hipsycl::stdpar::par_unseq, ForwardIt1 first,
+                          ForwardIt1 last, ForwardIt2 d_first,
+                          BinaryOp binary_op) {
+  auto offloader = [&](auto& queue) {
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::inclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, binary_op);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::inclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first,
+                               last, d_first, binary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(hipsycl::stdpar::algorithm_type::inclusive_scan{},
+                         std::distance(first, last), ForwardIt2, offloader,
+                         fallback, first,
+                         HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first,
+                         binary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp, class T>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 inclusive_scan(hipsycl::stdpar::par_unseq, ForwardIt1 first,
+                          ForwardIt1 last, ForwardIt2 d_first,
+                          BinaryOp binary_op, T init) {
+  auto offloader = [&](auto& queue) {
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::inclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, binary_op, init);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::inclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first,
+                               last, d_first, binary_op, init);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(hipsycl::stdpar::algorithm_type::inclusive_scan{},
+                         std::distance(first, last), ForwardIt2, offloader,
+                         fallback, first,
+                         HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first,
+                         binary_op, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 exclusive_scan(hipsycl::stdpar::par_unseq, ForwardIt1 first,
+                          ForwardIt1 last, ForwardIt2 d_first, T init) {
+  auto offloader = [&](auto& queue) {
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::exclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, init);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::exclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first,
+                               last, d_first, init);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(hipsycl::stdpar::algorithm_type::exclusive_scan{},
+                         std::distance(first, last), ForwardIt2, offloader,
+                         fallback, first,
+                         HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 exclusive_scan(hipsycl::stdpar::par_unseq, ForwardIt1 first,
+                          ForwardIt1 last, ForwardIt2 d_first, T init,
+                          BinaryOp binary_op) {
+  auto offloader = [&](auto& queue) {
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::exclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, init, binary_op);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::exclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first,
+                               last, d_first, init, binary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(hipsycl::stdpar::algorithm_type::exclusive_scan{},
+                         std::distance(first, last), ForwardIt2, offloader,
+                         fallback, first,
+                         HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, init,
+                         binary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryTransformOp>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 transform_inclusive_scan(hipsycl::stdpar::par_unseq,
+                                    ForwardIt1 first, ForwardIt1 last,
+                                    ForwardIt2 d_first, BinaryOp binary_op,
+                                    UnaryTransformOp unary_op) {
+  auto offloader = [&](auto& queue) {
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::transform_inclusive_scan(queue, scan_scratch_group,
+                                                  first, last, d_first,
+                                                  binary_op, unary_op);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform_inclusive_scan(hipsycl::stdpar::par_unseq_host_fallback,
+                                         first, last, d_first, binary_op,
+                                         unary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(hipsycl::stdpar::algorithm_type::transform_inclusive_scan{},
+                         std::distance(first, last), ForwardIt2, offloader,
+                         fallback, first,
+                         HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first,
+                         binary_op, unary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryTransformOp, class T>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 transform_inclusive_scan(hipsycl::stdpar::par_unseq,
+                                    ForwardIt1 first, ForwardIt1 last,
+                                    ForwardIt2 d_first, BinaryOp binary_op,
+                                    UnaryTransformOp unary_op, T init) {
+  auto offloader = [&](auto& queue) {
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::transform_inclusive_scan(queue, scan_scratch_group,
+                                                  first, last, d_first,
+                                                  binary_op, unary_op, init);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform_inclusive_scan(hipsycl::stdpar::par_unseq_host_fallback,
+                                         first, last, d_first, binary_op,
+                                         unary_op, init);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(hipsycl::stdpar::algorithm_type::transform_inclusive_scan{},
+                         std::distance(first, last), ForwardIt2, offloader,
+                         fallback, first,
+                         HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first,
+                         binary_op, unary_op, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T, class BinaryOp,
+          class UnaryTransformOp>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 transform_exclusive_scan(hipsycl::stdpar::par_unseq,
+                                    ForwardIt1 first, ForwardIt1 last,
+                                    ForwardIt2 d_first, T init,
+                                    BinaryOp binary_op,
+                                    UnaryTransformOp unary_op) {
+  auto offloader = [&](auto& queue) {
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::transform_exclusive_scan(queue, scan_scratch_group,
+                                                  first, last, d_first, init,
+                                                  binary_op, unary_op);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform_exclusive_scan(hipsycl::stdpar::par_unseq_host_fallback,
+                                         first, last, d_first, init, binary_op,
+                                         unary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(hipsycl::stdpar::algorithm_type::transform_exclusive_scan{},
+                         std::distance(first, last), ForwardIt2, offloader,
+                         fallback, first,
+                         HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, init,
+                         binary_op, unary_op);
+}
+
 }
 
 #endif
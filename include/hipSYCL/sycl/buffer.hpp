@@ -146,6 +146,9 @@ private:
   sycl::range<Dim> _page_size;
 };
 
+class hipSYCL_sparse_page_table : public detail::buffer_property
+{};
+
 class hipSYCL_write_back_node_group : public detail::buffer_property
 {
 public:
@@ -1126,8 +1129,14 @@ private:
               .get_page_size());
     }
 
+    rt::range_store::representation page_table_representation =
+        rt::range_store::representation::dense;
+    if (this->has_property<property::buffer::hipSYCL_sparse_page_table>())
+      page_table_representation = rt::range_store::representation::sparse;
+
     _impl->data = std::make_shared<rt::buffer_data_region>(
-        rt::embed_in_range3(range), sizeof(T), page_size);
+        rt::embed_in_range3(range), sizeof(T), page_size,
+        page_table_representation);
   }
 
   void preallocate_host_buffer()
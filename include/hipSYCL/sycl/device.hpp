@@ -374,6 +374,12 @@ HIPSYCL_SPECIALIZE_GET_INFO(device, sub_group_independent_forward_progress)
 
 HIPSYCL_SPECIALIZE_GET_INFO(device, sub_group_sizes)
 {
+#if !defined(__HIPSYCL_ENABLE_LLVM_SSCP_TARGET__)
+  // Host kernels that do not go through SSCP always use one work item
+  // per sub-group
+  if(_device_id.get_backend() == rt::backend_id::omp)
+    return std::vector<std::size_t>{1};
+#endif
   return get_rt_device()->get_property(
       rt::device_uint_list_property::sub_group_sizes);
 }
@@ -43,6 +43,7 @@
 #define HIPSYCL_EXT_PREFETCH_HOST
 #define HIPSYCL_EXT_SYNCHRONOUS_MEM_ADVISE
 #define HIPSYCL_EXT_BUFFER_PAGE_SIZE
+#define HIPSYCL_EXT_BUFFER_SPARSE_PAGE_TABLE
 #define HIPSYCL_EXT_EXPLICIT_BUFFER_POLICIES
 #define HIPSYCL_EXT_ACCESSOR_VARIANTS
 
@@ -29,6 +29,7 @@
 #ifndef HIPSYCL_HANDLER_HPP
 #define HIPSYCL_HANDLER_HPP
 
+#include <algorithm>
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
@@ -966,11 +967,13 @@ private:
     bool is_unbound = !hints.has_hint<rt::hints::bind_to_device>();
 
     for(const auto& req : _requirements.get()) {
+      // Buffer requirements are checked by the DAG builder
+      // when constructing an instant node
       if(req->get_operation()->is_requirement())
         uses_buffers = true;
-      if (!req->get_execution_hints()
-               .has_hint<rt::hints::instant_execution>() &&
-          !req->is_known_complete())
+      else if (!req->get_execution_hints()
+                    .has_hint<rt::hints::instant_execution>() &&
+               !req->is_known_complete())
         has_non_instant_dependency = true;
     }
     
@@ -982,25 +985,54 @@ private:
     if(executor && executor->is_inorder_queue())
       is_dedicated_in_order_queue = true;
 
-    if (!HIPSYCL_ALLOW_INSTANT_SUBMISSION || uses_buffers ||
-        has_non_instant_dependency || is_unbound ||
-        !is_dedicated_in_order_queue || _operation_uses_reductions ||
-        op->is_requirement()) {
+    rt::dag_node_ptr node;
+    if (HIPSYCL_ALLOW_INSTANT_SUBMISSION && !has_non_instant_dependency &&
+        !is_unbound && is_dedicated_in_order_queue &&
+        !op->is_requirement()) {
+      if(uses_buffers) {
+        rt::execution_hints instant_hints = hints;
+        instant_hints.set_hint(rt::hints::instant_execution{});
+        // Only succeeds if accessed data is already current on the
+        // target device and no conflicting accesses are pending in the DAG.
+        node = _rt->dag().build_instant_node(op, _requirements, instant_hints);
+        if(node)
+          hints = instant_hints;
+      } else {
+        hints.set_hint(rt::hints::instant_execution{});
+        node = std::make_shared<rt::dag_node>(
+            hints, _requirements.get(), std::move(op), _rt);
+      }
+    }
+
+    if(!node) {
       // traditional submission
       rt::dag_build_guard build{_rt->dag()};
       return build.builder()->add_command_group(std::move(op), _requirements, hints);
     } else {
       // instant submission
-      hints.set_hint(rt::hints::instant_execution{});
-
-      rt::dag_node_ptr node = std::make_shared<rt::dag_node>(
-          hints, _requirements.get(), std::move(op), _rt);
       node->assign_to_device(
           hints.get_hint<rt::hints::bind_to_device>()->get_device_id());
       node->assign_to_executor(executor);
-      executor->submit_directly(node, node->get_operation(), _requirements.get());
+      if(uses_buffers) {
+        // Requirements have been turned into virtual nodes; the executor
+        // needs to synchronize with conflicting accesses instead.
+        rt::node_list_t reqs;
+        node->for_each_nonvirtual_requirement([&](rt::dag_node_ptr req) {
+          if (!req->is_known_complete() &&
+              std::find(reqs.begin(), reqs.end(), req) == reqs.end())
+            reqs.push_back(req);
+        });
+        executor->submit_directly(node, node->get_operation(), reqs);
+      } else {
+        executor->submit_directly(node, node->get_operation(),
+                                  _requirements.get());
+      }
       // Signal that instrumentation setup phase is complete
       node->get_operation()->get_instrumentations().mark_set_complete();
+      // Nodes accessing buffers must remain visible as data users, and
+      // reduction kernels may own scratch memory until they complete.
+      if(uses_buffers || _operation_uses_reductions)
+        _rt->dag().register_instant_submission(node);
       return node;
     }
   }
@@ -0,0 +1,340 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HIPSYCL_SSCP_HOST_COLLECTIVES_HPP
+#define HIPSYCL_SSCP_HOST_COLLECTIVES_HPP
+
+#include "../builtin_config.hpp"
+#include "../core.hpp"
+
+#include <limits>
+#include <type_traits>
+
+// Group collectives for the host backend. CBS executes all work items
+// of a barrier-delimited region before entering the next region, so a
+// collective is expressed as
+//   1. every work item writes its input to its own slot,
+//   2. barrier,
+//   3. the first work item of the group (or every work item, for shuffles)
+//      combines the inputs and writes to a separate output area,
+//   4. barrier,
+//   5. every work item reads its result.
+// Step 5 of one collective shares a region with step 1 of the next one;
+// since the input and output areas never overlap, no additional barrier is
+// needed. All accesses within a region touch distinct addresses per work item
+// or are only performed by a single work item, so the work item loops remain
+// safe to vectorize.
+//
+// Sub-groups consist of __hipsycl_cbs_sscp_sub_group_size consecutive work
+// items, which is a power of two defined by the host JIT. Sub-group
+// collectives use the same scheme restricted to the work items of the
+// sub-group. CBS only knows work group barriers, so they synchronize the
+// entire work group; the host JIT rejects kernels that reach them in
+// divergent control flow. With a sub-group size matching the SIMD width, each
+// sub-group occupies one vector of the vectorized work item loops.
+//
+// The scratch memory is allocated per work group invocation by the host
+// kernel wrapper and holds max_slot_size bytes per work item for inputs
+// and the same again for outputs.
+
+extern "C" void *__hipsycl_cbs_sscp_collective_scratch;
+extern "C" const __hipsycl_uint32 __hipsycl_cbs_sscp_sub_group_size;
+extern "C" [[clang::convergent]] void __hipsycl_cbs_barrier();
+extern "C" [[clang::convergent]] void __hipsycl_cbs_sub_group_barrier();
+
+namespace hipsycl::libkernel::sscp::host {
+
+constexpr __hipsycl_uint64 max_slot_size = 8;
+
+__attribute__((always_inline)) inline __hipsycl_uint64
+get_local_linear_id() {
+  return __hipsycl_sscp_get_local_id_x() +
+         __hipsycl_sscp_get_local_size_x() *
+             (__hipsycl_sscp_get_local_id_y() +
+              __hipsycl_sscp_get_local_size_y() *
+                  __hipsycl_sscp_get_local_id_z());
+}
+
+__attribute__((always_inline)) inline __hipsycl_uint64
+get_local_linear_range() {
+  return __hipsycl_sscp_get_local_size_x() * __hipsycl_sscp_get_local_size_y() *
+         __hipsycl_sscp_get_local_size_z();
+}
+
+template <class T>
+__attribute__((always_inline)) inline T *get_input_slots() {
+  return static_cast<T *>(__hipsycl_cbs_sscp_collective_scratch);
+}
+
+template <class T>
+__attribute__((always_inline)) inline T *get_output_slots() {
+  return reinterpret_cast<T *>(
+      static_cast<char *>(__hipsycl_cbs_sscp_collective_scratch) +
+      max_slot_size * get_local_linear_range());
+}
+
+__attribute__((always_inline)) inline __hipsycl_uint64
+get_sub_group_max_size() {
+  return __hipsycl_cbs_sscp_sub_group_size;
+}
+
+// The work items taking part in a collective, given by the range of local
+// linear ids [begin, end). Collectives over a single work item do not need
+// to synchronize.
+struct work_group_segment {
+  __attribute__((always_inline)) static bool is_single_work_item() {
+    return false;
+  }
+
+  __attribute__((always_inline)) static __hipsycl_uint64
+  begin(__hipsycl_uint64 lid) {
+    return 0;
+  }
+
+  __attribute__((always_inline)) static __hipsycl_uint64
+  end(__hipsycl_uint64 lid) {
+    return get_local_linear_range();
+  }
+
+  __attribute__((always_inline)) static void barrier() {
+    __hipsycl_cbs_barrier();
+  }
+};
+
+struct sub_group_segment {
+  __attribute__((always_inline)) static bool is_single_work_item() {
+    return get_sub_group_max_size() == 1;
+  }
+
+  __attribute__((always_inline)) static __hipsycl_uint64
+  begin(__hipsycl_uint64 lid) {
+    return lid & ~(get_sub_group_max_size() - 1);
+  }
+
+  __attribute__((always_inline)) static __hipsycl_uint64
+  end(__hipsycl_uint64 lid) {
+    const __hipsycl_uint64 segment_end = begin(lid) + get_sub_group_max_size();
+    const __hipsycl_uint64 num_items = get_local_linear_range();
+    return segment_end < num_items ? segment_end : num_items;
+  }
+
+  __attribute__((always_inline)) static void barrier() {
+    __hipsycl_cbs_sub_group_barrier();
+  }
+};
+
+template <class T> struct arithmetic_op_traits {
+  using value_type = T;
+
+  __attribute__((always_inline)) static T apply(__hipsycl_sscp_algorithm_op op,
+                                                T a, T b) {
+    switch (op) {
+    case __hipsycl_sscp_algorithm_op::plus:
+      return a + b;
+    case __hipsycl_sscp_algorithm_op::multiply:
+      return a * b;
+    case __hipsycl_sscp_algorithm_op::min:
+      return (b < a) ? b : a;
+    case __hipsycl_sscp_algorithm_op::max:
+      return (a < b) ? b : a;
+    case __hipsycl_sscp_algorithm_op::logical_and:
+      return a && b;
+    case __hipsycl_sscp_algorithm_op::logical_or:
+      return a || b;
+    default:
+      break;
+    }
+    if constexpr (std::is_integral_v<T>) {
+      switch (op) {
+      case __hipsycl_sscp_algorithm_op::bit_and:
+        return a & b;
+      case __hipsycl_sscp_algorithm_op::bit_or:
+        return a | b;
+      case __hipsycl_sscp_algorithm_op::bit_xor:
+        return a ^ b;
+      default:
+        break;
+      }
+    }
+    return a;
+  }
+
+  __attribute__((always_inline)) static T
+  identity(__hipsycl_sscp_algorithm_op op) {
+    switch (op) {
+    case __hipsycl_sscp_algorithm_op::multiply:
+    case __hipsycl_sscp_algorithm_op::logical_and:
+      return T{1};
+    // Matches sycl::known_identity, which is +/-infinity for floating
+    // point minimum/maximum
+    case __hipsycl_sscp_algorithm_op::min:
+      if constexpr (std::numeric_limits<T>::has_infinity)
+        return std::numeric_limits<T>::infinity();
+      else
+        return std::numeric_limits<T>::max();
+    case __hipsycl_sscp_algorithm_op::max:
+      if constexpr (std::numeric_limits<T>::has_infinity)
+        return -std::numeric_limits<T>::infinity();
+      else
+        return std::numeric_limits<T>::lowest();
+    case __hipsycl_sscp_algorithm_op::bit_and:
+      if constexpr (std::is_integral_v<T>)
+        return static_cast<T>(~T{0});
+      else
+        return T{};
+    default:
+      return T{0};
+    }
+  }
+};
+
+// __hipsycl_f16 is only a storage type and cannot be told apart from
+// __hipsycl_uint16, so half precision operations need their own traits.
+struct half_op_traits {
+  using value_type = __hipsycl_f16;
+
+  __attribute__((always_inline)) static __hipsycl_f16
+  apply(__hipsycl_sscp_algorithm_op op, __hipsycl_f16 a, __hipsycl_f16 b) {
+    switch (op) {
+    case __hipsycl_sscp_algorithm_op::plus:
+      return hipsycl::fp16::builtin_add(a, b);
+    case __hipsycl_sscp_algorithm_op::multiply:
+      return hipsycl::fp16::builtin_mul(a, b);
+    case __hipsycl_sscp_algorithm_op::min:
+      return hipsycl::fp16::builtin_less_than(b, a) ? b : a;
+    case __hipsycl_sscp_algorithm_op::max:
+      return hipsycl::fp16::builtin_less_than(a, b) ? b : a;
+    default:
+      return a;
+    }
+  }
+
+  __attribute__((always_inline)) static __hipsycl_f16
+  identity(__hipsycl_sscp_algorithm_op op) {
+    switch (op) {
+    case __hipsycl_sscp_algorithm_op::multiply:
+      return 0x3c00; // 1.0
+    case __hipsycl_sscp_algorithm_op::min:
+      return 0x7c00; // +inf
+    case __hipsycl_sscp_algorithm_op::max:
+      return 0xfc00; // -inf
+    default:
+      return 0;
+    }
+  }
+};
+
+template <class Segment, class OpTraits,
+          class T = typename OpTraits::value_type>
+__attribute__((always_inline)) inline T
+group_reduce(__hipsycl_sscp_algorithm_op op, T x) {
+  static_assert(sizeof(T) <= max_slot_size);
+  if (Segment::is_single_work_item())
+    return x;
+
+  const __hipsycl_uint64 lid = get_local_linear_id();
+  const __hipsycl_uint64 first = Segment::begin(lid);
+  get_input_slots<T>()[lid] = x;
+  Segment::barrier();
+
+  if (lid == first) {
+    const __hipsycl_uint64 last = Segment::end(lid);
+    T *inputs = get_input_slots<T>();
+    T result = inputs[first];
+    for (__hipsycl_uint64 i = first + 1; i < last; ++i)
+      result = OpTraits::apply(op, result, inputs[i]);
+    get_output_slots<T>()[first] = result;
+  }
+  Segment::barrier();
+
+  return get_output_slots<T>()[first];
+}
+
+template <class Segment, bool Inclusive, class OpTraits,
+          class T = typename OpTraits::value_type>
+__attribute__((always_inline)) inline T
+group_scan(__hipsycl_sscp_algorithm_op op, T x) {
+  static_assert(sizeof(T) <= max_slot_size);
+  if (Segment::is_single_work_item())
+    return Inclusive ? x : OpTraits::identity(op);
+
+  const __hipsycl_uint64 lid = get_local_linear_id();
+  const __hipsycl_uint64 first = Segment::begin(lid);
+  get_input_slots<T>()[lid] = x;
+  Segment::barrier();
+
+  if (lid == first) {
+    const __hipsycl_uint64 last = Segment::end(lid);
+    T *inputs = get_input_slots<T>();
+    T *outputs = get_output_slots<T>();
+    T current = OpTraits::identity(op);
+    for (__hipsycl_uint64 i = first; i < last; ++i) {
+      T next = OpTraits::apply(op, current, inputs[i]);
+      outputs[i] = Inclusive ? next : current;
+      current = next;
+    }
+  }
+  Segment::barrier();
+
+  return get_output_slots<T>()[lid];
+}
+
+// Returns the value of the work item with the group-local id
+// source_id(group_local_id, group_size). Source ids outside of the group
+// yield the work item's own value.
+template <class Segment, class T, class SourceIdF>
+__attribute__((always_inline)) inline T group_shuffle(T x,
+                                                      SourceIdF source_id) {
+  static_assert(sizeof(T) <= max_slot_size);
+  if (Segment::is_single_work_item())
+    return x;
+
+  const __hipsycl_uint64 lid = get_local_linear_id();
+  get_input_slots<T>()[lid] = x;
+  Segment::barrier();
+
+  const __hipsycl_uint64 first = Segment::begin(lid);
+  const __hipsycl_uint64 size = Segment::end(lid) - first;
+  __hipsycl_uint64 src = source_id(lid - first, size);
+  get_output_slots<T>()[lid] =
+      get_input_slots<T>()[src < size ? first + src : lid];
+  Segment::barrier();
+
+  return get_output_slots<T>()[lid];
+}
+
+template <class Segment, class T>
+__attribute__((always_inline)) inline T group_broadcast(__hipsycl_int32 sender,
+                                                        T x) {
+  return group_shuffle<Segment>(x, [=](__hipsycl_uint64, __hipsycl_uint64) {
+    return static_cast<__hipsycl_uint64>(sender);
+  });
+}
+
+} // namespace hipsycl::libkernel::sscp::host
+
+#endif
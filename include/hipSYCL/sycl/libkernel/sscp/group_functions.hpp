@@ -51,6 +51,7 @@
 #include "builtins/broadcast.hpp"
 #include "builtins/collpredicate.hpp"
 #include "builtins/reduction.hpp"
+#include "builtins/scan.hpp"
 #include "builtins/shuffle.hpp"
 
 namespace hipsycl {
@@ -573,61 +574,140 @@ T __hipsycl_joint_reduce(Group g, Ptr first, Ptr last, T init,
   return binary_op(__hipsycl_joint_reduce(g, first, last, binary_op), init);
 }
 
+// scans
+
+#define HIPSYCL_SSCP_DEFINE_SCAN_DISPATCH(builtin_prefix)                       \
+  template <class T>                                                           \
+  HIPSYCL_BUILTIN T builtin_prefix(__hipsycl_sscp_algorithm_op op, T x) {      \
+    if constexpr (std::is_same_v<T, half>) {                                   \
+      return detail::create_half(                                              \
+          builtin_prefix##_f16(op, detail::get_half_storage(x)));              \
+    } else if constexpr (std::is_same_v<T, float>) {                           \
+      return builtin_prefix##_f32(op, x);                                      \
+    } else if constexpr (std::is_same_v<T, double>) {                          \
+      return builtin_prefix##_f64(op, x);                                      \
+    } else if constexpr (std::is_signed_v<T>) {                                \
+      if constexpr (sizeof(T) == 1) {                                          \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_i8(op, maybe_bit_cast<__hipsycl_int8>(x)));       \
+      } else if constexpr (sizeof(T) == 2) {                                   \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_i16(op, maybe_bit_cast<__hipsycl_int16>(x)));     \
+      } else if constexpr (sizeof(T) == 4) {                                   \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_i32(op, maybe_bit_cast<__hipsycl_int32>(x)));     \
+      } else {                                                                 \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_i64(op, maybe_bit_cast<__hipsycl_int64>(x)));     \
+      }                                                                        \
+    } else {                                                                   \
+      if constexpr (sizeof(T) == 1) {                                          \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_u8(op, maybe_bit_cast<__hipsycl_uint8>(x)));      \
+      } else if constexpr (sizeof(T) == 2) {                                   \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_u16(op, maybe_bit_cast<__hipsycl_uint16>(x)));    \
+      } else if constexpr (sizeof(T) == 4) {                                   \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_u32(op, maybe_bit_cast<__hipsycl_uint32>(x)));    \
+      } else {                                                                 \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_u64(op, maybe_bit_cast<__hipsycl_uint64>(x)));    \
+      }                                                                        \
+    }                                                                          \
+  }
+
+HIPSYCL_SSCP_DEFINE_SCAN_DISPATCH(__hipsycl_sscp_work_group_inclusive_scan)
+HIPSYCL_SSCP_DEFINE_SCAN_DISPATCH(__hipsycl_sscp_work_group_exclusive_scan)
+HIPSYCL_SSCP_DEFINE_SCAN_DISPATCH(__hipsycl_sscp_sub_group_inclusive_scan)
+HIPSYCL_SSCP_DEFINE_SCAN_DISPATCH(__hipsycl_sscp_sub_group_exclusive_scan)
+
 // exclusive_scan
 
+template <int Dim, typename T, typename BinaryOperation>
+HIPSYCL_BUILTIN T __hipsycl_exclusive_scan_over_group(
+    group<Dim> g, T x, BinaryOperation binary_op) {
+  return __hipsycl_sscp_work_group_exclusive_scan(
+      sscp_binary_operation_v<BinaryOperation>, x);
+}
 
-template <int Dim, typename V, typename T, typename BinaryOperation>
+template <typename T, typename BinaryOperation>
 HIPSYCL_BUILTIN T __hipsycl_exclusive_scan_over_group(
-    group<Dim> g, V x, T init, BinaryOperation binary_op);
+    sub_group g, T x, BinaryOperation binary_op) {
+  return __hipsycl_sscp_sub_group_exclusive_scan(
+      sscp_binary_operation_v<BinaryOperation>, x);
+}
 
+template <int Dim, typename V, typename T, typename BinaryOperation>
+HIPSYCL_BUILTIN T __hipsycl_exclusive_scan_over_group(
+    group<Dim> g, V x, T init, BinaryOperation binary_op) {
+  // The exclusive scan yields the identity for the first work item
+  return binary_op(init, __hipsycl_exclusive_scan_over_group(g, T{x}, binary_op));
+}
 
 template <typename V, typename T, typename BinaryOperation>
 HIPSYCL_BUILTIN T __hipsycl_exclusive_scan_over_group(
-    sub_group g, V x, T init, BinaryOperation binary_op);
-
-template <typename Group, typename T, typename BinaryOperation,
-          std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
-HIPSYCL_BUILTIN T
-__hipsycl_exclusive_scan_over_group(Group g, T x, BinaryOperation binary_op);
+    sub_group g, V x, T init, BinaryOperation binary_op) {
+  return binary_op(init, __hipsycl_exclusive_scan_over_group(g, T{x}, binary_op));
+}
 
 template <typename Group, typename InPtr, typename OutPtr, typename T,
           typename BinaryOperation,
           std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
 HIPSYCL_BUILTIN OutPtr
 __hipsycl_joint_exclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
-                               T init, BinaryOperation binary_op);
+                               T init, BinaryOperation binary_op) {
+  const size_t lrange       = g.get_local_range().size();
+  const size_t num_elements = last - first;
+  const size_t lid          = g.get_local_linear_id();
 
-template <typename Group, typename InPtr, typename OutPtr,
-          typename BinaryOperation,
-          std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
-HIPSYCL_BUILTIN OutPtr
-__hipsycl_joint_exclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
-                               BinaryOperation binary_op);
+  const auto identity = sscp_binary_operation_identity<
+      T, sscp_binary_operation_v<BinaryOperation>>::get();
 
-// inclusive_scan
+  T carry = init;
+  for(size_t offset = 0; offset < num_elements; offset += lrange) {
+    const size_t i = offset + lid;
+    T x = (i < num_elements) ? T{first[i]} : identity;
 
-template <typename Group, typename InPtr, typename OutPtr, typename T,
-          typename BinaryOperation,
-          std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
-HIPSYCL_BUILTIN OutPtr
-__hipsycl_joint_inclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
-                               BinaryOperation binary_op, T init);
+    T scan = binary_op(carry, __hipsycl_exclusive_scan_over_group(g, x, binary_op));
+    if(i < num_elements)
+      result[i] = scan;
+    carry = __hipsycl_group_broadcast(g, binary_op(scan, x), lrange - 1);
+  }
+  return result + num_elements;
+}
 
 template <typename Group, typename InPtr, typename OutPtr,
           typename BinaryOperation,
           std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
 HIPSYCL_BUILTIN OutPtr
-__hipsycl_joint_inclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
-                               BinaryOperation binary_op);
+__hipsycl_joint_exclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
+                               BinaryOperation binary_op) {
+  using value_type = std::remove_cv_t<
+      std::remove_reference_t<decltype(*first)>>;
+  return __hipsycl_joint_exclusive_scan(
+      g, first, last, result,
+      sscp_binary_operation_identity<
+          value_type, sscp_binary_operation_v<BinaryOperation>>::get(),
+      binary_op);
+}
+
+// inclusive_scan
 
 template <int Dim, typename T, typename BinaryOperation>
 HIPSYCL_BUILTIN
 T __hipsycl_inclusive_scan_over_group(
-    group<Dim> g, T x, BinaryOperation binary_op);
+    group<Dim> g, T x, BinaryOperation binary_op) {
+  return __hipsycl_sscp_work_group_inclusive_scan(
+      sscp_binary_operation_v<BinaryOperation>, x);
+}
 
 template <typename T, typename BinaryOperation>
 HIPSYCL_BUILTIN T __hipsycl_inclusive_scan_over_group(
-    sub_group g, T x, BinaryOperation binary_op);
+    sub_group g, T x, BinaryOperation binary_op) {
+  return __hipsycl_sscp_sub_group_inclusive_scan(
+      sscp_binary_operation_v<BinaryOperation>, x);
+}
 
 template <typename Group, typename V, typename T, typename BinaryOperation,
           std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
@@ -637,6 +717,46 @@ HIPSYCL_BUILTIN T __hipsycl_inclusive_scan_over_group(
   return binary_op(scan, init);
 }
 
+template <typename Group, typename InPtr, typename OutPtr, typename T,
+          typename BinaryOperation,
+          std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
+HIPSYCL_BUILTIN OutPtr
+__hipsycl_joint_inclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
+                               BinaryOperation binary_op, T init) {
+  const size_t lrange       = g.get_local_range().size();
+  const size_t num_elements = last - first;
+  const size_t lid          = g.get_local_linear_id();
+
+  const auto identity = sscp_binary_operation_identity<
+      T, sscp_binary_operation_v<BinaryOperation>>::get();
+
+  T carry = init;
+  for(size_t offset = 0; offset < num_elements; offset += lrange) {
+    const size_t i = offset + lid;
+    T x = (i < num_elements) ? T{first[i]} : identity;
+
+    T scan = binary_op(carry, __hipsycl_inclusive_scan_over_group(g, x, binary_op));
+    if(i < num_elements)
+      result[i] = scan;
+    carry = __hipsycl_group_broadcast(g, scan, lrange - 1);
+  }
+  return result + num_elements;
+}
+
+template <typename Group, typename InPtr, typename OutPtr,
+          typename BinaryOperation,
+          std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
+HIPSYCL_BUILTIN OutPtr
+__hipsycl_joint_inclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
+                               BinaryOperation binary_op) {
+  using value_type = std::remove_cv_t<
+      std::remove_reference_t<decltype(*first)>>;
+  return __hipsycl_joint_inclusive_scan(
+      g, first, last, result, binary_op,
+      sscp_binary_operation_identity<
+          value_type, sscp_binary_operation_v<BinaryOperation>>::get());
+}
+
 // shift_left
 template <int Dim, typename T>
 HIPSYCL_BUILTIN
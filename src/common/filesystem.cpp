@@ -109,6 +109,10 @@ join_path(const std::string &base,
   return current;
 }
 
+std::string get_filename(const std::string& path) {
+  return fs::path{path}.filename().string();
+}
+
 std::vector<std::string> list_regular_files(const std::string& directory) {
   fs::path p{directory};
   std::vector<std::string> result;
@@ -132,7 +136,7 @@ std::vector<std::string> list_regular_files(const std::string& directory,
   return result;
 }
 
-bool atomic_write(const std::string &filename, const std::string &data) {
+bool atomic_write(const std::string &filename, std::string_view data) {
   fs::path p{filename};
 
   std::string temp_file = std::to_string(random_number<std::size_t>())+".tmp";
@@ -1220,6 +1220,47 @@ getBarrierIds(llvm::BasicBlock *Entry, llvm::SmallPtrSetImpl<llvm::BasicBlock *>
   return Barriers;
 }
 
+// A sub-group barrier with sub-group size > 1 is lowered to a work-group barrier, so all work-items
+// of the group must reach it. Reject kernels where it is control dependent on a varying branch.
+void diagnoseDivergentSubGroupBarriers(
+    llvm::Function &F, const llvm::DenseMap<llvm::BasicBlock *, size_t> &Barriers,
+    const hipsycl::compiler::VectorizationInfo &VecInfo, llvm::PostDominatorTree &PDT) {
+  auto IsVaryingBranch = [&VecInfo](const llvm::Instruction *Term) {
+    llvm::Value *Cond = nullptr;
+    if (const auto *BI = llvm::dyn_cast<llvm::BranchInst>(Term); BI && BI->isConditional())
+      Cond = BI->getCondition();
+    else if (const auto *SI = llvm::dyn_cast<llvm::SwitchInst>(Term))
+      Cond = SI->getCondition();
+    return Cond && VecInfo.hasKnownShape(*Cond) &&
+           VecInfo.getVectorShape(*Cond).greaterThanUniform();
+  };
+
+  for (auto &BIt : Barriers) {
+    auto *BarrierBlock = BIt.first;
+    if (std::none_of(BarrierBlock->begin(), BarrierBlock->end(), [](const auto &I) {
+          return I.getMetadata(hipsycl::compiler::MDKind::SubGroupBarrier);
+        }))
+      continue;
+
+    for (auto &BB : F) {
+      auto *Term = BB.getTerminator();
+      if (!IsVaryingBranch(Term) || PDT.dominates(BarrierBlock, &BB))
+        continue;
+      // control dependent: post-dominates some, but not all successors
+      if (std::any_of(llvm::succ_begin(&BB), llvm::succ_end(&BB),
+                      [&](auto *Succ) { return PDT.dominates(BarrierBlock, Succ); })) {
+        HIPSYCL_DEBUG_ERROR << "[SubCFG] Sub-group barrier in " << BarrierBlock->getName()
+                            << " is in divergent control flow of kernel " << F.getName()
+                            << ", which is not supported with sub-group sizes > 1\n";
+        auto *MD = F.getParent()->getOrInsertNamedMetadata(DivergentSubGroupBarriersName);
+        MD->addOperand(llvm::MDNode::get(F.getContext(), {llvm::MDString::get(F.getContext(),
+                                                                                F.getName())}));
+        return;
+      }
+    }
+  }
+}
+
 void formSubCfgs(llvm::Function &F, llvm::LoopInfo &LI, llvm::DominatorTree &DT,
                  llvm::PostDominatorTree &PDT, const SplitterAnnotationInfo &SAA, bool IsSscp) {
   HIPSYCL_DEBUG_EXECUTE_VERBOSE(F.viewCFG();)
@@ -1256,6 +1297,7 @@ void formSubCfgs(llvm::Function &F, llvm::LoopInfo &LI, llvm::DominatorTree &DT,
   }
 
   auto Barriers = getBarrierIds(Entry, ExitingBlocks, Blocks, SAA);
+  diagnoseDivergentSubGroupBarriers(F, Barriers, VecInfo, PDT);
 
   const llvm::DataLayout &DL = F.getParent()->getDataLayout();
   auto *LastBarrierIdStorage =
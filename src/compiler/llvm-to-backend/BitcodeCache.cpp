@@ -0,0 +1,60 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/compiler/llvm-to-backend/BitcodeCache.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/Support/raw_ostream.h>
+
+namespace hipsycl {
+namespace compiler {
+
+BitcodeCache &BitcodeCache::get() {
+  static BitcodeCache Cache;
+  return Cache;
+}
+
+const llvm::MemoryBuffer *BitcodeCache::getFile(const std::string &Path) {
+  std::lock_guard<std::mutex> Lock{Mutex};
+
+  auto It = Files.find(Path);
+  if(It != Files.end())
+    return It->second.get();
+
+  auto F = llvm::MemoryBuffer::getFile(Path);
+  if(F.getError())
+    return nullptr;
+
+  HIPSYCL_DEBUG_INFO << "BitcodeCache: Loaded bitcode file " << Path << " ("
+                     << F.get()->getBufferSize() << " bytes)\n";
+  auto& Entry = Files[Path];
+  Entry = std::move(F.get());
+  return Entry.get();
+}
+
+}
+}
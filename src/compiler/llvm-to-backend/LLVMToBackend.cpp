@@ -27,6 +27,7 @@
 
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/AddressSpaceInferencePass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/BitcodeCache.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/GlobalSizesFitInI32OptPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/KnownGroupSizeOptPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/LLVMToBackend.hpp"
@@ -36,10 +37,18 @@
 #include "hipSYCL/glue/llvm-sscp/s2_ir_constants.hpp"
 
 #include <cstdint>
+#include <cstring>
+#include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/APInt.h>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/Attributes.h>
+#include <llvm/IR/Constants.h>
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/DiagnosticInfo.h>
 #include <llvm/IR/DiagnosticPrinter.h>
+#include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Intrinsics.h>
 #include <llvm/Support/raw_ostream.h>
@@ -48,6 +57,7 @@
 #include <llvm/Linker/Linker.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/Error.h>
+#include <llvm/Support/MathExtras.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <string>
 
@@ -95,6 +105,69 @@ void setFastMathFunctionAttribs(llvm::Module& M) {
 }
 
 
+llvm::Argument *getPointerKernelParam(llvm::Module &M, const std::string &KernelName,
+                                      int ParamIndex) {
+  llvm::Function *F = M.getFunction(KernelName);
+  if(!F || F->isDeclaration() || ParamIndex < 0 || ParamIndex >= F->arg_size())
+    return nullptr;
+  llvm::Argument *Arg = F->getArg(ParamIndex);
+  // byval parameters are pointers in the IR, but do not correspond
+  // to a pointer that was passed to the kernel.
+  if(!Arg->getType()->isPointerTy() || Arg->hasByValAttr())
+    return nullptr;
+  return Arg;
+}
+
+bool containsPointer(llvm::Type *T) {
+  if(T->isPtrOrPtrVectorTy())
+    return true;
+  if(auto *ST = llvm::dyn_cast<llvm::StructType>(T))
+    return llvm::any_of(ST->elements(), containsPointer);
+  if(auto *AT = llvm::dyn_cast<llvm::ArrayType>(T))
+    return containsPointer(AT->getElementType());
+  return false;
+}
+
+// Whether the kernel or any function it calls may access memory through
+// pointers that are not based on its parameters, i.e. pointers loaded from
+// memory, created from integers, or used by unknown functions. Such accesses
+// are not covered by the runtime's knowledge about distinct allocations.
+bool mayUsePointersNotBasedOnParams(llvm::Function &Kernel) {
+  llvm::SmallPtrSet<llvm::Function *, 16> Visited;
+  llvm::SmallVector<llvm::Function *, 16> Worklist{&Kernel};
+  while(!Worklist.empty()) {
+    llvm::Function *F = Worklist.pop_back_val();
+    if(!Visited.insert(F).second)
+      continue;
+
+    for(auto &BB : *F) {
+      for(auto &I : BB) {
+        if(llvm::isa<llvm::IntToPtrInst>(I))
+          return true;
+
+        if(auto *CB = llvm::dyn_cast<llvm::CallBase>(&I)) {
+          llvm::Function *Callee = CB->getCalledFunction();
+          if(!Callee)
+            return true;
+          if(Callee->isIntrinsic())
+            continue;
+          if(Callee->isDeclaration()) {
+            // SSCP builtins are provided by the backend and only access
+            // memory through the pointers they are given.
+            if(!Callee->getName().startswith("__hipsycl_sscp_"))
+              return true;
+            continue;
+          }
+          Worklist.push_back(Callee);
+        } else if(I.mayReadFromMemory() && containsPointer(I.getType())) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
 }
 
 LLVMToBackendTranslator::LLVMToBackendTranslator(int S2IRConstantCurrentBackendId,
@@ -211,6 +284,18 @@ bool LLVMToBackendTranslator::prepareIR(llvm::Module &M) {
     A.second(M);
   }
 
+  if(!KernelArgSpecializationApplicators.empty()) {
+    HIPSYCL_DEBUG_INFO << "LLVMToBackend: Applying kernel argument specializations...\n";
+    for(auto& A : KernelArgSpecializationApplicators)
+      A(M);
+  }
+
+  if(!KernelParamAttributeApplicators.empty()) {
+    HIPSYCL_DEBUG_INFO << "LLVMToBackend: Applying kernel parameter attributes...\n";
+    for(auto& A : KernelParamAttributeApplicators)
+      A(M);
+  }
+
   bool ContainsUnsetIRConstants = false;
   bool FlavoringSuccessful = false;
   bool OptimizationSuccessful = false;
@@ -314,12 +399,15 @@ bool LLVMToBackendTranslator::optimizeFlavoredIR(llvm::Module& M, PassHandler& P
   return true;
 }
 
-bool LLVMToBackendTranslator::linkBitcodeString(llvm::Module &M, const std::string &Bitcode,
+bool LLVMToBackendTranslator::linkBitcodeString(llvm::Module &M, std::string_view Bitcode,
                                                 const std::string &ForcedTriple,
                                                 const std::string &ForcedDataLayout,
                                                 bool LinkOnlyNeeded) {
+  // The module only references the bitcode until it has been
+  // linked and destroyed within this function.
   std::unique_ptr<llvm::Module> OtherModule;
-  auto err = loadModuleFromString(Bitcode, M.getContext(), OtherModule);
+  auto err = loadLazyModuleFromBuffer(llvm::MemoryBufferRef{Bitcode, ""}, M.getContext(),
+                                      OtherModule);
 
   if (err) {
     this->registerError("LLVMToBackend: Could not load LLVM module");
@@ -345,13 +433,13 @@ bool LLVMToBackendTranslator::linkBitcodeFile(llvm::Module &M, const std::string
                                               const std::string &ForcedTriple,
                                               const std::string &ForcedDataLayout,
                                               bool LinkOnlyNeeded) {
-  auto F = llvm::MemoryBuffer::getFile(BitcodeFile);
-  if(auto Err = F.getError()) {
+  const llvm::MemoryBuffer *F = BitcodeCache::get().getFile(BitcodeFile);
+  if(!F) {
     this->registerError("LLVMToBackend: Could not open file " + BitcodeFile);
     return false;
   }
   HIPSYCL_DEBUG_INFO << "LLVMToBackend: Linking with bitcode file: " << BitcodeFile << "\n";
-  return linkBitcodeString(M, std::string{F.get()->getBuffer()}, ForcedTriple, ForcedDataLayout,
+  return linkBitcodeString(M, F->getBuffer(), ForcedTriple, ForcedDataLayout,
                            LinkOnlyNeeded);
 }
 
@@ -362,6 +450,95 @@ void LLVMToBackendTranslator::setS2IRConstant(const std::string &name, const voi
   };
 }
 
+void LLVMToBackendTranslator::specializeKernelArgument(const std::string &KernelName,
+                                                       int ParamIndex,
+                                                       const void *ValueBuffer) {
+  uint64_t Value = 0;
+  std::memcpy(&Value, ValueBuffer, sizeof(Value));
+
+  KernelArgSpecializationApplicators.push_back([=](llvm::Module &M) {
+    llvm::Function *F = M.getFunction(KernelName);
+    if(!F || F->isDeclaration() || ParamIndex < 0 || ParamIndex >= F->arg_size())
+      return;
+
+    llvm::Argument *Arg = F->getArg(ParamIndex);
+    llvm::Type *T = Arg->getType();
+
+    llvm::Constant *C = nullptr;
+    if(T->isIntegerTy() && T->getIntegerBitWidth() <= 64) {
+      C = llvm::ConstantInt::get(
+          M.getContext(), llvm::APInt{64, Value}.trunc(T->getIntegerBitWidth()));
+    } else if(T->isHalfTy()) {
+      C = llvm::ConstantFP::get(
+          M.getContext(), llvm::APFloat{llvm::APFloat::IEEEhalf(), llvm::APInt{16, Value}});
+    } else if(T->isFloatTy()) {
+      C = llvm::ConstantFP::get(
+          M.getContext(), llvm::APFloat{llvm::APFloat::IEEEsingle(), llvm::APInt{32, Value}});
+    } else if(T->isDoubleTy()) {
+      C = llvm::ConstantFP::get(
+          M.getContext(), llvm::APFloat{llvm::APFloat::IEEEdouble(), llvm::APInt{64, Value}});
+    }
+
+    if(!C) {
+      HIPSYCL_DEBUG_WARNING << "LLVMToBackend: Cannot specialize parameter " << ParamIndex
+                            << " of kernel " << KernelName << " due to unsupported type\n";
+      return;
+    }
+
+    HIPSYCL_DEBUG_INFO << "LLVMToBackend: Specializing parameter " << ParamIndex
+                       << " of kernel " << KernelName << " to value " << Value << "\n";
+    Arg->replaceAllUsesWith(C);
+  });
+}
+
+void LLVMToBackendTranslator::setKnownPtrParamAlignment(const std::string &KernelName,
+                                                        int ParamIndex, int Alignment) {
+  KernelParamAttributeApplicators.push_back([=](llvm::Module &M) {
+    llvm::Argument *Arg = getPointerKernelParam(M, KernelName, ParamIndex);
+    if(!Arg || Alignment <= 0 || !llvm::isPowerOf2_32(Alignment))
+      return;
+
+    HIPSYCL_DEBUG_INFO << "LLVMToBackend: Parameter " << ParamIndex << " of kernel "
+                       << KernelName << " is aligned to " << Alignment << " bytes\n";
+
+    llvm::Function *F = Arg->getParent();
+    // Keep the stronger alignment if there is one already
+    if(F->getParamAlign(ParamIndex).valueOrOne().value() < static_cast<uint64_t>(Alignment)) {
+      F->removeParamAttr(ParamIndex, llvm::Attribute::Alignment);
+      F->addParamAttr(ParamIndex, llvm::Attribute::getWithAlignment(
+                                      M.getContext(), llvm::Align{static_cast<uint64_t>(Alignment)}));
+    }
+    // Parameter attributes are lost when the kernel is inlined, e.g. into the
+    // host kernel wrapper, so also provide the information as an assumption.
+    llvm::IRBuilder<> Builder{&F->getEntryBlock(), F->getEntryBlock().getFirstInsertionPt()};
+    Builder.CreateAlignmentAssumption(M.getDataLayout(), Arg, Alignment);
+  });
+}
+
+void LLVMToBackendTranslator::setNoAliasKernelParam(const std::string &KernelName,
+                                                    int ParamIndex) {
+  KernelParamAttributeApplicators.push_back([=](llvm::Module &M) {
+    llvm::Argument *Arg = getPointerKernelParam(M, KernelName, ParamIndex);
+    if(!Arg)
+      return;
+
+    // noalias also forbids aliasing accesses through pointers that the kernel
+    // obtains otherwise, e.g. from a pointer table that points into the
+    // same allocation as the parameter.
+    if(mayUsePointersNotBasedOnParams(*Arg->getParent())) {
+      HIPSYCL_DEBUG_INFO << "LLVMToBackend: Not marking parameter " << ParamIndex
+                         << " of kernel " << KernelName
+                         << " as noalias, kernel may use pointers not based on its parameters\n";
+      return;
+    }
+
+    HIPSYCL_DEBUG_INFO << "LLVMToBackend: Parameter " << ParamIndex << " of kernel "
+                       << KernelName << " does not alias other parameters\n";
+    // When inlined, the inliner turns this into scoped noalias metadata.
+    Arg->getParent()->addParamAttr(ParamIndex, llvm::Attribute::NoAlias);
+  });
+}
+
 void LLVMToBackendTranslator::provideExternalSymbolResolver(ExternalSymbolResolver Resolver) {
   this->SymbolResolver = Resolver;
   this->HasExternalSymbolResolver = true;
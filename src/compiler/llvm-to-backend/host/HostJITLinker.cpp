@@ -0,0 +1,117 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/compiler/llvm-to-backend/host/HostJITLinker.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHost.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/BinaryFormat/Magic.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <mutex>
+
+namespace hipsycl {
+namespace compiler {
+
+struct HostJITLinker::Impl {
+  std::unique_ptr<llvm::orc::LLJIT> JIT;
+};
+
+HostJITLinker::HostJITLinker(std::unique_ptr<Impl> I)
+: JITImpl{std::move(I)} {}
+
+HostJITLinker::~HostJITLinker() {
+  if(JITImpl && JITImpl->JIT) {
+    if(auto Err = JITImpl->JIT->deinitialize(JITImpl->JIT->getMainJITDylib())) {
+      HIPSYCL_DEBUG_WARNING << "HostJITLinker: Deinitialization failed: "
+                            << llvm::toString(std::move(Err)) << "\n";
+    }
+  }
+}
+
+bool HostJITLinker::isRelocatableObject(std::string_view Binary) {
+  auto Magic = llvm::identify_magic(Binary);
+  return Magic == llvm::file_magic::elf_relocatable ||
+         Magic == llvm::file_magic::macho_object ||
+         Magic == llvm::file_magic::coff_object;
+}
+
+std::unique_ptr<HostJITLinker> HostJITLinker::create(std::string_view ObjectFile,
+                                                     std::string &ErrorOut) {
+  initializeNativeTarget();
+
+  auto JIT = llvm::orc::LLJITBuilder{}.create();
+  if(!JIT) {
+    ErrorOut = "HostJITLinker: Could not construct JIT: " + llvm::toString(JIT.takeError());
+    return nullptr;
+  }
+
+  // Resolve symbols such as math library functions against the process,
+  // analogously to what the dynamic linker does when dlopen'ing a shared library.
+  auto ProcessSymbols = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+      (*JIT)->getDataLayout().getGlobalPrefix());
+  if(!ProcessSymbols) {
+    ErrorOut = "HostJITLinker: Could not construct process symbol generator: " +
+               llvm::toString(ProcessSymbols.takeError());
+    return nullptr;
+  }
+  (*JIT)->getMainJITDylib().addGenerator(std::move(*ProcessSymbols));
+
+  auto Buffer = llvm::MemoryBuffer::getMemBufferCopy(ObjectFile, "acpp-sscp-host-object");
+  if(auto Err = (*JIT)->addObjectFile(std::move(Buffer))) {
+    ErrorOut = "HostJITLinker: Could not add object file: " + llvm::toString(std::move(Err));
+    return nullptr;
+  }
+  if(auto Err = (*JIT)->initialize((*JIT)->getMainJITDylib())) {
+    ErrorOut = "HostJITLinker: Initialization failed: " + llvm::toString(std::move(Err));
+    return nullptr;
+  }
+
+  auto I = std::make_unique<Impl>();
+  I->JIT = std::move(*JIT);
+  return std::unique_ptr<HostJITLinker>{new HostJITLinker{std::move(I)}};
+}
+
+void *HostJITLinker::getSymbol(const std::string &Name) const {
+  auto Symbol = JITImpl->JIT->lookup(Name);
+  if(!Symbol) {
+    HIPSYCL_DEBUG_ERROR << "HostJITLinker: Symbol lookup failed: "
+                        << llvm::toString(Symbol.takeError()) << "\n";
+    return nullptr;
+  }
+#if LLVM_VERSION_MAJOR < 15
+  return reinterpret_cast<void *>(static_cast<uintptr_t>(Symbol->getAddress()));
+#else
+  return Symbol->toPtr<void *>();
+#endif
+}
+
+} // namespace compiler
+} // namespace hipsycl
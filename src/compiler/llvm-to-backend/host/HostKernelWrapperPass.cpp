@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/StringRef.h>
@@ -55,6 +56,10 @@ namespace hipsycl {
 namespace compiler {
 
 namespace {
+// Must match max_slot_size in sscp/builtins/host/collectives.hpp
+constexpr std::uint64_t CollectiveScratchSlotSize = 8;
+constexpr std::uint64_t CollectiveScratchAlignment = 64;
+
 llvm::StoreInst *storeToGlobalVar(llvm::IRBuilderBase Bld, llvm::Value *V,
                                   llvm::StringRef GlobalVarName) {
   auto M = Bld.GetInsertBlock()->getModule();
@@ -81,6 +86,129 @@ void replaceUsesOfGVWith(llvm::Function &F, llvm::StringRef GlobalVarName, llvm:
     I->eraseFromParent();
 }
 
+bool hasLoadsOfGV(llvm::Function &F, llvm::StringRef GlobalVarName) {
+  auto GV = F.getParent()->getGlobalVariable(GlobalVarName);
+  if (!GV)
+    return false;
+  return llvm::any_of(GV->users(), [&](llvm::User *U) {
+    auto I = llvm::dyn_cast<llvm::LoadInst>(U);
+    return I && I->getFunction() == &F;
+  });
+}
+
+llvm::StructType *getWorkGroupInfoType(llvm::Module &M) {
+  auto &Ctx = M.getContext();
+  auto SizeT = M.getDataLayout().getLargestLegalIntType(Ctx);
+  return llvm::StructType::get(
+      llvm::ArrayType::get(SizeT, 3),                                 // # groups
+      llvm::ArrayType::get(SizeT, 3),                                 // group id
+      llvm::ArrayType::get(SizeT, 3),                                 // local size
+      llvm::PointerType::getUnqual(llvm::Type::getInt8Ty(Ctx)));      // local memory size
+}
+
+llvm::Function *createWrapperDeclaration(llvm::Function &F, const std::string &Name,
+                                         llvm::ArrayRef<llvm::Type *> ArgTypes) {
+  auto M = F.getParent();
+  auto WrapperT = llvm::FunctionType::get(llvm::Type::getVoidTy(M->getContext()), ArgTypes, false);
+  auto Wrapper = llvm::cast<llvm::Function>(M->getOrInsertFunction(Name, WrapperT).getCallee());
+  // Parameter attributes of the kernel do not apply to the wrapper parameters
+  for (auto &Attr : F.getAttributes().getFnAttrs())
+    Wrapper->addFnAttr(Attr);
+  Wrapper->setLinkage(llvm::GlobalValue::LinkageTypes::ExternalLinkage);
+  return Wrapper;
+}
+
+// Loads the kernel arguments of F from the array of pointers ArgArray.
+llvm::SmallVector<llvm::Value *> loadKernelArgs(llvm::IRBuilderBase &Bld, llvm::Function &F,
+                                                llvm::Value *ArgArray) {
+  auto VoidPtrT = llvm::PointerType::getUnqual(Bld.getInt8Ty());
+  auto UserArgsT = llvm::PointerType::getUnqual(VoidPtrT);
+
+  llvm::SmallVector<llvm::Value *> Args;
+  for (int I = 0; I < F.arg_size(); ++I) {
+
+    if IS_OPAQUE(ArgArray->getType()) {
+      auto GEP = Bld.CreateInBoundsGEP(UserArgsT, ArgArray,
+                                       llvm::ArrayRef<llvm::Value *>{Bld.getInt32(I)});
+      Args.push_back(Bld.CreateLoad(F.getArg(I)->getType(), Bld.CreateLoad(VoidPtrT, GEP)));
+    } else {
+#if HAS_TYPED_PTR // otherwise, IS_OPAQUE is always true
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+      auto GEP = Bld.CreateInBoundsGEP(UserArgsT->getNonOpaquePointerElementType(), ArgArray,
+                                       llvm::ArrayRef<llvm::Value *>{Bld.getInt32(I)});
+#pragma GCC diagnostic pop
+      auto CastedPtr = Bld.CreatePointerCast(Bld.CreateLoad(VoidPtrT, GEP),
+                                             llvm::PointerType::getUnqual(F.getArg(I)->getType()));
+      Args.push_back(Bld.CreateLoad(F.getArg(I)->getType(), CastedPtr));
+#endif
+    }
+  }
+  return Args;
+}
+
+/*
+ * Emits a loop over the linear group ids [Begin, End) given by the last two arguments of
+ * GroupRangeWrapper, starting at the current insertion point of Bld. The x dimension is the
+ * fastest moving one. The 3D group id is advanced incrementally, such that the loop body does
+ * not need any divisions. EmitBody is invoked once to generate the loop body for the given
+ * group id.
+ */
+void emitGroupRangeLoop(
+    llvm::IRBuilderBase &Bld, llvm::Function *GroupRangeWrapper,
+    const std::array<llvm::Value *, 3> &NumGroups,
+    llvm::function_ref<void(llvm::IRBuilderBase &, const std::array<llvm::Value *, 3> &)>
+        EmitBody) {
+  auto &Ctx = GroupRangeWrapper->getContext();
+  auto SizeT = NumGroups[0]->getType();
+
+  llvm::Value *Begin = GroupRangeWrapper->getArg(2);
+  llvm::Value *End = GroupRangeWrapper->getArg(3);
+
+  auto BeginYZ = Bld.CreateUDiv(Begin, NumGroups[0]);
+  std::array<llvm::Value *, 3> BeginIds{Bld.CreateURem(Begin, NumGroups[0]),
+                                        Bld.CreateURem(BeginYZ, NumGroups[1]),
+                                        Bld.CreateUDiv(BeginYZ, NumGroups[1])};
+
+  auto EntryBB = Bld.GetInsertBlock();
+  auto LoopBB = llvm::BasicBlock::Create(Ctx, "group_loop", GroupRangeWrapper);
+  auto ExitBB = llvm::BasicBlock::Create(Ctx, "exit", GroupRangeWrapper);
+  Bld.CreateCondBr(Bld.CreateICmpULT(Begin, End), LoopBB, ExitBB);
+
+  Bld.SetInsertPoint(LoopBB);
+  auto Index = Bld.CreatePHI(SizeT, 2, "group");
+  const std::array<const char *, 3> GroupIdNames{"group_id_x", "group_id_y", "group_id_z"};
+  std::array<llvm::Value *, 3> GroupIds;
+  std::array<llvm::PHINode *, 3> GroupIdPhis;
+  for (int I = 0; I < 3; ++I) {
+    GroupIdPhis[I] = Bld.CreatePHI(SizeT, 2, GroupIdNames[I]);
+    GroupIdPhis[I]->addIncoming(BeginIds[I], EntryBB);
+    GroupIds[I] = GroupIdPhis[I];
+  }
+  Index->addIncoming(Begin, EntryBB);
+
+  EmitBody(Bld, GroupIds);
+
+  auto One = llvm::ConstantInt::get(SizeT, 1);
+  auto Zero = llvm::ConstantInt::get(SizeT, 0);
+  auto NextX = Bld.CreateAdd(GroupIds[0], One);
+  auto WrapX = Bld.CreateICmpEQ(NextX, NumGroups[0]);
+  auto NextY = Bld.CreateAdd(GroupIds[1], Bld.CreateZExt(WrapX, SizeT));
+  auto WrapY = Bld.CreateICmpEQ(NextY, NumGroups[1]);
+  auto NextZ = Bld.CreateAdd(GroupIds[2], Bld.CreateZExt(WrapY, SizeT));
+  auto NextIndex = Bld.CreateAdd(Index, One);
+
+  auto LatchBB = Bld.GetInsertBlock();
+  Index->addIncoming(NextIndex, LatchBB);
+  GroupIdPhis[0]->addIncoming(Bld.CreateSelect(WrapX, Zero, NextX), LatchBB);
+  GroupIdPhis[1]->addIncoming(Bld.CreateSelect(WrapY, Zero, NextY), LatchBB);
+  GroupIdPhis[2]->addIncoming(NextZ, LatchBB);
+  Bld.CreateCondBr(Bld.CreateICmpULT(NextIndex, End), LoopBB, ExitBB);
+
+  Bld.SetInsertPoint(ExitBB);
+  Bld.CreateRetVoid();
+}
+
 /*
  * This creates a wrapper function for a kernel function that takes the following arguments:
  * - A pointer to a struct containing {num_groups, group_id, local_size, local_mem_ptr}
@@ -91,19 +219,24 @@ void replaceUsesOfGVWith(llvm::Function &F, llvm::StringRef GlobalVarName, llvm:
  * wrapper.
  * This makes calling the kernel from the host code straighforward, as only the work group info
  * struct and the user arguments need to be passed to the wrapper.
+ *
+ * Additionally, a group range wrapper (kernel name + HostGroupRangeKernelSuffix) is created that
+ * takes two additional arguments Begin and End, and executes all groups with linear ids in
+ * [Begin, End). The group_id member of the work group info struct is ignored in this case.
+ * If InlineIntoGroupRange is set, the kernel is inlined into the loop over the groups, so that
+ * the argument loads are executed once per range and LLVM can optimize across groups. The
+ * single-group wrapper then just invokes the group range wrapper for one group. Otherwise, the
+ * group range wrapper invokes the single-group wrapper in a loop.
  */
-llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocalMemSize) {
+llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocalMemSize,
+                                    bool InlineIntoGroupRange) {
   auto M = F.getParent();
   auto &Ctx = M->getContext();
 
   llvm::IRBuilder<> Bld(&F.getEntryBlock());
 
   auto SizeT = M->getDataLayout().getLargestLegalIntType(Ctx);
-  auto WorkGroupInfoT =
-      llvm::StructType::get(llvm::ArrayType::get(SizeT, 3),                 // # groups
-                            llvm::ArrayType::get(SizeT, 3),                 // group id
-                            llvm::ArrayType::get(SizeT, 3),                 // local size
-                            llvm::PointerType::getUnqual(Bld.getInt8Ty())); // local memory size
+  auto WorkGroupInfoT = getWorkGroupInfoType(*M);
   auto VoidPtrT = llvm::PointerType::getUnqual(Bld.getInt8Ty());
   auto UserArgsT = llvm::PointerType::getUnqual(VoidPtrT);
 
@@ -114,17 +247,24 @@ llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocal
   std::string FName = F.getName().str();
   F.setName(FName + "_original");
 
-  auto WrapperT = llvm::FunctionType::get(Bld.getVoidTy(), ArgTypes, false);
-  auto Wrapper = llvm::cast<llvm::Function>(
-      M->getOrInsertFunction(FName, WrapperT, F.getAttributes()).getCallee());
-  Wrapper->setLinkage(llvm::GlobalValue::LinkageTypes::ExternalLinkage);
+  auto Wrapper = createWrapperDeclaration(F, FName, ArgTypes);
+
+  ArgTypes.push_back(SizeT); // first group
+  ArgTypes.push_back(SizeT); // end of group range
+  auto GroupRangeWrapper =
+      createWrapperDeclaration(F, FName + HostGroupRangeKernelSuffix, ArgTypes);
+
+  // The function containing the inlined kernel
+  llvm::Function *KernelBody = InlineIntoGroupRange ? GroupRangeWrapper : Wrapper;
 
   auto WrapperBB = llvm::BasicBlock::Create(Ctx, "entry", Wrapper);
-  Bld.SetInsertPoint(WrapperBB);
+  auto GroupRangeBB = llvm::BasicBlock::Create(Ctx, "entry", GroupRangeWrapper);
+  Bld.SetInsertPoint(InlineIntoGroupRange ? GroupRangeBB : WrapperBB);
+
   auto LoadFromContext = [&](int Array, int D, llvm::StringRef Name) {
     return Bld.CreateLoad(
         SizeT,
-        Bld.CreateInBoundsGEP(WorkGroupInfoT, Wrapper->getArg(0),
+        Bld.CreateInBoundsGEP(WorkGroupInfoT, Bld.GetInsertBlock()->getParent()->getArg(0),
                               {Bld.getInt64(0), Bld.getInt32(Array), Bld.getInt32(D)}),
         Name);
   };
@@ -133,11 +273,6 @@ llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocal
   NumGroups[1] = LoadFromContext(0, 1, "num_groups_y");
   NumGroups[2] = LoadFromContext(0, 2, "num_groups_z");
 
-  std::array<llvm::Value *, 3> GroupIds;
-  GroupIds[0] = LoadFromContext(1, 0, "group_id_x");
-  GroupIds[1] = LoadFromContext(1, 1, "group_id_y");
-  GroupIds[2] = LoadFromContext(1, 2, "group_id_z");
-
   std::array<llvm::Value *, 3> LocalSize;
   LocalSize[0] = LoadFromContext(2, 0, "local_size_x");
   LocalSize[1] = LoadFromContext(2, 1, "local_size_y");
@@ -145,7 +280,8 @@ llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocal
 
   auto LocalMemPtr = Bld.CreateLoad(
       VoidPtrT,
-      Bld.CreateInBoundsGEP(WorkGroupInfoT, Wrapper->getArg(0), {Bld.getInt64(0), Bld.getInt32(3)}),
+      Bld.CreateInBoundsGEP(WorkGroupInfoT, KernelBody->getArg(0),
+                            {Bld.getInt64(0), Bld.getInt32(3)}),
       "local_mem_ptr");
 
   if (DynamicLocalMemSize >= 0)
@@ -153,39 +289,86 @@ llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocal
         llvm::LLVMContext::MD_dereferenceable,
         llvm::MDNode::get(Ctx, {llvm::ConstantAsMetadata::get(Bld.getInt64(DynamicLocalMemSize))}));
 
-  llvm::SmallVector<llvm::Value *> Args;
-
-  auto ArgArray = Wrapper->arg_begin() + 1;
-  for (int I = 0; I < F.arg_size(); ++I) {
+  auto Args = loadKernelArgs(Bld, F, KernelBody->getArg(1));
+
+  // Scratch memory for the group collectives of the host libkernel
+  // (see sscp/builtins/host/collectives.hpp): an input and an output slot per
+  // work item. It is allocated once per invocation, so each thread executing
+  // work groups gets its own copy.
+  llvm::Value *CollectiveScratch = nullptr;
+  if (hasLoadsOfGV(F, cbs::SscpCollectiveScratchPtrName)) {
+    auto SlotSize = llvm::ConstantInt::get(SizeT, CollectiveScratchSlotSize);
+    auto NumItems = Bld.CreateMul(LocalSize[0], Bld.CreateMul(LocalSize[1], LocalSize[2]));
+    auto ScratchSize = Bld.CreateMul(SlotSize, Bld.CreateShl(NumItems, 1));
+    auto Scratch = Bld.CreateAlloca(Bld.getInt8Ty(), ScratchSize, "collective_scratch");
+    Scratch->setAlignment(llvm::Align(CollectiveScratchAlignment));
+    CollectiveScratch = Scratch;
+  }
 
-    if IS_OPAQUE(ArgArray->getType()) {
-      auto GEP = Bld.CreateInBoundsGEP(UserArgsT, ArgArray,
-                                       llvm::ArrayRef<llvm::Value *>{Bld.getInt32(I)});
-      Args.push_back(Bld.CreateLoad(F.getArg(I)->getType(), Bld.CreateLoad(VoidPtrT, GEP)));
-    } else {
-#if HAS_TYPED_PTR // otherwise, IS_OPAQUE is always true
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-      auto GEP = Bld.CreateInBoundsGEP(UserArgsT->getNonOpaquePointerElementType(), ArgArray,
-                                       llvm::ArrayRef<llvm::Value *>{Bld.getInt32(I)});
-#pragma GCC diagnostic pop
-      auto CastedPtr = Bld.CreatePointerCast(Bld.CreateLoad(VoidPtrT, GEP),
-                                             llvm::PointerType::getUnqual(F.getArg(I)->getType()));
-      Args.push_back(Bld.CreateLoad(F.getArg(I)->getType(), CastedPtr));
-#endif
+  std::array<llvm::Value *, 3> GroupIds;
+  llvm::CallInst *FCall = nullptr;
+  if (InlineIntoGroupRange) {
+    emitGroupRangeLoop(Bld, GroupRangeWrapper, NumGroups,
+                       [&](llvm::IRBuilderBase &Bld, const std::array<llvm::Value *, 3> &Ids) {
+                         GroupIds = Ids;
+                         FCall = Bld.CreateCall(&F, Args);
+                       });
+
+    // Single group: Forward to the group range wrapper
+    Bld.SetInsertPoint(WrapperBB);
+    std::array<llvm::Value *, 3> WrapperNumGroups;
+    std::array<llvm::Value *, 3> WrapperGroupIds;
+    for (int I = 0; I < 3; ++I) {
+      WrapperNumGroups[I] = LoadFromContext(0, I, "num_groups");
+      WrapperGroupIds[I] = LoadFromContext(1, I, "group_id");
     }
+    auto LinearId = Bld.CreateAdd(
+        WrapperGroupIds[0],
+        Bld.CreateMul(WrapperNumGroups[0],
+                      Bld.CreateAdd(WrapperGroupIds[1],
+                                    Bld.CreateMul(WrapperNumGroups[1], WrapperGroupIds[2]))));
+    Bld.CreateCall(GroupRangeWrapper,
+                   {Wrapper->getArg(0), Wrapper->getArg(1), LinearId,
+                    Bld.CreateAdd(LinearId, llvm::ConstantInt::get(SizeT, 1))});
+    Bld.CreateRetVoid();
+  } else {
+    GroupIds[0] = LoadFromContext(1, 0, "group_id_x");
+    GroupIds[1] = LoadFromContext(1, 1, "group_id_y");
+    GroupIds[2] = LoadFromContext(1, 2, "group_id_z");
+
+    FCall = Bld.CreateCall(&F, Args);
+    Bld.CreateRetVoid();
+
+    // Group range: Invoke the single group wrapper with a private copy of the
+    // work group info, in which the group id is updated for each group.
+    Bld.SetInsertPoint(GroupRangeBB);
+    auto Info = Bld.CreateAlloca(WorkGroupInfoT, nullptr, "work_group_info");
+    Bld.CreateStore(Bld.CreateLoad(WorkGroupInfoT, GroupRangeWrapper->getArg(0)), Info);
+    std::array<llvm::Value *, 3> RangeNumGroups;
+    for (int I = 0; I < 3; ++I)
+      RangeNumGroups[I] = LoadFromContext(0, I, "num_groups");
+
+    emitGroupRangeLoop(
+        Bld, GroupRangeWrapper, RangeNumGroups,
+        [&](llvm::IRBuilderBase &Bld, const std::array<llvm::Value *, 3> &Ids) {
+          for (int I = 0; I < 3; ++I)
+            Bld.CreateStore(Ids[I], Bld.CreateInBoundsGEP(WorkGroupInfoT, Info,
+                                                          {Bld.getInt64(0), Bld.getInt32(1),
+                                                           Bld.getInt32(I)}));
+          Bld.CreateCall(Wrapper, {Info, GroupRangeWrapper->getArg(1)});
+        });
   }
-  auto FCall = Bld.CreateCall(&F, Args);
-  Bld.CreateRetVoid();
 
   utils::checkedInlineFunction(FCall, "HostKernelWrapperPass");
 
   for (int I = 0; I < 3; ++I) {
-    replaceUsesOfGVWith(*Wrapper, cbs::NumGroupsGlobalNames[I], NumGroups[I]);
-    replaceUsesOfGVWith(*Wrapper, cbs::GroupIdGlobalNames[I], GroupIds[I]);
-    replaceUsesOfGVWith(*Wrapper, cbs::LocalSizeGlobalNames[I], LocalSize[I]);
+    replaceUsesOfGVWith(*KernelBody, cbs::NumGroupsGlobalNames[I], NumGroups[I]);
+    replaceUsesOfGVWith(*KernelBody, cbs::GroupIdGlobalNames[I], GroupIds[I]);
+    replaceUsesOfGVWith(*KernelBody, cbs::LocalSizeGlobalNames[I], LocalSize[I]);
   }
-  replaceUsesOfGVWith(*Wrapper, cbs::SscpDynamicLocalMemoryPtrName, LocalMemPtr);
+  replaceUsesOfGVWith(*KernelBody, cbs::SscpDynamicLocalMemoryPtrName, LocalMemPtr);
+  if (CollectiveScratch)
+    replaceUsesOfGVWith(*KernelBody, cbs::SscpCollectiveScratchPtrName, CollectiveScratch);
 
   F.setLinkage(llvm::GlobalValue::LinkageTypes::InternalLinkage);
   F.replaceAllUsesWith(Wrapper);
@@ -204,10 +387,14 @@ llvm::PreservedAnalyses HostKernelWrapperPass::run(llvm::Function &F,
   if (!SAA || !SAA->isKernelFunc(&F))
     return llvm::PreservedAnalyses::all();
 
-  auto Wrapper = makeWrapperFunction(F, DynamicLocalMemSize);
+  // For small work groups, the per-group call overhead is significant compared to
+  // the work done by the group, so compile the loop over the groups together with the kernel.
+  bool InlineIntoGroupRange = KnownGroupSize > 0 && KnownGroupSize <= MaxGroupSizeForGroupRangeInlining;
+
+  auto Wrapper = makeWrapperFunction(F, DynamicLocalMemSize, InlineIntoGroupRange);
 
   HIPSYCL_DEBUG_INFO << "[SSCP][HostKernelWrapper] Created kernel wrapper: " << Wrapper->getName()
-                     << "\n";
+                     << (InlineIntoGroupRange ? " (inlined into group range)" : "") << "\n";
 
   return llvm::PreservedAnalyses::none();
 }
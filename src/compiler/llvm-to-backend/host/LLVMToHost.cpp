@@ -51,12 +51,22 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
+#include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/PassManager.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Program.h>
+#include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Target/TargetOptions.h>
+#include <llvm/MC/TargetRegistry.h>
+#if LLVM_VERSION_MAJOR < 17
+#include <llvm/MC/SubtargetFeature.h>
+#else
+#include <llvm/TargetParser/SubtargetFeature.h>
+#endif
 #if LLVM_VERSION_MAJOR < 16
 #include <llvm/ADT/Triple.h>
 #include <llvm/Support/Host.h>
@@ -68,6 +78,7 @@
 #include <cassert>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <vector>
@@ -75,6 +86,14 @@
 namespace hipsycl {
 namespace compiler {
 
+void initializeNativeTarget() {
+  static std::once_flag Flag;
+  std::call_once(Flag, []() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+  });
+}
+
 LLVMToHostTranslator::LLVMToHostTranslator(const std::vector<std::string> &KN)
     : LLVMToBackendTranslator{sycl::jit::backend::host, KN}, KernelNames{KN} {}
 
@@ -106,6 +125,37 @@ bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
   if (!this->linkBitcodeFile(M, BuiltinBitcodeFile))
     return false;
 
+  // The sub-group size is a JIT-time constant, such that sub-group builtins
+  // fold to plain lane arithmetic before CBS runs.
+  if (auto *SubGroupSizeGV = M.getGlobalVariable(cbs::SscpSubGroupSizeName)) {
+    SubGroupSizeGV->setInitializer(llvm::ConstantInt::get(
+        llvm::Type::getInt32Ty(M.getContext()), SubGroupSize));
+    SubGroupSizeGV->setConstant(true);
+    SubGroupSizeGV->setLinkage(llvm::GlobalValue::InternalLinkage);
+  }
+
+  // CBS can only synchronize entire work groups, so sub-group barriers become
+  // work-group barriers for sub-group sizes > 1. They are tagged such that
+  // SubCfgFormation can reject them in divergent control flow.
+  if (auto *SubGroupBarrier = M.getFunction(cbs::SubGroupBarrierIntrinsicName)) {
+    llvm::SmallVector<llvm::CallInst *, 8> Calls;
+    for (auto *U : SubGroupBarrier->users())
+      if (auto *CI = llvm::dyn_cast<llvm::CallInst>(U))
+        Calls.push_back(CI);
+
+    auto Barrier = M.getOrInsertFunction(cbs::BarrierIntrinsicName,
+                                         llvm::Type::getVoidTy(M.getContext()));
+    for (auto *CI : Calls) {
+      if (SubGroupSize > 1) {
+        auto *BarrierCall = llvm::CallInst::Create(Barrier, "", CI);
+        BarrierCall->setMetadata(MDKind::SubGroupBarrier, llvm::MDNode::get(M.getContext(), {}));
+      }
+      CI->eraseFromParent();
+    }
+    if (SubGroupBarrier->use_empty())
+      SubGroupBarrier->eraseFromParent();
+  }
+
   llvm::ModulePassManager MPM;
   PH.ModuleAnalysisManager->clear(); // for some reason we need to reset the analyses... otherwise
                                      // we get a crash at IPSCCP
@@ -117,16 +167,99 @@ bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
   registerCBSPipeline(MPM, hipsycl::compiler::OptLevel::O3, true);
 
   llvm::FunctionPassManager FPM;
-  FPM.addPass(HostKernelWrapperPass{KnownLocalMemSize});
+  std::int64_t KnownGroupSize = 0;
+  if (KnownGroupSizeX > 0 && KnownGroupSizeY > 0 && KnownGroupSizeZ > 0)
+    KnownGroupSize = static_cast<std::int64_t>(KnownGroupSizeX) * KnownGroupSizeY * KnownGroupSizeZ;
+  FPM.addPass(HostKernelWrapperPass{KnownLocalMemSize, KnownGroupSize});
   MPM.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(FPM)));
 
   MPM.run(M, *PH.ModuleAnalysisManager);
 
+  if (auto *MD = M.getNamedMetadata(cbs::DivergentSubGroupBarriersName)) {
+    for (auto *Op : MD->operands())
+      if (auto *KernelName = llvm::dyn_cast<llvm::MDString>(Op->getOperand(0)))
+        this->registerError("LLVMToHost: Kernel " + KernelName->getString().str() +
+                            " uses a sub-group barrier in divergent control flow, which is not "
+                            "supported with sub-group size " + std::to_string(SubGroupSize));
+    return false;
+  }
+
   return true;
 }
 
 bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule,
                                                     std::string &out) {
+  if(UseOutOfProcessCodegen)
+    return emitSharedLibraryWithClang(FlavoredModule, out);
+  return emitObjectInProcess(FlavoredModule, out);
+}
+
+bool LLVMToHostTranslator::emitObjectInProcess(llvm::Module &FlavoredModule,
+                                               std::string &out) {
+  initializeNativeTarget();
+
+  std::string Triple = FlavoredModule.getTargetTriple();
+  if(Triple.empty())
+    Triple = llvm::sys::getProcessTriple();
+
+  std::string Error;
+  const llvm::Target *Target = llvm::TargetRegistry::lookupTarget(Triple, Error);
+  if(!Target) {
+    this->registerError("LLVMToHost: Could not find target for triple " + Triple + ": " + Error);
+    return false;
+  }
+
+  // Equivalent of -march=native
+  llvm::SubtargetFeatures Features;
+  llvm::StringMap<bool> HostFeatures;
+  if(llvm::sys::getHostCPUFeatures(HostFeatures)) {
+    for(const auto &F : HostFeatures)
+      Features.AddFeature(F.first(), F.second);
+  }
+
+  llvm::TargetOptions Options;
+  std::unique_ptr<llvm::TargetMachine> TM{Target->createTargetMachine(
+      Triple, llvm::sys::getHostCPUName(), Features.getString(), Options, llvm::Reloc::PIC_,
+      {},
+#if LLVM_VERSION_MAJOR < 18
+      llvm::CodeGenOpt::Aggressive
+#else
+      llvm::CodeGenOptLevel::Aggressive
+#endif
+      )};
+  if(!TM) {
+    this->registerError("LLVMToHost: Could not construct target machine for " + Triple);
+    return false;
+  }
+
+  FlavoredModule.setTargetTriple(Triple);
+  FlavoredModule.setDataLayout(TM->createDataLayout());
+
+  HIPSYCL_DEBUG_INFO << "LLVMToHost: Generating object file in-process for "
+                     << Triple << ", CPU " << TM->getTargetCPU().str() << "\n";
+
+  llvm::SmallVector<char, 0> ObjectBuffer;
+  llvm::raw_svector_ostream ObjectStream{ObjectBuffer};
+
+  llvm::legacy::PassManager CodegenPM;
+  if (TM->addPassesToEmitFile(CodegenPM, ObjectStream, nullptr,
+#if LLVM_VERSION_MAJOR < 18
+                              llvm::CGFT_ObjectFile
+#else
+                              llvm::CodeGenFileType::ObjectFile
+#endif
+                              )) {
+    this->registerError("LLVMToHost: Target machine cannot emit object files");
+    return false;
+  }
+  CodegenPM.run(FlavoredModule);
+
+  out.assign(ObjectBuffer.begin(), ObjectBuffer.end());
+  return true;
+}
+
+bool LLVMToHostTranslator::emitSharedLibraryWithClang(llvm::Module &FlavoredModule,
+                                                      std::string &out) {
   auto InputFile = llvm::sys::fs::TempFile::create("hipsycl-sscp-host-%%%%%%.bc");
   auto OutputFile = llvm::sys::fs::TempFile::create("hipsycl-sscp-host-%%%%%%.so");
 
@@ -198,13 +331,30 @@ bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule
   return true;
 }
 
+bool LLVMToHostTranslator::applyBuildFlag(const std::string &Flag) {
+  if(Flag == "host-out-of-process-codegen") {
+    UseOutOfProcessCodegen = true;
+    return true;
+  }
+  return false;
+}
+
 bool LLVMToHostTranslator::applyBuildOption(const std::string &Option, const std::string &Value) {
+  if (Option == "host-sub-group-size") {
+    int Size = std::stoi(Value);
+    if (Size <= 0 || (Size & (Size - 1)) != 0) {
+      this->registerError("LLVMToHost: Sub-group size must be a power of two, but got " + Value);
+      return false;
+    }
+    SubGroupSize = static_cast<unsigned>(Size);
+    return true;
+  }
   return false;
 }
 
 bool LLVMToHostTranslator::isKernelAfterFlavoring(llvm::Function &F) {
   for (const auto &Name : KernelNames)
-    if (F.getName() == Name)
+    if (F.getName() == Name || F.getName() == Name + HostGroupRangeKernelSuffix)
       return true;
   return false;
 }
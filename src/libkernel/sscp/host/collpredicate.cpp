@@ -0,0 +1,73 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/sycl/libkernel/sscp/builtins/collpredicate.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/host/collectives.hpp"
+
+using namespace hipsycl::libkernel::sscp::host;
+
+using predicate_traits = arithmetic_op_traits<__hipsycl_uint8>;
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN
+bool __hipsycl_sscp_work_group_any(bool pred) {
+  return group_reduce<work_group_segment, predicate_traits>(
+      __hipsycl_sscp_algorithm_op::logical_or, pred);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN
+bool __hipsycl_sscp_sub_group_any(bool pred) {
+  if (get_sub_group_max_size() == 1)
+    return pred;
+  return group_reduce<sub_group_segment, predicate_traits>(
+      __hipsycl_sscp_algorithm_op::logical_or, pred);
+}
+
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN
+bool __hipsycl_sscp_work_group_all(bool pred) {
+  return group_reduce<work_group_segment, predicate_traits>(
+      __hipsycl_sscp_algorithm_op::logical_and, pred);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN
+bool __hipsycl_sscp_sub_group_all(bool pred) {
+  if (get_sub_group_max_size() == 1)
+    return pred;
+  return group_reduce<sub_group_segment, predicate_traits>(
+      __hipsycl_sscp_algorithm_op::logical_and, pred);
+}
+
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN
+bool __hipsycl_sscp_work_group_none(bool pred) {
+  return !__hipsycl_sscp_work_group_any(pred);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN
+bool __hipsycl_sscp_sub_group_none(bool pred) {
+  return !__hipsycl_sscp_sub_group_any(pred);
+}
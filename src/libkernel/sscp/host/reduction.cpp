@@ -0,0 +1,85 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/sycl/libkernel/sscp/builtins/reduction.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/host/collectives.hpp"
+
+using namespace hipsycl::libkernel::sscp::host;
+
+#define HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(group, segment, type_suffix, type,  \
+                                           traits)                             \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type                                         \
+      __hipsycl_sscp_##group##_reduce_##type_suffix(                           \
+          __hipsycl_sscp_algorithm_op op, type x) {                            \
+    return group_reduce<segment, traits>(op, x);                               \
+  }
+
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, i8, __hipsycl_int8,
+                                   arithmetic_op_traits<__hipsycl_int8>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, i16, __hipsycl_int16,
+                                   arithmetic_op_traits<__hipsycl_int16>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, i32, __hipsycl_int32,
+                                   arithmetic_op_traits<__hipsycl_int32>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, i64, __hipsycl_int64,
+                                   arithmetic_op_traits<__hipsycl_int64>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, u8, __hipsycl_uint8,
+                                   arithmetic_op_traits<__hipsycl_uint8>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, u16, __hipsycl_uint16,
+                                   arithmetic_op_traits<__hipsycl_uint16>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, u32, __hipsycl_uint32,
+                                   arithmetic_op_traits<__hipsycl_uint32>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, u64, __hipsycl_uint64,
+                                   arithmetic_op_traits<__hipsycl_uint64>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, f16, __hipsycl_f16,
+                                   half_op_traits)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, f32, __hipsycl_f32,
+                                   arithmetic_op_traits<__hipsycl_f32>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(work_group, work_group_segment, f64, __hipsycl_f64,
+                                   arithmetic_op_traits<__hipsycl_f64>)
+
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, i8, __hipsycl_int8,
+                                   arithmetic_op_traits<__hipsycl_int8>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, i16, __hipsycl_int16,
+                                   arithmetic_op_traits<__hipsycl_int16>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, i32, __hipsycl_int32,
+                                   arithmetic_op_traits<__hipsycl_int32>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, i64, __hipsycl_int64,
+                                   arithmetic_op_traits<__hipsycl_int64>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, u8, __hipsycl_uint8,
+                                   arithmetic_op_traits<__hipsycl_uint8>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, u16, __hipsycl_uint16,
+                                   arithmetic_op_traits<__hipsycl_uint16>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, u32, __hipsycl_uint32,
+                                   arithmetic_op_traits<__hipsycl_uint32>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, u64, __hipsycl_uint64,
+                                   arithmetic_op_traits<__hipsycl_uint64>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, f16, __hipsycl_f16,
+                                   half_op_traits)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, f32, __hipsycl_f32,
+                                   arithmetic_op_traits<__hipsycl_f32>)
+HIPSYCL_SSCP_HOST_DEFINE_REDUCTION(sub_group, sub_group_segment, f64, __hipsycl_f64,
+                                   arithmetic_op_traits<__hipsycl_f64>)
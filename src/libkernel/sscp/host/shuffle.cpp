@@ -0,0 +1,80 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/sycl/libkernel/sscp/builtins/shuffle.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/host/collectives.hpp"
+
+using namespace hipsycl::libkernel::sscp::host;
+
+// Source ids are relative to the group. Out-of-range ids, including those
+// that wrap around for shr, yield the work item's own value.
+#define HIPSYCL_SSCP_HOST_DEFINE_SHUFFLES(group, segment, type_suffix, type)   \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type                                         \
+      __hipsycl_sscp_##group##_shl_##type_suffix(type value,                   \
+          __hipsycl_uint32 delta) {                                            \
+    return group_shuffle<segment>(                                             \
+        value, [=](__hipsycl_uint64 lid, __hipsycl_uint64) {                   \
+          return lid + delta;                                                  \
+        });                                                                    \
+  }                                                                            \
+                                                                               \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type                                         \
+      __hipsycl_sscp_##group##_shr_##type_suffix(type value,                   \
+          __hipsycl_uint32 delta) {                                            \
+    return group_shuffle<segment>(                                             \
+        value, [=](__hipsycl_uint64 lid, __hipsycl_uint64) {                   \
+          return lid - delta;                                                  \
+        });                                                                    \
+  }                                                                            \
+                                                                               \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type                                         \
+      __hipsycl_sscp_##group##_permute_##type_suffix(type value,               \
+          __hipsycl_int32 mask) {                                              \
+    return group_shuffle<segment>(                                             \
+        value, [=](__hipsycl_uint64 lid, __hipsycl_uint64) {                   \
+          return lid ^ static_cast<__hipsycl_uint64>(mask);                    \
+        });                                                                    \
+  }                                                                            \
+                                                                               \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type                                         \
+      __hipsycl_sscp_##group##_select_##type_suffix(type value,                \
+          __hipsycl_int32 id) {                                                \
+    return group_shuffle<segment>(                                             \
+        value, [=](__hipsycl_uint64 lid, __hipsycl_uint64) {                   \
+          return static_cast<__hipsycl_uint64>(id);                            \
+        });                                                                    \
+  }
+
+HIPSYCL_SSCP_HOST_DEFINE_SHUFFLES(work_group, work_group_segment, i8, __hipsycl_int8)
+HIPSYCL_SSCP_HOST_DEFINE_SHUFFLES(work_group, work_group_segment, i16, __hipsycl_int16)
+HIPSYCL_SSCP_HOST_DEFINE_SHUFFLES(work_group, work_group_segment, i32, __hipsycl_int32)
+HIPSYCL_SSCP_HOST_DEFINE_SHUFFLES(work_group, work_group_segment, i64, __hipsycl_int64)
+
+HIPSYCL_SSCP_HOST_DEFINE_SHUFFLES(sub_group, sub_group_segment, i8, __hipsycl_int8)
+HIPSYCL_SSCP_HOST_DEFINE_SHUFFLES(sub_group, sub_group_segment, i16, __hipsycl_int16)
+HIPSYCL_SSCP_HOST_DEFINE_SHUFFLES(sub_group, sub_group_segment, i32, __hipsycl_int32)
+HIPSYCL_SSCP_HOST_DEFINE_SHUFFLES(sub_group, sub_group_segment, i64, __hipsycl_int64)
@@ -27,30 +27,31 @@
 
 #include "hipSYCL/sycl/libkernel/sscp/builtins/subgroup.hpp"
 #include "hipSYCL/sycl/libkernel/sscp/builtins/core.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/host/collectives.hpp"
+
+using namespace hipsycl::libkernel::sscp::host;
+
+// Sub-groups are formed by get_sub_group_max_size() consecutive work items
+// in linear local id order. The last sub-group may be incomplete.
 
 HIPSYCL_SSCP_BUILTIN __hipsycl_uint32 __hipsycl_sscp_get_subgroup_local_id() {
-  return 0;
+  return get_local_linear_id() & (get_sub_group_max_size() - 1);
 }
 
 HIPSYCL_SSCP_BUILTIN __hipsycl_uint32 __hipsycl_sscp_get_subgroup_size() {
-  return 1;
+  const __hipsycl_uint64 lid = get_local_linear_id();
+  return sub_group_segment::end(lid) - sub_group_segment::begin(lid);
 }
 
 HIPSYCL_SSCP_BUILTIN __hipsycl_uint32 __hipsycl_sscp_get_subgroup_max_size() {
-  return 1;
+  return get_sub_group_max_size();
 }
 
 HIPSYCL_SSCP_BUILTIN __hipsycl_uint32 __hipsycl_sscp_get_subgroup_id() {
-  size_t local_tid =
-      __hipsycl_sscp_get_local_id_x() +
-      __hipsycl_sscp_get_local_id_y() * (__hipsycl_sscp_get_local_size_x() +
-      __hipsycl_sscp_get_local_id_z() * __hipsycl_sscp_get_local_size_x());
-  return local_tid;
+  return get_local_linear_id() / get_sub_group_max_size();
 }
 
 HIPSYCL_SSCP_BUILTIN __hipsycl_uint32 __hipsycl_sscp_get_num_subgroups() {
-  auto wg_size = __hipsycl_sscp_get_local_size_x() *
-                 __hipsycl_sscp_get_local_size_y() *
-                 __hipsycl_sscp_get_local_size_z();
-  return wg_size;
+  const __hipsycl_uint64 sub_group_size = get_sub_group_max_size();
+  return (get_local_linear_range() + sub_group_size - 1) / sub_group_size;
 }
@@ -26,15 +26,62 @@
  */
 
 #include "hipSYCL/runtime/adaptivity_engine.hpp"
+#include "hipSYCL/runtime/allocation_tracker.hpp"
 #include "hipSYCL/glue/kernel_configuration.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
 #include "hipSYCL/runtime/application.hpp"
 
 
+#include <algorithm>
+#include <cstring>
+
 namespace hipsycl {
 namespace rt {
 
-kernel_adaptivity_engine::kernel_adaptivity_engine(hcf_object_id hcf_object,
+kernel_argument_value_tracker &kernel_argument_value_tracker::get() {
+  static kernel_argument_value_tracker tracker;
+  return tracker;
+}
+
+void kernel_argument_value_tracker::register_launch(
+    const hcf_kernel_info *kernel, const std::vector<uint64_t> &values,
+    const std::vector<bool> &is_candidate, std::size_t launch_threshold,
+    std::vector<bool> &is_invariant_out) {
+
+  is_invariant_out.assign(values.size(), false);
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto& arguments = _arguments[kernel];
+  if(arguments.size() != values.size())
+    arguments.resize(values.size());
+
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    if(!is_candidate[i])
+      continue;
+
+    argument_state& state = arguments[i];
+    if(state.num_launches_with_current_value > 0 &&
+       state.current_value == values[i]) {
+      ++state.num_launches_with_current_value;
+    } else {
+      state.current_value = values[i];
+      state.num_launches_with_current_value = 1;
+      state.is_current_value_specialized = false;
+    }
+
+    if (!state.is_current_value_specialized &&
+        state.num_launches_with_current_value >= launch_threshold &&
+        state.num_specialized_values < max_specialized_values_per_argument) {
+      state.is_current_value_specialized = true;
+      ++state.num_specialized_values;
+    }
+
+    is_invariant_out[i] = state.is_current_value_specialized;
+  }
+}
+
+kernel_adaptivity_engine::kernel_adaptivity_engine(device_id dev,
+                                     hcf_object_id hcf_object,
                                      const std::string &backend_kernel_name,
                                      const hcf_kernel_info* kernel_info,
                                      const range<3> &num_groups,
@@ -42,7 +89,7 @@ kernel_adaptivity_engine::kernel_adaptivity_engine(hcf_object_id hcf_object,
                                      std::size_t *arg_sizes,
                                      std::size_t num_args,
                                      std::size_t local_mem_size)
-    : _hcf{hcf_object}, _kernel_name{backend_kernel_name}, _kernel_info{kernel_info},
+    : _dev{dev}, _hcf{hcf_object}, _kernel_name{backend_kernel_name}, _kernel_info{kernel_info},
       _num_groups{num_groups}, _block_size{block_size}, _args{args},
       _arg_sizes{arg_sizes}, _num_args{num_args}, _local_mem_size(local_mem_size) {
 
@@ -75,11 +122,155 @@ kernel_adaptivity_engine::finalize_binary_configuration(
     // Hard-code local memory size into the JIT binary
     config.set_build_option(glue::kernel_build_option::known_local_mem_size,
                             _local_mem_size);
+
+    specialize_kernel_arguments(config);
+    // Pointer properties change with every allocation, so specializing
+    // for them can cause many JIT compilations.
+    if(_adaptivity_level > 1)
+      infer_pointer_properties(config);
   }
 
   return config.generate_id();
 }
 
+bool kernel_adaptivity_engine::get_launch_fingerprint(
+    const glue::kernel_configuration::id_type &config_id,
+    glue::kernel_configuration::id_type &out) {
+  // The argument value tracker needs to see every launch
+  if(_adaptivity_level > 1)
+    return false;
+
+  out = config_id;
+  if(_adaptivity_level > 0) {
+    // Everything that finalize_binary_configuration() adds only depends on
+    // the launch parameters, so the id of the additions alone, combined with
+    // the id of the original configuration, identifies the result.
+    static thread_local glue::kernel_configuration additions;
+    additions.clear();
+    finalize_binary_configuration(additions);
+    glue::kernel_configuration::extend_hash(out, additions.generate_id(),
+                                            uint64_t{0});
+  }
+  return true;
+}
+
+void kernel_adaptivity_engine::specialize_kernel_arguments(
+    glue::kernel_configuration &config) {
+  std::size_t num_params = _kernel_info->get_num_parameters();
+
+  std::vector<uint64_t> values(num_params, 0);
+  std::vector<bool> is_candidate(num_params, false);
+  std::vector<bool> is_specialized(num_params, false);
+
+  for(std::size_t i = 0; i < num_params; ++i) {
+    auto type = _kernel_info->get_argument_type(i);
+    std::size_t arg_size = _kernel_info->get_argument_size(i);
+    std::size_t arg_index = _kernel_info->get_original_argument_index(i);
+
+    // Only scalars can be baked into the binary. Pointers typically change
+    // with every allocation.
+    if(type != hcf_kernel_info::integer &&
+       type != hcf_kernel_info::floating_point)
+      continue;
+    if(arg_size > sizeof(uint64_t) || arg_index >= _num_args)
+      continue;
+
+    const char *arg_data = static_cast<const char *>(_args[arg_index]) +
+                           _kernel_info->get_argument_offset(i);
+    std::memcpy(&values[i], arg_data, arg_size);
+    is_candidate[i] = true;
+
+    // Arguments that the user explicitly asked to be specialized are
+    // always specialized.
+    for(auto annotation : _kernel_info->get_known_annotations(i))
+      if(annotation == hcf_kernel_info::specialized)
+        is_specialized[i] = true;
+  }
+
+  // Automatic detection of invariant arguments
+  if(_adaptivity_level > 1) {
+    std::vector<bool> is_invariant;
+    kernel_argument_value_tracker::get().register_launch(
+        _kernel_info, values, is_candidate,
+        application::get_settings()
+            .get<setting::argument_specialization_threshold>(),
+        is_invariant);
+
+    for(std::size_t i = 0; i < num_params; ++i)
+      if(is_invariant[i])
+        is_specialized[i] = true;
+  }
+
+  for(std::size_t i = 0; i < num_params; ++i) {
+    if(is_candidate[i] && is_specialized[i])
+      config.set_specialized_kernel_argument(static_cast<int>(i), values[i]);
+  }
+}
+
+void kernel_adaptivity_engine::infer_pointer_properties(
+    glue::kernel_configuration &config) {
+  // Larger alignments are not expected to enable additional optimizations,
+  // but would cause more distinct binaries.
+  constexpr uint64_t max_inferred_alignment = 64;
+
+  std::size_t num_params = _kernel_info->get_num_parameters();
+
+  std::vector<std::pair<int, const void *>> pointer_allocations;
+  bool are_all_allocations_known = true;
+  bool has_by_value_aggregates = false;
+
+  for(std::size_t i = 0; i < num_params; ++i) {
+    auto type = _kernel_info->get_argument_type(i);
+    std::size_t arg_index = _kernel_info->get_original_argument_index(i);
+
+    // Aggregates passed by value might contain pointers that we cannot see
+    if(type == hcf_kernel_info::other)
+      has_by_value_aggregates = true;
+
+    if(type != hcf_kernel_info::pointer || arg_index >= _num_args ||
+       _kernel_info->get_argument_size(i) != sizeof(void *))
+      continue;
+
+    const void *ptr = nullptr;
+    const char *arg_data = static_cast<const char *>(_args[arg_index]) +
+                           _kernel_info->get_argument_offset(i);
+    std::memcpy(&ptr, arg_data, sizeof(void *));
+    if(!ptr)
+      continue;
+
+    uint64_t address = reinterpret_cast<uintptr_t>(ptr);
+    // Lowest set bit is the largest power of two dividing the address
+    uint64_t alignment =
+        std::min(address & (~address + 1), max_inferred_alignment);
+    config.set_known_alignment(static_cast<int>(i),
+                               static_cast<int>(alignment));
+
+    const void *allocation_base = nullptr;
+    std::size_t allocation_size = 0;
+    if(allocation_tracker::query_allocation(_dev, ptr, allocation_base,
+                                            allocation_size))
+      pointer_allocations.push_back(
+          std::make_pair(static_cast<int>(i), allocation_base));
+    else
+      are_all_allocations_known = false;
+  }
+
+  // Pointers into distinct allocations cannot alias. This is only safe
+  // if we know about all pointers that the kernel receives.
+  if(are_all_allocations_known && !has_by_value_aggregates) {
+    for(const auto& current : pointer_allocations) {
+      bool shares_allocation = false;
+      for(const auto& other : pointer_allocations)
+        if(other.first != current.first && other.second == current.second)
+          shares_allocation = true;
+
+      if(!shares_allocation)
+        config.set_kernel_param_flag(current.first,
+                                     glue::kernel_param_flag::noalias);
+    }
+  }
+}
+
 std::string kernel_adaptivity_engine::select_image_and_kernels(std::vector<std::string>* kernel_names_out){
   if(_adaptivity_level > 0) {
     *kernel_names_out = std::vector{_kernel_name};
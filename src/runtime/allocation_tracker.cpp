@@ -0,0 +1,104 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/allocation_tracker.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+
+#include <mutex>
+
+namespace hipsycl {
+namespace rt {
+
+allocation_tracker::allocation_tracker()
+    : _is_enabled{
+          application::get_settings().get<setting::adaptivity_level>() >= 2} {}
+
+allocation_tracker &allocation_tracker::get() {
+  static allocation_tracker tracker;
+  return tracker;
+}
+
+bool allocation_tracker::is_enabled() {
+  return get()._is_enabled;
+}
+
+void allocation_tracker::register_allocation(device_id dev, const void *ptr,
+                                             std::size_t size) {
+  allocation_tracker &self = get();
+  if(!self._is_enabled || !ptr)
+    return;
+  // Zero-sized allocations may still have to be distinguishable
+  if(size == 0)
+    size = 1;
+
+  std::unique_lock<std::shared_mutex> lock{self._mutex};
+  self._allocations[make_key(dev, reinterpret_cast<uintptr_t>(ptr))] = size;
+}
+
+void allocation_tracker::unregister_allocation(device_id dev,
+                                               const void *ptr) {
+  allocation_tracker &self = get();
+  if(!self._is_enabled || !ptr)
+    return;
+
+  std::unique_lock<std::shared_mutex> lock{self._mutex};
+  self._allocations.erase(make_key(dev, reinterpret_cast<uintptr_t>(ptr)));
+}
+
+bool allocation_tracker::query_allocation(device_id dev, const void *ptr,
+                                          const void *&base_out,
+                                          std::size_t &size_out) {
+  allocation_tracker &self = get();
+  if(!self._is_enabled)
+    return false;
+
+  uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+  std::shared_lock<std::shared_mutex> lock{self._mutex};
+
+  // First allocation with base address > ptr
+  auto it = self._allocations.upper_bound(make_key(dev, address));
+  if(it == self._allocations.begin())
+    return false;
+  --it;
+
+  // Allocations of other devices are not relevant
+  if(std::get<0>(it->first) != dev.get_backend() ||
+     std::get<1>(it->first) != dev.get_id())
+    return false;
+
+  uintptr_t base = std::get<2>(it->first);
+  if(address - base >= it->second)
+    return false;
+
+  base_out = reinterpret_cast<const void *>(base);
+  size_out = it->second;
+  return true;
+}
+
+}
+}
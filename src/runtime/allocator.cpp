@@ -0,0 +1,63 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/allocation_tracker.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+void *backend_allocator::allocate(size_t min_alignment, size_t size_bytes) {
+  void *ptr = raw_allocate(min_alignment, size_bytes);
+  if(allocation_tracker::is_enabled())
+    allocation_tracker::register_allocation(get_device(), ptr, size_bytes);
+  return ptr;
+}
+
+void *backend_allocator::allocate_optimized_host(size_t min_alignment,
+                                                 size_t bytes) {
+  void *ptr = raw_allocate_optimized_host(min_alignment, bytes);
+  if(allocation_tracker::is_enabled())
+    allocation_tracker::register_allocation(get_device(), ptr, bytes);
+  return ptr;
+}
+
+void backend_allocator::free(void *mem) {
+  if(allocation_tracker::is_enabled())
+    allocation_tracker::unregister_allocation(get_device(), mem);
+  raw_free(mem);
+}
+
+void *backend_allocator::allocate_usm(size_t bytes) {
+  void *ptr = raw_allocate_usm(bytes);
+  if(allocation_tracker::is_enabled())
+    allocation_tracker::register_allocation(get_device(), ptr, bytes);
+  return ptr;
+}
+
+}
+}
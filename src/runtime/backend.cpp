@@ -34,10 +34,44 @@
 #include "hipSYCL/runtime/kernel_cache.hpp"
 
 #include <algorithm>
+#include <exception>
+#include <thread>
 
 namespace hipsycl {
 namespace rt {
 
+result backend::jit_compile_recorded_configuration(
+    const common::hcf_container *hcf,
+    const recorded_kernel_configuration &entry,
+    std::string &binary_out) const {
+  return make_error(
+      __hipsycl_here(),
+      error_info{"backend: JIT compilation of recorded kernel configurations "
+                 "is not supported by backend " + get_name(),
+                 error_type::feature_not_supported});
+}
+
+namespace {
+
+void print_devices(backend *b) {
+  HIPSYCL_DEBUG_INFO << "Discovered devices from backend '" << b->get_name()
+                     << "': " << std::endl;
+  backend_hardware_manager* hw_manager = b->get_hardware_manager();
+  if(hw_manager->get_num_devices() == 0) {
+    HIPSYCL_DEBUG_INFO << "  <no devices>" << std::endl;
+  } else {
+    for(std::size_t i = 0; i < hw_manager->get_num_devices(); ++i){
+      hardware_context* hw = hw_manager->get_device(i);
+
+      HIPSYCL_DEBUG_INFO << "  device " << i << ": " << std::endl;
+      HIPSYCL_DEBUG_INFO << "    vendor: " << hw->get_vendor_name() << std::endl;
+      HIPSYCL_DEBUG_INFO << "    name: " << hw->get_device_name() << std::endl;
+    }
+  }
+}
+
+}
+
 backend_manager::backend_manager()
   : _hw_model(std::make_unique<hw_model>(this)),
     _kernel_cache{kernel_cache::get()}
@@ -45,40 +79,32 @@ backend_manager::backend_manager()
 
   _loader.query_backends();
 
+  const bool is_lazy =
+      application::get_settings().get<setting::lazy_backend_init>();
+
+  std::vector<backend_slot*> initial_backends;
   for (std::size_t backend_index = 0;
        backend_index < _loader.get_num_backends(); ++backend_index) {
+    auto id = backend_loader::get_backend_id(
+        _loader.get_backend_name(backend_index));
+    _backends.emplace_back(std::make_unique<backend_slot>(backend_index, id));
 
-    HIPSYCL_DEBUG_INFO << "Registering backend: '"
-                       << _loader.get_backend_name(backend_index) << "'..."
-                       << std::endl;
-    backend *b = _loader.create(backend_index);
-    if (b) {
-      _backends.emplace_back(std::unique_ptr<backend>(b));
-    } else {
-      HIPSYCL_DEBUG_ERROR << "backend_manager: Backend creation failed" << std::endl;
-    }
+    // We always need the CPU backend. Backends that we do not know
+    // cannot be looked up before they are created.
+    if (!is_lazy || !id.has_value() || id.value() == backend_id::omp)
+      initial_backends.push_back(_backends.back().get());
+    else
+      HIPSYCL_DEBUG_INFO << "Deferring initialization of backend: '"
+                         << _loader.get_backend_name(backend_index)
+                         << "' until it is needed" << std::endl;
   }
-  
-  this->for_each_backend([](backend *b) {
-    HIPSYCL_DEBUG_INFO << "Discovered devices from backend '" << b->get_name()
-                       << "': " << std::endl;
-    backend_hardware_manager* hw_manager = b->get_hardware_manager();
-    if(hw_manager->get_num_devices() == 0) {
-      HIPSYCL_DEBUG_INFO << "  <no devices>" << std::endl;
-    } else {
-      for(std::size_t i = 0; i < hw_manager->get_num_devices(); ++i){
-        hardware_context* hw = hw_manager->get_device(i);
-
-        HIPSYCL_DEBUG_INFO << "  device " << i << ": " << std::endl;
-        HIPSYCL_DEBUG_INFO << "    vendor: " << hw->get_vendor_name() << std::endl;
-        HIPSYCL_DEBUG_INFO << "    name: " << hw->get_device_name() << std::endl;
-      }
-    }
-  });
+
+  initialize_backends(initial_backends);
 
   if(std::none_of(_backends.cbegin(), _backends.cend(), 
-                  [](const std::unique_ptr<backend>& b){
-                    return b->get_hardware_platform() == hardware_platform::cpu;
+                  [](const std::unique_ptr<backend_slot>& slot){
+                    backend* b = slot->get_if_initialized();
+                    return b && b->get_hardware_platform() == hardware_platform::cpu;
                     }))
   {
     HIPSYCL_DEBUG_ERROR << "No CPU backend has been loaded. Terminating." << std::endl;
@@ -91,21 +117,119 @@ backend_manager::~backend_manager()
   _kernel_cache->unload();
 }
 
+void backend_manager::initialize_backends(
+    const std::vector<backend_slot *> &slots) const {
+  std::lock_guard<std::mutex> lock{_initialization_mutex};
+
+  std::vector<backend_slot *> pending;
+  for (backend_slot *slot : slots)
+    if (!slot->is_initialized())
+      pending.push_back(slot);
+
+  if (pending.empty())
+    return;
+
+  // Backend creation includes device enumeration, which may take a
+  // considerable amount of time for some backends. Backends are
+  // independent of each other, so they can be created concurrently.
+  std::vector<backend *> created(pending.size(), nullptr);
+  auto create = [&](std::size_t i) {
+    std::size_t loader_index = pending[i]->get_loader_index();
+    HIPSYCL_DEBUG_INFO << "Registering backend: '"
+                       << _loader.get_backend_name(loader_index) << "'..."
+                       << std::endl;
+    try {
+      created[i] = _loader.create(loader_index);
+    } catch (const std::exception &e) {
+      HIPSYCL_DEBUG_ERROR << "backend_manager: Backend creation threw: "
+                          << e.what() << std::endl;
+    }
+  };
+
+  if (pending.size() > 1 &&
+      application::get_settings().get<setting::parallel_backend_init>()) {
+    // The OpenMP backend sizes its thread pool according to the
+    // OpenMP settings of the creating thread, e.g. omp_set_num_threads()
+    // issued by the application, so it is created on the calling thread.
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < pending.size(); ++i)
+      if (pending[i]->get_expected_id() != backend_id::omp)
+        workers.emplace_back(create, i);
+    for (std::size_t i = 0; i < pending.size(); ++i)
+      if (pending[i]->get_expected_id() == backend_id::omp)
+        create(i);
+    for (auto &worker : workers)
+      worker.join();
+  } else {
+    for (std::size_t i = 0; i < pending.size(); ++i)
+      create(i);
+  }
+
+  for (std::size_t i = 0; i < pending.size(); ++i) {
+    if (created[i])
+      print_devices(created[i]);
+    else
+      HIPSYCL_DEBUG_ERROR << "backend_manager: Backend creation failed"
+                          << std::endl;
+    pending[i]->set_backend(std::unique_ptr<backend>(created[i]));
+  }
+
+  for (backend *b : created)
+    if (b)
+      for (const auto &listener : _initialization_listeners)
+        listener(b);
+}
+
+void backend_manager::initialize_all_backends() const {
+  std::vector<backend_slot *> slots;
+  for (const auto &slot : _backends)
+    if (!slot->is_initialized())
+      slots.push_back(slot.get());
+  if (!slots.empty())
+    initialize_backends(slots);
+}
+
 backend *backend_manager::get(backend_id id) const {
-  auto it = std::find_if(_backends.begin(), _backends.end(),
-                         [id](const std::unique_ptr<backend> &b) -> bool {
-                           return b->get_backend_descriptor().id == id;
-                         });
-  
-  if(it == _backends.end()){
-    register_error(
-        __hipsycl_here(),
-        error_info{"backend_manager: Requested backend is not available.",
-                   error_type::runtime_error});
-
-    return nullptr;
+  for (const auto &slot : _backends) {
+    if (!slot->is_initialized()) {
+      if (slot->get_expected_id() != id)
+        continue;
+      initialize_backends({slot.get()});
+    }
+
+    backend *b = slot->get_if_initialized();
+    if (b && b->get_backend_descriptor().id == id)
+      return b;
+  }
+
+  register_error(
+      __hipsycl_here(),
+      error_info{"backend_manager: Requested backend is not available.",
+                 error_type::runtime_error});
+
+  return nullptr;
+}
+
+backend *backend_manager::get_if_initialized(backend_id id) const {
+  for (const auto &slot : _backends) {
+    backend *b = slot->get_if_initialized();
+    if (b && b->get_backend_descriptor().id == id)
+      return b;
   }
-  return it->get();
+  return nullptr;
+}
+
+bool backend_manager::is_initialization_pending(backend_id id) const {
+  for (const auto &slot : _backends)
+    if (!slot->is_initialized() && slot->get_expected_id() == id)
+      return true;
+  return false;
+}
+
+void backend_manager::add_initialization_listener(
+    std::function<void(backend *)> listener) {
+  std::lock_guard<std::mutex> lock{_initialization_mutex};
+  _initialization_listeners.push_back(std::move(listener));
 }
 
 hw_model &backend_manager::hardware_model()
@@ -118,19 +118,25 @@ bool is_plugin_active(const std::string& name)
   if(name == "omp") // we always need a cpu backend
     return true;
 
-  hipsycl::rt::backend_id id;
-  if(name == "cuda") {
-    id = hipsycl::rt::backend_id::cuda;
-  } else if(name == "hip") {
-    id = hipsycl::rt::backend_id::hip;
-  } else if(name == "ze") {
-    id = hipsycl::rt::backend_id::level_zero;
-  } else if(name == "musa") {
-    id = hipsycl::rt::backend_id::musa;
-  } else if(name == "ocl") {
-    id = hipsycl::rt::backend_id::ocl;
-  }
-  return backends_active.find(id) != backends_active.cend();
+  auto id = hipsycl::rt::backend_loader::get_backend_id(name);
+  if(!id.has_value())
+    return false;
+  return backends_active.find(id.value()) != backends_active.cend();
+}
+
+// Plugins are named (lib)rt-backend-<name>. This allows us to skip loading
+// plugins of inactive backends, which can be expensive because of the
+// vendor libraries that they pull in.
+std::optional<std::string> get_plugin_name_from_filename(const fs::path& p) {
+  std::string stem = p.stem().string();
+  const std::string lib_prefix = "lib";
+  const std::string plugin_prefix = "rt-backend-";
+
+  if(stem.rfind(lib_prefix, 0) == 0)
+    stem = stem.substr(lib_prefix.size());
+  if(stem.rfind(plugin_prefix, 0) != 0)
+    return {};
+  return stem.substr(plugin_prefix.size());
 }
 
 }
@@ -165,6 +171,16 @@ void backend_loader::query_backends() {
       if(fs::is_regular_file(entry.status())){
         auto p = entry.path();
         if (p.extension().string() == shared_lib_extension) {
+          auto expected_name = get_plugin_name_from_filename(p);
+          if (expected_name.has_value() &&
+              (has_backend(expected_name.value()) ||
+               !is_plugin_active(expected_name.value()))) {
+            HIPSYCL_DEBUG_INFO << "backend_loader: Skipping plugin " << p
+                               << " of inactive or already loaded backend"
+                               << std::endl;
+            continue;
+          }
+
           std::string backend_name;
           void *handle;
           if (load_plugin(p.string(), handle, backend_name)) {
@@ -212,6 +228,24 @@ backend *backend_loader::create(std::size_t index) const {
   return create_backend(_handles[index].second);
 }
 
+std::optional<backend_id>
+backend_loader::get_backend_id(const std::string &name) {
+  if(name == "cuda") {
+    return backend_id::cuda;
+  } else if(name == "hip") {
+    return backend_id::hip;
+  } else if(name == "ze") {
+    return backend_id::level_zero;
+  } else if(name == "musa") {
+    return backend_id::musa;
+  } else if(name == "ocl") {
+    return backend_id::ocl;
+  } else if(name == "omp") {
+    return backend_id::omp;
+  }
+  return {};
+}
+
 backend *backend_loader::create(const std::string &name) const {
   
   for (std::size_t i = 0; i < _handles.size(); ++i) {
@@ -38,7 +38,7 @@ cuda_allocator::cuda_allocator(backend_descriptor desc, int cuda_device)
     : _backend_descriptor{desc}, _dev{cuda_device}
 {}
       
-void *cuda_allocator::allocate(size_t min_alignment, size_t size_bytes)
+void *cuda_allocator::raw_allocate(size_t min_alignment, size_t size_bytes)
 {
   void *ptr;
   cuda_device_manager::get().activate_device(_dev);
@@ -55,8 +55,8 @@ void *cuda_allocator::allocate(size_t min_alignment, size_t size_bytes)
   return ptr;
 }
 
-void *cuda_allocator::allocate_optimized_host(size_t min_alignment,
-                                             size_t bytes) {
+void *cuda_allocator::raw_allocate_optimized_host(size_t min_alignment,
+                                                 size_t bytes) {
   void *ptr;
   cuda_device_manager::get().activate_device(_dev);
 
@@ -72,7 +72,7 @@ void *cuda_allocator::allocate_optimized_host(size_t min_alignment,
   return ptr;
 }
 
-void cuda_allocator::free(void *mem) {
+void cuda_allocator::raw_free(void *mem) {
 
   pointer_info info;
   result query_result = query_pointer(mem, info);
@@ -96,7 +96,7 @@ void cuda_allocator::free(void *mem) {
   }
 }
 
-void * cuda_allocator::allocate_usm(size_t bytes)
+void * cuda_allocator::raw_allocate_usm(size_t bytes)
 {
   cuda_device_manager::get().activate_device(_dev);
   
@@ -113,6 +113,10 @@ void * cuda_allocator::allocate_usm(size_t bytes)
   return ptr;
 }
 
+device_id cuda_allocator::get_device() const {
+  return device_id{_backend_descriptor, _dev};
+}
+
 bool cuda_allocator::is_usm_accessible_from(backend_descriptor b) const
 {
   // TODO: Formulate this better - this assumes that either CUDA+CPU or
@@ -31,6 +31,13 @@
 #include "hipSYCL/runtime/cuda/cuda_event.hpp"
 #include "hipSYCL/runtime/cuda/cuda_queue.hpp"
 #include "hipSYCL/runtime/inorder_executor.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+#include "hipSYCL/compiler/llvm-to-backend/ptx/LLVMToPtxFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#endif
 
 
 HIPSYCL_PLUGIN_API_EXPORT
@@ -118,5 +125,17 @@ cuda_backend::create_inorder_executor(device_id dev, int priority) {
   return std::make_unique<inorder_executor>(std::move(q));
 }
 
+result cuda_backend::jit_compile_recorded_configuration(
+    const common::hcf_container *hcf,
+    const recorded_kernel_configuration &entry,
+    std::string &binary_out) const {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  return glue::jit::compile_recorded_configuration(
+      compiler::createLLVMToPtxTranslator, hcf, entry, binary_out);
+#else
+  return backend::jit_compile_recorded_configuration(hcf, entry, binary_out);
+#endif
+}
+
 }
 }
\ No newline at end of file
@@ -148,6 +148,36 @@ void add_to_data_users(dag_node_ptr node, const requirements_list& reqs)
   }
 }
 
+// Returns the device on which the requirement must be satisfied,
+// following the same logic as the scheduler.
+device_id get_requirement_target(const dag_node_ptr &req_node,
+                                 device_id default_device) {
+  if (req_node->get_execution_hints().has_hint<hints::bind_to_device>())
+    return req_node->get_execution_hints()
+        .get_hint<hints::bind_to_device>()
+        ->get_device_id();
+  return default_device;
+}
+
+// Checks whether the accessed range is already allocated and current
+// on the given device, such that no data transfer is needed.
+bool is_resident_on_device(buffer_memory_requirement *bmem_req,
+                           device_id dev) {
+  auto data = bmem_req->get_data_region();
+  if (!data->has_allocation(dev))
+    return false;
+
+  sycl::access::mode mode = bmem_req->get_access_mode();
+  if (mode == sycl::access::mode::discard_write ||
+      mode == sycl::access::mode::discard_read_write)
+    return true;
+
+  std::vector<range_store::rect> outdated_regions;
+  data->get_outdated_regions(dev, bmem_req->get_access_offset3d(),
+                             bmem_req->get_access_range3d(), outdated_regions);
+  return outdated_regions.empty();
+}
+
 }
 
 
@@ -158,46 +188,45 @@ class prefetch_operation;
 
 dag_builder::dag_builder(runtime *rt) : _rt{rt} {}
 
+// For a given requirement, checks for conflicts and adds any
+// conflicting operations as dependencies
+void dag_builder::add_conflicts_as_requirements(dag_node_ptr req_node) const {
+  if(req_node->get_operation()->is_requirement()){
+    auto* req = cast<requirement>(req_node->get_operation());
+
+    if(req->is_memory_requirement()){
+      auto* mem_req = cast<memory_requirement>(req);
+
+      if(mem_req->is_image_requirement())
+        assert(false && "dag_builder: Image requirements are unimplemented");
+      else {
+        auto* buff_req = cast<buffer_memory_requirement>(req);
+
+        data_user_tracker &user_tracker =
+            buff_req->get_data_region()->get_users();
+
+        user_tracker.for_each_potentially_conflicting_user(
+            buff_req->get_access_offset3d(), buff_req->get_access_range3d(),
+            buff_req->get_access_mode(), [&](data_user &user) {
+              auto user_ptr = user.user.lock();
+              if(user_ptr && is_conflicting_access(mem_req, user))
+              {
+                // No reason to take a dependency into account that is alreay completed
+                if(!user_ptr->is_known_complete())
+                  req_node->add_requirement(user_ptr);
+              }
+            });
+      }
+    }
+  }
+}
+
 dag_node_ptr dag_builder::build_node(std::unique_ptr<operation> op,
                                      const requirements_list& requirements,
                                      const execution_hints& hints)
 {
   assert(op);
 
-  // Calculate additional requirements:
-  // Iterate over all requirements and look for conflicting accesses
-
-  // For a given requirement, checks for conflicts and adds any
-  // conflicting operations as dependencies
-  auto add_conflicts_as_requirements = [&](dag_node_ptr req_node){
-    if(req_node->get_operation()->is_requirement()){
-      auto* req = cast<requirement>(req_node->get_operation());
-
-      if(req->is_memory_requirement()){
-        auto* mem_req = cast<memory_requirement>(req);
-
-        if(mem_req->is_image_requirement())
-          assert(false && "dag_builder: Image requirements are unimplemented");
-        else {
-          auto* buff_req = cast<buffer_memory_requirement>(req);
-
-          data_user_tracker &user_tracker =
-              buff_req->get_data_region()->get_users();
-
-          user_tracker.for_each_user([&](data_user &user) {
-            auto user_ptr = user.user.lock();
-            if(user_ptr && is_conflicting_access(mem_req, user))
-            {
-              // No reason to take a dependency into account that is alreay completed
-              if(!user_ptr->is_known_complete())
-                req_node->add_requirement(user_ptr);
-            }
-          });
-        }
-      }
-    }
-  };
-
   auto operation_node = std::make_shared<dag_node>(
       hints, requirements.get(), std::move(op), _rt);
   
@@ -253,6 +282,87 @@ dag_node_ptr dag_builder::add_explicit_mem_requirement(
   return add_command_group(std::move(req), requirements, hints);
 }
 
+dag_node_ptr
+dag_builder::build_instant_node(std::unique_ptr<operation> &op,
+                                const requirements_list &requirements,
+                                const execution_hints &hints) {
+  assert(op);
+  assert(hints.has_hint<hints::bind_to_device>());
+
+  device_id target_dev =
+      hints.get_hint<hints::bind_to_device>()->get_device_id();
+
+  // Holding the lock guarantees that no other node can be built
+  // concurrently that might miss this node as a data dependency.
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  // Check all requirements first - we must not modify any state
+  // if we end up not being able to use instant submission.
+  for (dag_node_ptr req_node : requirements.get()) {
+    if (!req_node->get_operation()->is_requirement())
+      continue;
+
+    auto *req = cast<requirement>(req_node->get_operation());
+    if (!req->is_memory_requirement())
+      return nullptr;
+    auto *mem_req = cast<memory_requirement>(req);
+    if (!mem_req->is_buffer_requirement())
+      return nullptr;
+    auto *bmem_req = cast<buffer_memory_requirement>(mem_req);
+
+    if (!is_resident_on_device(bmem_req,
+                               get_requirement_target(req_node, target_dev)))
+      return nullptr;
+
+    // Conflicting accesses that are still waiting in the DAG
+    // for submission cannot be synchronized with by the executor.
+    bool has_unsubmitted_conflict = false;
+    bmem_req->get_data_region()->get_users().for_each_potentially_conflicting_user(
+        bmem_req->get_access_offset3d(), bmem_req->get_access_range3d(),
+        bmem_req->get_access_mode(), [&](data_user &user) {
+          auto user_ptr = user.user.lock();
+          if (user_ptr && !user_ptr->is_submitted() &&
+              is_conflicting_access(mem_req, user))
+            has_unsubmitted_conflict = true;
+        });
+    if (has_unsubmitted_conflict)
+      return nullptr;
+  }
+
+  auto operation_node = std::make_shared<dag_node>(
+      hints, requirements.get(), std::move(op), _rt);
+
+  for (dag_node_ptr req_node : requirements.get()) {
+    if (!req_node->get_operation()->is_requirement())
+      continue;
+
+    auto *bmem_req =
+        cast<buffer_memory_requirement>(req_node->get_operation());
+    auto data = bmem_req->get_data_region();
+    device_id dev = get_requirement_target(req_node, target_dev);
+
+    req_node->assign_to_device(dev);
+    add_conflicts_as_requirements(req_node);
+
+    // Without DAG flushes, nobody else cleans up the user list.
+    data->get_users().release_dead_users();
+
+    bmem_req->initialize_device_data(data->get_memory(dev));
+    if (bmem_req->get_access_mode() == sycl::access::mode::read)
+      data->mark_range_valid(dev, bmem_req->get_access_offset3d(),
+                             bmem_req->get_access_range3d());
+    else
+      data->mark_range_current(dev, bmem_req->get_access_offset3d(),
+                               bmem_req->get_access_range3d());
+
+    req_node->mark_virtually_submitted();
+  }
+
+  add_to_data_users(operation_node, requirements);
+
+  return operation_node;
+}
+
 dag dag_builder::finish_and_reset()
 {
   std::lock_guard<std::mutex> lock{_mutex};
@@ -40,6 +40,9 @@
 #include "hipSYCL/runtime/generic/multi_event.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
 #include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/hw_model/hw_model.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -123,7 +126,8 @@ result ensure_allocation_exists(runtime *rt,
 }
 
 void for_each_explicit_operation(
-    dag_node_ptr node, std::function<void(operation *)> explicit_op_handler) {
+    runtime *rt, dag_node_ptr node,
+    std::function<void(operation *)> explicit_op_handler) {
   if (node->is_submitted())
     return;
   
@@ -157,16 +161,35 @@ void for_each_explicit_operation(
               return;
             }
 
-            // Just use first source for now:
-            memory_location src{update_sources[0].first,
-                                update_sources[0].second.first,
-                                bmem_req->get_data_region()};
+            std::vector<memory_location> candidate_sources;
+            candidate_sources.reserve(update_sources.size());
+            for (const auto &source : update_sources)
+              candidate_sources.emplace_back(source.first, source.second.first,
+                                             bmem_req->get_data_region());
             memory_location dest{target_device, region.first,
                                  bmem_req->get_data_region()};
-            std::unique_ptr<operation> op =
+
+            memcpy_model *model =
+                rt->backends().hardware_model().get_memcpy_model();
+            memory_location src =
+                model->choose_source(candidate_sources, dest, region.second);
+
+            auto memcpy_op =
                 std::make_unique<memcpy_operation>(src, dest, region.second);
+            const memcpy_operation *measured_op = nullptr;
+            if (application::get_settings()
+                    .get<setting::memcpy_model_online_measurement>()) {
+              node->get_execution_hints().set_hint(
+                  hints::request_instrumentation_start_timestamp{});
+              node->get_execution_hints().set_hint(
+                  hints::request_instrumentation_finish_timestamp{});
+              measured_op = memcpy_op.get();
+            }
+            std::unique_ptr<operation> op = std::move(memcpy_op);
 
             explicit_op_handler(op.get());
+            if (measured_op && node->is_submitted())
+              model->track_transfer(node, measured_op);
             /// TODO This has to be changed once we support multi-operation nodes
             node->assign_effective_operation(std::move(op));
           }
@@ -269,7 +292,7 @@ result submit_requirement(runtime* rt, dag_node_ptr req) {
                   bmem_req->get_access_range3d());
         });
     if(has_initialized_content){
-      for_each_explicit_operation(req, [&](operation *op) {
+      for_each_explicit_operation(rt, req, [&](operation *op) {
         if (!op->is_data_transfer()) {
           res = make_error(
               __hipsycl_here(),
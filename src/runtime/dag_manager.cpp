@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <mutex>
+#include <unordered_set>
 
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/runtime/application.hpp"
@@ -91,6 +92,9 @@ void dag_manager::flush_async()
       _worker([this, new_dag](){
         HIPSYCL_DEBUG_INFO << "dag_manager [async]: Flushing!" << std::endl;
         
+        // Many requirements of a DAG typically refer to the same data
+        // regions; only clean up each data region once.
+        std::unordered_set<buffer_data_region*> processed_data_regions;
         for(dag_node_ptr req : new_dag.get_memory_requirements()){
           assert_is<memory_requirement>(req->get_operation());
 
@@ -98,16 +102,16 @@ void dag_manager::flush_async()
               cast<memory_requirement>(req->get_operation());
 
           if(mreq->is_buffer_requirement()) {
-            
+            buffer_data_region *data =
+                cast<buffer_memory_requirement>(mreq)->get_data_region().get();
+            if(!processed_data_regions.insert(data).second)
+              continue;
+
             HIPSYCL_DEBUG_INFO
                 << "dag_manager [async]: Releasing dead users of data region "
-                << cast<buffer_memory_requirement>(mreq)->get_data_region().get()
-                << std::endl;
+                << data << std::endl;
 
-            cast<buffer_memory_requirement>(mreq)
-                ->get_data_region()
-                ->get_users()
-                .release_dead_users();
+            data->get_users().release_dead_users();
           }
           else
             assert(false && "Non-buffer requirements are unsupported");
@@ -126,7 +130,8 @@ void dag_manager::flush_async()
                 << std::endl;
           if(stype == scheduler_type::direct) {
             _direct_scheduler.submit(node);
-          } else if(stype == scheduler_type::unbound) {
+          } else if(stype == scheduler_type::unbound ||
+                    stype == scheduler_type::load_aware) {
             _unbound_scheduler.submit(node);
           }
         }
@@ -174,6 +179,22 @@ void dag_manager::register_submitted_ops(dag_node_ptr node) {
   this->_submitted_ops.update_with_submission(node);
 }
 
+dag_node_ptr
+dag_manager::build_instant_node(std::unique_ptr<operation> &op,
+                                const requirements_list &requirements,
+                                const execution_hints &hints) {
+  return builder()->build_instant_node(op, requirements, hints);
+}
+
+void dag_manager::register_instant_submission(dag_node_ptr node) {
+  this->register_submitted_ops(node);
+  // Instant submissions do not cause DAG flushes, so we need to
+  // trigger garbage collection here.
+  if (this->_submitted_ops.get_num_nodes() >
+      application::get_settings().get<setting::gc_trigger_batch_size>())
+    this->_submitted_ops.async_wait_and_unregister();
+}
+
 void dag_manager::trigger_flush_opportunity()
 {
   HIPSYCL_DEBUG_INFO << "dag_manager: Checking DAG flush opportunity..."
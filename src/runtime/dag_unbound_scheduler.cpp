@@ -34,27 +34,64 @@
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/hardware.hpp"
 
+#include "hipSYCL/runtime/instrumentation.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/hw_model/hw_model.hpp"
+
+#include <limits>
+
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+// Runtime that is assumed for operations without measurements
+constexpr double default_runtime_ns = 10000.0;
+// Weight of new measurements in the running runtime estimates
+constexpr double runtime_estimate_decay = 0.2;
+// Upper bound of kernels waiting for their runtime to be measured
+constexpr std::size_t max_pending_measurements = 256;
+
+bool requests_timestamps(const dag_node_ptr& node) {
+  const execution_hints& hints = node->get_execution_hints();
+  return hints.has_hint<hints::request_instrumentation_start_timestamp>() &&
+         hints.has_hint<hints::request_instrumentation_finish_timestamp>();
+}
+
+const std::string* get_kernel_name(const dag_node_ptr& node) {
+  operation* op = node->get_operation();
+  if(op->is_requirement() || op->is_data_transfer() ||
+     !dynamic_is<kernel_operation>(op))
+    return nullptr;
+  return &cast<kernel_operation>(op)->get_global_kernel_name();
+}
+
+}
+
 dag_unbound_scheduler::dag_unbound_scheduler(runtime* rt)
 : _direct_scheduler{rt}, _rt{rt} {}
 
 void dag_unbound_scheduler::submit(dag_node_ptr node) {
-  if(_devices.empty()) {
-    // We cannot query this in the constructor, because
-    // when schedulers are constructed the runtime is typically
-    // locked because it is just starting up, so this would
-    // create a deadlock
-    _rt->backends().for_each_backend([this](backend *b) {
-      std::size_t num_devs = b->get_hardware_manager()->get_num_devices();
-      for (std::size_t i = 0; i < num_devs; ++i) {
-        this->_devices.push_back(b->get_hardware_manager()->get_device_id(i));
-      }
-    });
-  }
-
   if(!node->get_execution_hints().has_hint<hints::bind_to_device>()){
+    // Only enumerate devices once an operation actually needs to be
+    // scheduled, since this initializes all backends that are
+    // initialized lazily.
+    if(_devices.empty()) {
+      // We cannot query this in the constructor, because
+      // when schedulers are constructed the runtime is typically
+      // locked because it is just starting up, so this would
+      // create a deadlock
+      _rt->backends().for_each_backend([this](backend *b) {
+        std::size_t num_devs = b->get_hardware_manager()->get_num_devices();
+        for (std::size_t i = 0; i < num_devs; ++i) {
+          this->_devices.push_back(b->get_hardware_manager()->get_device_id(i));
+        }
+      });
+      _device_loads.resize(_devices.size());
+      _average_runtimes.resize(_devices.size());
+    }
+
     std::vector<rt::device_id> eligible_devices;
     if(node->get_execution_hints().has_hint<hints::bind_to_device_group>()) {
       eligible_devices = node->get_execution_hints()
@@ -73,18 +110,206 @@ void dag_unbound_scheduler::submit(dag_node_ptr node) {
       node->cancel();
       return;
     }
-    // Round-robin as placeholder. This is not intended
-    // for anything practical, it's a _placeholder_
-    static std::size_t dev = 0;
-    ++dev;
 
-    rt::device_id target_dev = eligible_devices[dev % eligible_devices.size()];
+    rt::device_id target_dev;
+    if (application::get_settings().get<setting::scheduler_type>() ==
+        scheduler_type::load_aware) {
+      target_dev = select_load_aware(node, eligible_devices);
+    } else {
+      // Round-robin as placeholder. This is not intended
+      // for anything practical, it's a _placeholder_
+      ++_round_robin_counter;
+      target_dev =
+          eligible_devices[_round_robin_counter % eligible_devices.size()];
+    }
     node->get_execution_hints().set_hint(rt::hints::bind_to_device{target_dev});
   }
 
   _direct_scheduler.submit(node);
 }
 
+device_id dag_unbound_scheduler::select_load_aware(
+    dag_node_ptr node, const std::vector<device_id> &eligible_devices) {
+  process_kernel_measurements();
+
+  const std::string* kernel_name = get_kernel_name(node);
+
+  std::size_t best_index = 0;
+  double best_cost = std::numeric_limits<double>::max();
+  double best_runtime = default_runtime_ns;
+  for(const device_id& dev : eligible_devices) {
+    std::size_t idx = get_device_index(dev);
+    device_load& load = _device_loads[idx];
+    update_device_load(load);
+
+    double runtime = estimate_runtime_ns(
+        kernel_name ? *kernel_name : std::string{}, idx);
+    double cost = load.outstanding_runtime_ns +
+                  estimate_transfer_time_ns(node, dev) + runtime;
+
+    HIPSYCL_DEBUG_INFO << "dag_unbound_scheduler: Estimated cost for device "
+                       << dev.get_id() << " of backend "
+                       << static_cast<int>(dev.get_backend()) << ": " << cost
+                       << "ns (outstanding: " << load.outstanding_runtime_ns
+                       << "ns, runtime: " << runtime << "ns)" << std::endl;
+
+    if(cost < best_cost) {
+      best_cost = cost;
+      best_index = idx;
+      best_runtime = runtime;
+    }
+  }
+
+  device_load& load = _device_loads[best_index];
+  load.outstanding_nodes.push_back(outstanding_node{node, best_runtime});
+  load.outstanding_runtime_ns += best_runtime;
+
+  if (kernel_name && requests_timestamps(node) &&
+      _pending_measurements.size() < max_pending_measurements)
+    _pending_measurements.push_back(
+        kernel_measurement{node, *kernel_name, best_index});
+
+  return _devices[best_index];
 }
+
+double dag_unbound_scheduler::estimate_transfer_time_ns(dag_node_ptr node,
+                                                        device_id dev) const {
+  memcpy_model *model = _rt->backends().hardware_model().get_memcpy_model();
+
+  double transfer_time = 0.0;
+  std::vector<range_store::rect> outdated_regions;
+  std::vector<std::pair<device_id, range_store::rect>> update_sources;
+
+  for(const auto& weak_req : node->get_requirements()) {
+    dag_node_ptr req = weak_req.lock();
+    if(!req || !req->get_operation()->is_requirement())
+      continue;
+    auto *r = cast<requirement>(req->get_operation());
+    if(!r->is_memory_requirement())
+      continue;
+    auto *mem_req = cast<memory_requirement>(r);
+    if(!mem_req->is_buffer_requirement())
+      continue;
+    auto *bmem_req = cast<buffer_memory_requirement>(mem_req);
+
+    sycl::access::mode mode = bmem_req->get_access_mode();
+    if (mode == sycl::access::mode::discard_write ||
+        mode == sycl::access::mode::discard_read_write)
+      continue;
+
+    auto data = bmem_req->get_data_region();
+    id<3> offset = bmem_req->get_access_offset3d();
+    range<3> range = bmem_req->get_access_range3d();
+    // No transfers are needed for data that has not been initialized
+    if(!data->has_initialized_content(offset, range))
+      continue;
+
+    if(!data->has_allocation(dev)) {
+      outdated_regions.clear();
+      outdated_regions.push_back(std::make_pair(offset, range));
+    } else {
+      data->get_outdated_regions(dev, offset, range, outdated_regions);
+    }
+
+    for(const auto& region : outdated_regions) {
+      if (!data->try_get_update_source_candidates(dev, region, update_sources))
+        continue;
+
+      memory_location dest{dev, region.first, data};
+      double best_source = std::numeric_limits<double>::max();
+      for(const auto& source : update_sources) {
+        memory_location src{source.first, source.second.first, data};
+        best_source = std::min(
+            best_source, model->estimate_runtime_cost(src, dest, region.second));
+      }
+      transfer_time += best_source;
+    }
+  }
+  return transfer_time;
+}
+
+double
+dag_unbound_scheduler::estimate_runtime_ns(const std::string &kernel_name,
+                                           std::size_t device_index) const {
+  auto it = _kernel_runtimes.find(kernel_name);
+  if (it != _kernel_runtimes.end() && it->second.size() > device_index &&
+      it->second[device_index].num_samples > 0)
+    return it->second[device_index].mean_ns;
+
+  // No measurements for this kernel on this device - fall back to
+  // all measured kernels on this device
+  if(_average_runtimes[device_index].num_samples > 0)
+    return _average_runtimes[device_index].mean_ns;
+  return default_runtime_ns;
 }
 
+void dag_unbound_scheduler::update_device_load(device_load &load) {
+  // Nodes on the same device mostly complete in order, so it is
+  // sufficient to remove completed nodes from the front.
+  auto is_done = [](const outstanding_node& n) {
+    dag_node_ptr node = n.node.lock();
+    return !node || node->is_complete() || node->is_cancelled();
+  };
+  while (!load.outstanding_nodes.empty() &&
+         is_done(load.outstanding_nodes.front())) {
+    load.outstanding_runtime_ns -=
+        load.outstanding_nodes.front().estimated_runtime_ns;
+    load.outstanding_nodes.pop_front();
+  }
+  if(load.outstanding_nodes.empty())
+    load.outstanding_runtime_ns = 0.0;
+}
+
+void dag_unbound_scheduler::process_kernel_measurements() {
+  auto update_estimate = [](runtime_estimate &e, double ns) {
+    if(e.num_samples == 0)
+      e.mean_ns = ns;
+    else
+      e.mean_ns += runtime_estimate_decay * (ns - e.mean_ns);
+    ++e.num_samples;
+  };
+
+  auto is_processed = [&](const kernel_measurement &m) -> bool {
+    dag_node_ptr node = m.node.lock();
+    if(!node || node->is_cancelled())
+      return true;
+    if(!node->is_complete())
+      return false;
+
+    const instrumentation_set &instr =
+        node->get_operation()->get_instrumentations();
+    auto start = instr.get<instrumentations::execution_start_timestamp>();
+    auto finish = instr.get<instrumentations::execution_finish_timestamp>();
+    if(start && finish) {
+      auto start_ns = profiler_clock::ns_ticks(start->get_time_point());
+      auto finish_ns = profiler_clock::ns_ticks(finish->get_time_point());
+      if(finish_ns >= start_ns) {
+        double ns = static_cast<double>(finish_ns - start_ns);
+        auto& estimates = _kernel_runtimes[m.kernel_name];
+        if(estimates.size() < _devices.size())
+          estimates.resize(_devices.size());
+        update_estimate(estimates[m.device_index], ns);
+        update_estimate(_average_runtimes[m.device_index], ns);
+      }
+    }
+    return true;
+  };
+
+  _pending_measurements.erase(std::remove_if(_pending_measurements.begin(),
+                                             _pending_measurements.end(),
+                                             is_processed),
+                              _pending_measurements.end());
+}
+
+std::size_t dag_unbound_scheduler::get_device_index(device_id dev) {
+  for(std::size_t i = 0; i < _devices.size(); ++i)
+    if(_devices[i] == dev)
+      return i;
+  _devices.push_back(dev);
+  _device_loads.resize(_devices.size());
+  _average_runtimes.resize(_devices.size());
+  return _devices.size() - 1;
+}
+
+}
+}
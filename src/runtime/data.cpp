@@ -35,26 +35,74 @@
 namespace hipsycl {
 namespace rt {
 
-data_user_tracker::data_user_tracker(const data_user_tracker& other){
-  _users = other._users;
+namespace {
+
+// Limits the number of buckets per access mode to 2^max_user_index_levels - 1
+constexpr int max_user_index_levels = 8;
+
 }
 
-data_user_tracker::data_user_tracker(data_user_tracker&& other)
-: _users{std::move(other._users)}
+data_user_tracker::data_user_tracker()
+: data_user_tracker{range<3>{1,1,1}, range<3>{1,1,1}}
+{}
+
+data_user_tracker::data_user_tracker(range<3> page_size, range<3> num_pages)
+: _page_size{page_size}, _index_dim{2}
 {
-  _users = other._users;
+  for(int i = 0; i < 3; ++i) {
+    if(num_pages[i] > 1) {
+      _index_dim = i;
+      break;
+    }
+  }
+  _num_index_pages = std::max(num_pages[_index_dim], std::size_t{1});
+
+  // Use as many levels as needed such that leaf buckets
+  // contain a single page, up to max_user_index_levels.
+  _num_levels = 1;
+  while (_num_levels < max_user_index_levels &&
+         (std::size_t{1} << (_num_levels - 1)) < _num_index_pages)
+    ++_num_levels;
+
+  std::size_t num_buckets = (std::size_t{1} << _num_levels) - 1;
+  _read_users.buckets.resize(num_buckets);
+  _write_users.buckets.resize(num_buckets);
+}
+
+data_user_tracker::data_user_tracker(const data_user_tracker& other){
+  *this = other;
+}
+
+data_user_tracker::data_user_tracker(data_user_tracker&& other){
+  *this = std::move(other);
 }
 
 data_user_tracker& 
-data_user_tracker::operator=(data_user_tracker other){
-  _users = other._users;
+data_user_tracker::operator=(const data_user_tracker& other){
+  if(this == &other)
+    return *this;
+  std::lock_guard<std::mutex> lock{other._lock};
+  _page_size = other._page_size;
+  _index_dim = other._index_dim;
+  _num_index_pages = other._num_index_pages;
+  _num_levels = other._num_levels;
+  _read_users = other._read_users;
+  _write_users = other._write_users;
   return *this;
 }
 
 
 data_user_tracker& 
 data_user_tracker::operator=(data_user_tracker&& other){
-  _users = std::move(other._users);
+  if(this == &other)
+    return *this;
+  std::lock_guard<std::mutex> lock{other._lock};
+  _page_size = other._page_size;
+  _index_dim = other._index_dim;
+  _num_index_pages = other._num_index_pages;
+  _num_levels = other._num_levels;
+  _read_users = std::move(other._read_users);
+  _write_users = std::move(other._write_users);
   return *this;
 }
 
@@ -62,37 +110,171 @@ const std::vector<data_user>
 data_user_tracker::get_users() const
 { 
   std::lock_guard<std::mutex> lock{_lock};
-  return _users;
+  std::vector<data_user> result;
+  result.reserve(_read_users.num_users + _write_users.num_users);
+  for(const auto* h : {&_read_users, &_write_users})
+    for(const auto& bucket : h->buckets)
+      result.insert(result.end(), bucket.begin(), bucket.end());
+  return result;
 }
 
 
 bool data_user_tracker::has_user(dag_node_ptr user) const
 {
   std::lock_guard<std::mutex> lock{_lock};
-  return std::find_if(_users.begin(), _users.end(), [user](const data_user &u) {
-           return u.user.lock() == user;
-         }) != _users.end();
+  for(const auto* h : {&_read_users, &_write_users}) {
+    for(const auto& bucket : h->buckets) {
+      if (std::find_if(bucket.begin(), bucket.end(),
+                       [user](const data_user &u) {
+                         return u.user.lock() == user;
+                       }) != bucket.end())
+        return true;
+    }
+  }
+  return false;
 }
 
 void data_user_tracker::release_dead_users()
 {
   std::lock_guard<std::mutex> lock{_lock};
-  _users.erase(std::remove_if(_users.begin(), _users.end(),
-                              [](const data_user &user) -> bool {
-                                auto u = user.user.lock();
-                                if (!u)
-                                  return true;
-                                return u->is_known_complete();
-                              }),
-               _users.end());
-}
-
-range_store::range_store(range<3> size)
-: _size{size}, _contained_data(size.size())
-{}
+  for(auto* h : {&_read_users, &_write_users}) {
+    if(h->num_users == 0)
+      continue;
+    for(auto& bucket : h->buckets) {
+      std::size_t old_size = bucket.size();
+      bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                  [](const data_user &user) -> bool {
+                                    auto u = user.user.lock();
+                                    if (!u)
+                                      return true;
+                                    return u->is_known_complete();
+                                  }),
+                   bucket.end());
+      h->num_users -= old_size - bucket.size();
+    }
+  }
+}
+
+std::size_t data_user_tracker::get_bucket(std::size_t page_begin,
+                                          std::size_t page_end) const {
+  // Users that do not access any pages can never intersect,
+  // so it does not matter where they are stored.
+  if(page_begin >= page_end)
+    return 0;
+  std::size_t leaf_begin = get_leaf(page_begin);
+  std::size_t leaf_end = get_leaf(page_end - 1);
+  // Find deepest level where both ends are in the same bucket
+  int level = _num_levels - 1;
+  while((leaf_begin >> (_num_levels - 1 - level)) !=
+        (leaf_end >> (_num_levels - 1 - level)))
+    --level;
+  return ((std::size_t{1} << level) - 1) +
+         (leaf_begin >> (_num_levels - 1 - level));
+}
+
+void data_user_tracker::get_index_page_range(id<3> offset, range<3> range,
+                                             std::size_t &page_begin,
+                                             std::size_t &page_end) const {
+  // Needs to be consistent with data_region::get_page_range()
+  std::size_t page_size = _page_size[_index_dim];
+  page_begin = offset[_index_dim] / page_size;
+  page_end =
+      (offset[_index_dim] + range[_index_dim] + page_size - 1) / page_size;
+  // Clamp to the page table without turning non-empty ranges into
+  // empty ones, so that lookups always return a superset of
+  // intersecting users.
+  if(page_begin < page_end) {
+    page_begin = std::min(page_begin, _num_index_pages - 1);
+    page_end = std::min(page_end, _num_index_pages);
+  }
+}
+
+namespace {
+
+using rect = range_store::rect;
+
+std::size_t get_volume(const rect& r) {
+  return r.second[0] * r.second[1] * r.second[2];
+}
+
+bool get_intersection(const rect& a, const rect& b, rect& out) {
+  for(int i = 0; i < 3; ++i) {
+    std::size_t begin = std::max(a.first[i], b.first[i]);
+    std::size_t end = std::min(a.first[i] + a.second[i],
+                               b.first[i] + b.second[i]);
+    if(begin >= end)
+      return false;
+    out.first[i] = begin;
+    out.second[i] = end - begin;
+  }
+  return true;
+}
+
+// Appends the parts of a that are not covered by c to out. c must be
+// contained in a. Results in at most 6 disjoint boxes; slabs along the
+// slowest dimension are split off first, such that the resulting boxes
+// are as contiguous in memory as possible.
+void subtract_contained(const rect& a, const rect& c, std::vector<rect>& out) {
+  rect remainder = a;
+  for(int i = 0; i < 3; ++i) {
+    std::size_t remainder_end = remainder.first[i] + remainder.second[i];
+    std::size_t c_end = c.first[i] + c.second[i];
+
+    if(c.first[i] > remainder.first[i]) {
+      rect lower = remainder;
+      lower.second[i] = c.first[i] - remainder.first[i];
+      out.push_back(lower);
+    }
+    if(c_end < remainder_end) {
+      rect upper = remainder;
+      upper.first[i] = c_end;
+      upper.second[i] = remainder_end - c_end;
+      out.push_back(upper);
+    }
+    remainder.first[i] = c.first[i];
+    remainder.second[i] = c.second[i];
+  }
+}
+
+// Merges b into a if the union of both is again a box.
+bool try_merge(rect& a, const rect& b) {
+  int merge_dim = -1;
+  for(int i = 0; i < 3; ++i) {
+    if(a.first[i] != b.first[i] || a.second[i] != b.second[i]) {
+      if(merge_dim != -1)
+        return false;
+      merge_dim = i;
+    }
+  }
+  if(merge_dim == -1)
+    return true;
+
+  if(a.first[merge_dim] + a.second[merge_dim] == b.first[merge_dim]) {
+    a.second[merge_dim] += b.second[merge_dim];
+    return true;
+  } else if(b.first[merge_dim] + b.second[merge_dim] == a.first[merge_dim]) {
+    a.first[merge_dim] = b.first[merge_dim];
+    a.second[merge_dim] += b.second[merge_dim];
+    return true;
+  }
+  return false;
+}
+
+}
+
+range_store::range_store(range<3> size, representation rep)
+: _size{size}, _representation{rep}
+{
+  if(_representation == representation::dense)
+    _contained_data.resize(size.size(), data_state::empty);
+}
 
 void range_store::add(const rect& r)
 {
+  if(_representation == representation::sparse) {
+    sparse_add(r);
+    return;
+  }
   this->for_each_element_in_range(r,
     [](id<3>, data_state& s){
       s = data_state::available;
@@ -101,6 +283,10 @@ void range_store::add(const rect& r)
 
 void range_store::remove(const rect& r)
 {
+  if(_representation == representation::sparse) {
+    sparse_remove(r);
+    return;
+  }
   this->for_each_element_in_range(r, 
     [](id<3>, data_state& s){
       s = data_state::empty;
@@ -114,6 +300,11 @@ void range_store::intersections_with(const rect& r,
                                     data_state desired_state,
                                     std::vector<rect>& out) const
 {
+  if(_representation == representation::sparse) {
+    sparse_intersections_with(r, desired_state, out);
+    return;
+  }
+
   out.clear();
   
   id<3> rect_begin = r.first;
@@ -159,6 +350,9 @@ void range_store::intersections_with(const rect& r,
 bool range_store::entire_range_equals(
     const rect& r, data_state desired_state) const
 {
+  if(_representation == representation::sparse)
+    return sparse_entire_range_equals(r, desired_state);
+
   for(size_t x = r.first[0]; x < r.second[0]+r.first[0]; ++x){
     for(size_t y = r.first[1]; y < r.second[1]+r.first[1]; ++y){
       for(size_t z = r.first[2]; z < r.second[2]+r.first[2]; ++z){
@@ -174,5 +368,99 @@ bool range_store::entire_range_equals(
   return true;
 }
 
+void range_store::sparse_add(const rect& r)
+{
+  if(get_volume(r) == 0)
+    return;
+  // Keep boxes disjoint
+  sparse_remove(r);
+
+  // Coalesce with neighboring boxes to keep the number of boxes small
+  rect merged = r;
+  bool has_merged = true;
+  while(has_merged) {
+    has_merged = false;
+    for(std::size_t i = 0; i < _available_boxes.size(); ++i) {
+      if(try_merge(merged, _available_boxes[i])) {
+        _available_boxes[i] = _available_boxes.back();
+        _available_boxes.pop_back();
+        has_merged = true;
+        break;
+      }
+    }
+  }
+  _available_boxes.push_back(merged);
+}
+
+void range_store::sparse_remove(const rect& r)
+{
+  if(get_volume(r) == 0)
+    return;
+
+  std::vector<rect> result;
+  result.reserve(_available_boxes.size());
+  for(const rect& box : _available_boxes) {
+    rect intersection;
+    if(get_intersection(box, r, intersection))
+      subtract_contained(box, intersection, result);
+    else
+      result.push_back(box);
+  }
+  _available_boxes = std::move(result);
+}
+
+void range_store::sparse_intersections_with(const rect& r,
+                                            data_state desired_state,
+                                            std::vector<rect>& out) const
+{
+  out.clear();
+  if(get_volume(r) == 0)
+    return;
+
+  if(desired_state == data_state::available) {
+    for(const rect& box : _available_boxes) {
+      rect intersection;
+      if(get_intersection(box, r, intersection))
+        out.push_back(intersection);
+    }
+  } else {
+    // Cut all available boxes out of r
+    out.push_back(r);
+    std::vector<rect> remainder;
+    for(const rect& box : _available_boxes) {
+      remainder.clear();
+      for(const rect& current : out) {
+        rect intersection;
+        if(get_intersection(current, box, intersection))
+          subtract_contained(current, intersection, remainder);
+        else
+          remainder.push_back(current);
+      }
+      std::swap(out, remainder);
+      if(out.empty())
+        return;
+    }
+  }
+}
+
+bool range_store::sparse_entire_range_equals(const rect& r,
+                                             data_state desired_state) const
+{
+  // Since boxes are disjoint, r is entirely available if the
+  // intersections cover its whole volume.
+  std::size_t available_volume = 0;
+  for(const rect& box : _available_boxes) {
+    rect intersection;
+    if(get_intersection(box, r, intersection)) {
+      if(desired_state == data_state::empty)
+        return false;
+      available_volume += get_volume(intersection);
+    }
+  }
+  if(desired_state == data_state::empty)
+    return true;
+  return available_volume == get_volume(r);
+}
+
 }
 }
@@ -31,12 +31,46 @@
 #include <cassert>
 #include <mutex>
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+// Number of times the worker checks for new work before going to sleep.
+// This avoids the cost of parking and waking up the thread when tasks
+// arrive in quick succession. Spinning only makes sense if the thread
+// that we are waiting for can run concurrently.
+int get_spin_iterations(int iterations) {
+  static const bool can_spin = std::thread::hardware_concurrency() > 1;
+  return can_spin ? iterations : 0;
+}
+
+const int worker_spin_iterations = get_spin_iterations(4096);
+const int wait_spin_iterations = get_spin_iterations(1024);
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+}
+
 worker_thread::worker_thread()
-    : _continue{true}
+    : _continue{true}, _head{nullptr}, _tail{nullptr},
+      _num_pending_tasks{0}, _is_worker_sleeping{false},
+      _num_waiting_threads{0}
 {
+  task_node* stub = new task_node;
+  _head.store(stub);
+  _tail = stub;
+
   _worker_thread = std::thread{[this](){ work(); } };
 }
 
@@ -45,20 +79,26 @@ worker_thread::~worker_thread()
 {
   halt();
 
-  assert(_enqueued_operations.empty());
+  assert(is_queue_empty());
+  delete _tail;
 }
 
 void worker_thread::wait()
 {
-  std::unique_lock<std::mutex> lock(_mutex);
-  if(!_enqueued_operations.empty())
+  for(int i = 0; i < wait_spin_iterations; ++i) {
+    if(_num_pending_tasks.load(std::memory_order_acquire) == 0)
+      return;
+    cpu_relax();
+  }
+
+  _num_waiting_threads.fetch_add(1, std::memory_order_seq_cst);
   {
-    // Before going to sleep, wake up the other thread to avoid deadlocks
-    _condition_wait.notify_all();
-    // Wait until no operation is pending
-    _condition_wait.wait(lock, [this]{return _enqueued_operations.empty();});
+    std::unique_lock<std::mutex> lock(_mutex);
+    _all_tasks_completed.wait(lock, [this] {
+      return _num_pending_tasks.load(std::memory_order_seq_cst) == 0;
+    });
   }
-  assert(_enqueued_operations.empty());
+  _num_waiting_threads.fetch_sub(1, std::memory_order_relaxed);
 }
 
 
@@ -69,7 +109,7 @@ void worker_thread::halt()
   {
     std::unique_lock<std::mutex> lock(_mutex);
     _continue = false;
-    _condition_wait.notify_all();
+    _work_available.notify_all();
   }
   if(_worker_thread.joinable())
     _worker_thread.join();
@@ -79,67 +119,99 @@ void worker_thread::work()
 {
   // This is the main function executed by the worker thread.
   // The loop is executed as long as there are enqueued operations,
-  // (_is_operation_pending) or we should wait for new operations
-  // (_continue).
-  while(_continue || queue_size() > 0)
-  {
-    {
-      std::unique_lock<std::mutex> lock(_mutex);
-
-      // Before going to sleep, wake up the other thread in case it is is waiting
-      // for the queue to get empty
-      _condition_wait.notify_all();
-      // Wait until we have work, or until _continue becomes false
-      _condition_wait.wait(lock,
-                           [this](){
-        return _enqueued_operations.size()>0 || !_continue;
-      });
-    }
-
-    // In any way, process the pending operations
-
-    async_function operation = [](){};
-    bool has_operation = false;
-
-    {
-      std::lock_guard<std::mutex> lock(_mutex);
-
-      if(!_enqueued_operations.empty())
-      {
-        operation = _enqueued_operations.front();
-        has_operation = true;
+  // or we should wait for new operations (_continue).
+  async_function operation;
+  int num_idle_iterations = 0;
+
+  for(;;) {
+    if(try_pop(operation)) {
+      num_idle_iterations = 0;
+
+      operation();
+      // Release resources held by the task before signalling completion
+      operation = async_function{};
+
+      if(_num_pending_tasks.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+        if(_num_waiting_threads.load(std::memory_order_seq_cst) > 0) {
+          std::lock_guard<std::mutex> lock{_mutex};
+          _all_tasks_completed.notify_all();
+        }
       }
+      continue;
     }
 
-    operation();
+    if(!_continue.load(std::memory_order_acquire) &&
+       _num_pending_tasks.load(std::memory_order_acquire) == 0)
+      return;
 
-    {
-      std::lock_guard<std::mutex> lock{_mutex};
-      if(has_operation)
-        _enqueued_operations.pop();
+    if(num_idle_iterations < worker_spin_iterations) {
+      ++num_idle_iterations;
+      cpu_relax();
+      continue;
     }
 
-    _condition_wait.notify_all();
-
+    // Park. Producers check _is_worker_sleeping after enqueuing, so
+    // after announcing that we go to sleep we need to check for work
+    // once more to avoid missing a wakeup.
+    std::unique_lock<std::mutex> lock{_mutex};
+    _is_worker_sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    _work_available.wait(lock, [this]() {
+      return _num_pending_tasks.load(std::memory_order_relaxed) > 0 ||
+             !_continue.load(std::memory_order_relaxed);
+    });
+    _is_worker_sleeping.store(false, std::memory_order_relaxed);
+    num_idle_iterations = 0;
   }
 }
 
 void worker_thread::operator()(worker_thread::async_function f)
 {
-  std::unique_lock<std::mutex> lock(_mutex);
+  task_node* node = new task_node;
+  node->task = std::move(f);
 
-  _enqueued_operations.push(f);
+  _num_pending_tasks.fetch_add(1, std::memory_order_relaxed);
+  push(node);
 
-  lock.unlock();
-  _condition_wait.notify_all();
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if(_is_worker_sleeping.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _work_available.notify_one();
+  }
 }
 
 std::size_t worker_thread::queue_size() const
 {
-  std::lock_guard<std::mutex> lock(_mutex);
-  return _enqueued_operations.size();
+  return _num_pending_tasks.load(std::memory_order_acquire);
+}
+
+void worker_thread::push(task_node* node)
+{
+  task_node* previous_head = _head.exchange(node, std::memory_order_acq_rel);
+  // Between the exchange and this store, the queue is temporarily
+  // disconnected for the consumer. The consumer treats this as empty
+  // and will retry.
+  previous_head->next.store(node, std::memory_order_release);
 }
 
+bool worker_thread::try_pop(async_function& out)
+{
+  task_node* tail = _tail;
+  task_node* next = tail->next.load(std::memory_order_acquire);
+  if(!next)
+    return false;
+
+  // next becomes the new stub
+  out = std::move(next->task);
+  _tail = next;
+  delete tail;
+  return true;
+}
+
+bool worker_thread::is_queue_empty() const
+{
+  return _tail->next.load(std::memory_order_acquire) == nullptr;
+}
 
 }
 }
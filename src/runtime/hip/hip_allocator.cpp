@@ -37,7 +37,7 @@ hip_allocator::hip_allocator(backend_descriptor desc, int hip_device)
     : _backend_descriptor{desc}, _dev{hip_device}
 {}
       
-void *hip_allocator::allocate(size_t min_alignment, size_t size_bytes)
+void *hip_allocator::raw_allocate(size_t min_alignment, size_t size_bytes)
 {
   void *ptr;
   hip_device_manager::get().activate_device(_dev);
@@ -54,8 +54,8 @@ void *hip_allocator::allocate(size_t min_alignment, size_t size_bytes)
   return ptr;
 }
 
-void *hip_allocator::allocate_optimized_host(size_t min_alignment,
-                                             size_t bytes) {
+void *hip_allocator::raw_allocate_optimized_host(size_t min_alignment,
+                                                 size_t bytes) {
   void *ptr;
   hip_device_manager::get().activate_device(_dev);
 
@@ -71,7 +71,7 @@ void *hip_allocator::allocate_optimized_host(size_t min_alignment,
   return ptr;
 }
 
-void hip_allocator::free(void *mem) {
+void hip_allocator::raw_free(void *mem) {
 
   pointer_info info;
   result query_result = query_pointer(mem, info);
@@ -95,7 +95,7 @@ void hip_allocator::free(void *mem) {
   }
 }
 
-void * hip_allocator::allocate_usm(size_t bytes)
+void * hip_allocator::raw_allocate_usm(size_t bytes)
 {
   hip_device_manager::get().activate_device(_dev);
 
@@ -112,6 +112,10 @@ void * hip_allocator::allocate_usm(size_t bytes)
   return ptr;
 }
 
+device_id hip_allocator::get_device() const {
+  return device_id{_backend_descriptor, _dev};
+}
+
 bool hip_allocator::is_usm_accessible_from(backend_descriptor b) const
 {
   // TODO: Formulate this better - this assumes that either CUDA+CPU or
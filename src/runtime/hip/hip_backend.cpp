@@ -32,6 +32,13 @@
 #include "hipSYCL/runtime/hip/hip_target.hpp"
 #include "hipSYCL/runtime/hip/hip_queue.hpp"
 #include "hipSYCL/runtime/multi_queue_executor.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+#include "hipSYCL/compiler/llvm-to-backend/amdgpu/LLVMToAmdgpuFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#endif
 
 HIPSYCL_PLUGIN_API_EXPORT
 hipsycl::rt::backend *hipsycl_backend_plugin_create() {
@@ -126,6 +133,18 @@ hip_backend::create_inorder_executor(device_id dev, int priority) {
 
   return std::make_unique<inorder_executor>(std::move(q));
 }
-  
+
+result hip_backend::jit_compile_recorded_configuration(
+    const common::hcf_container *hcf,
+    const recorded_kernel_configuration &entry,
+    std::string &binary_out) const {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  return glue::jit::compile_recorded_configuration(
+      compiler::createLLVMToAmdgpuTranslator, hcf, entry, binary_out);
+#else
+  return backend::jit_compile_recorded_configuration(hcf, entry, binary_out);
+#endif
+}
+
 }
 }
\ No newline at end of file
@@ -45,6 +45,7 @@
 
 #include "hipSYCL/compiler/llvm-to-backend/amdgpu/LLVMToAmdgpuFactory.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
 
 #endif
 
@@ -611,8 +612,8 @@ result hip_queue::submit_sscp_kernel_from_code_object(
   }
 
   kernel_adaptivity_engine adaptivity_engine{
-      hcf_object, kernel_name, kernel_info, num_groups,
-      group_size, args,        arg_sizes,   num_args, local_mem_size};
+      this->get_device(), hcf_object, kernel_name, kernel_info, num_groups,
+      group_size,         args,       arg_sizes,   num_args,    local_mem_size};
   
   static thread_local glue::kernel_configuration config;
   config = initial_config;
@@ -643,6 +644,10 @@ result hip_queue::submit_sscp_kernel_from_code_object(
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
+  kernel_configuration_recorder::get().record(
+      backend_id::hip, hcf_object, binary_configuration_id, config,
+      get_image_and_kernel_names);
+
   auto jit_compiler = [&](std::string& compiled_image) -> bool {
     const common::hcf_container *hcf =
         rt::hcf_cache::get().get_hcf(hcf_object);
@@ -26,33 +26,109 @@
  */
 
 #include "hipSYCL/runtime/hw_model/memcpy.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/dag_node.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/inorder_executor.hpp"
+#include "hipSYCL/runtime/inorder_queue.hpp"
+#include "hipSYCL/runtime/instrumentation.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <limits>
+#include <sstream>
 
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+constexpr const char* persistent_file_header = "acpp-memcpy-model-v1";
+
+// Defaults for device pairs without measurements
+constexpr double default_latency_ns = 10000.0;
+constexpr double default_same_platform_bytes_per_ns = 20.0;
+constexpr double default_cross_platform_bytes_per_ns = 10.0;
+
+// Transfer sizes used for calibration. The small transfer
+// mostly measures latency, the large one bandwidth.
+constexpr std::size_t calibration_small_size = 4096;
+constexpr std::size_t calibration_large_size = 32 * 1024 * 1024;
+constexpr int calibration_repetitions = 3;
+
+// Upper bound of the number of memcpy operations for which
+// online measurement is pending
+constexpr std::size_t max_tracked_transfers = 64;
+
+}
+
+memcpy_model::memcpy_model(backend_manager* mgr)
+: _backend_mgr{mgr} {
+  _calibrate =
+      application::get_settings().get<setting::memcpy_model_calibration>();
+  _persistent_file = common::filesystem::join_path(
+      common::filesystem::tuningdb::get().get_base_dir(), "memcpy_model.txt");
+  load();
+}
+
+memcpy_model::~memcpy_model() {
+  if(_is_modified)
+    store();
+}
 
 cost_type
 memcpy_model::estimate_runtime_cost(const memory_location &source,
                                     const memory_location &dest,
                                     range<3> num_elements) const
 {
-  // Strongly prefer transfers from the same device to the same device
-  if(source.get_device() == dest.get_device())
-    return 1.0;
-
-  if (source.get_device().get_full_backend_descriptor().hw_platform ==
-      dest.get_device().get_full_backend_descriptor().hw_platform)
-    return 2.0;
-
-  return 3.0;
+  link_parameters p = get_parameters(source.get_device(), dest.get_device());
+  double num_bytes =
+      static_cast<double>(num_elements.size() * source.get_element_size());
+  return p.latency_ns + num_bytes / p.bytes_per_ns;
 }
 
 memory_location memcpy_model::choose_source(
     const std::vector<memory_location> &candidate_sources,
-    const memory_location &target, range<3> num_elements) const 
+    const memory_location &target, range<3> num_elements)
 {
+  assert(!candidate_sources.empty());
+  // Nothing to decide
+  if(candidate_sources.size() == 1)
+    return candidate_sources[0];
+
+  process_tracked_transfers();
+
+  if(_calibrate) {
+    for(const auto& candidate : candidate_sources) {
+      link_key key = make_key(candidate.get_device(), target.get_device());
+      bool needs_calibration = false;
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        if (std::find(_calibrated_links.begin(), _calibrated_links.end(),
+                      key) == _calibrated_links.end()) {
+          _calibrated_links.push_back(key);
+          // Persisted results from previous runs can be reused
+          needs_calibration = _links.find(key) == _links.end();
+        }
+      }
+      if (needs_calibration &&
+          candidate.get_device() != target.get_device()) {
+        auto err = calibrate(candidate.get_device(), target.get_device());
+        if(!err.is_success()) {
+          HIPSYCL_DEBUG_WARNING << "memcpy_model: Calibration failed: "
+                                << err.what() << std::endl;
+        }
+      }
+    }
+  }
+
   std::size_t best_transfer_index = 0;
   cost_type best_cost = std::numeric_limits<cost_type>::max();
 
@@ -67,5 +143,235 @@ memory_location memcpy_model::choose_source(
   return candidate_sources[best_transfer_index];
 }
 
+void memcpy_model::add_measurement(device_id source, device_id dest,
+                                   std::size_t num_bytes, double nanoseconds) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  add_measurement_impl(make_key(source, dest), num_bytes, nanoseconds);
+}
+
+void memcpy_model::track_transfer(dag_node_ptr node,
+                                  const memcpy_operation *op) {
+  process_tracked_transfers();
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(_tracked_transfers.size() < max_tracked_transfers)
+    _tracked_transfers.push_back(tracked_transfer{node, op});
+}
+
+result memcpy_model::calibrate(device_id source, device_id dest) {
+  HIPSYCL_DEBUG_INFO << "memcpy_model: Calibrating transfers from device "
+                     << source.get_id() << " of backend "
+                     << static_cast<int>(source.get_backend())
+                     << " to device " << dest.get_id() << " of backend "
+                     << static_cast<int>(dest.get_backend()) << std::endl;
+
+  // Execute on the same device as the scheduler would,
+  // see memcpy_operation::has_preferred_backend()
+  device_id executing_device = dest;
+  if (source.get_full_backend_descriptor().hw_platform !=
+      hardware_platform::cpu)
+    executing_device = source;
+
+  backend *source_backend = _backend_mgr->get(source.get_backend());
+  backend *dest_backend = _backend_mgr->get(dest.get_backend());
+  backend *executing_backend =
+      _backend_mgr->get(executing_device.get_backend());
+  if(!source_backend || !dest_backend || !executing_backend)
+    return make_error(__hipsycl_here(),
+                      error_info{"memcpy_model: Backend is not available"});
+
+  std::unique_ptr<backend_executor> executor =
+      executing_backend->create_inorder_executor(executing_device, 0);
+  if(!executor || !executor->is_inorder_queue())
+    return make_error(
+        __hipsycl_here(),
+        error_info{"memcpy_model: Backend does not support inorder executors"});
+  inorder_queue *q = static_cast<inorder_executor *>(executor.get())->get_queue();
+
+  backend_allocator *source_allocator = source_backend->get_allocator(source);
+  backend_allocator *dest_allocator = dest_backend->get_allocator(dest);
+  void *source_ptr = source_allocator->allocate(0, calibration_large_size);
+  void *dest_ptr = dest_allocator->allocate(0, calibration_large_size);
+
+  result res = make_success();
+  if(!source_ptr || !dest_ptr) {
+    res = make_error(
+        __hipsycl_here(),
+        error_info{"memcpy_model: Could not allocate calibration memory",
+                   error_type::memory_allocation_error});
+  } else {
+    range<3> shape{1, 1, calibration_large_size};
+    memory_location source_location{source, source_ptr, id<3>{}, shape, 1};
+    memory_location dest_location{dest, dest_ptr, id<3>{}, shape, 1};
+
+    for (std::size_t size :
+         {calibration_small_size, calibration_large_size}) {
+      memcpy_operation op{source_location, dest_location,
+                          range<3>{1, 1, size}};
+      // The first iteration is only used for warm-up
+      double best_ns = std::numeric_limits<double>::max();
+      for (int i = 0; i <= calibration_repetitions && res.is_success(); ++i) {
+        auto start = std::chrono::steady_clock::now();
+        res = q->submit_memcpy(op, nullptr);
+        if(res.is_success())
+          res = q->wait();
+        auto stop = std::chrono::steady_clock::now();
+        if(i > 0)
+          best_ns = std::min(
+              best_ns,
+              static_cast<double>(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(stop -
+                                                                       start)
+                      .count()));
+      }
+      if(!res.is_success())
+        break;
+      add_measurement(source, dest, size, best_ns);
+    }
+  }
+
+  if(source_ptr)
+    source_allocator->free(source_ptr);
+  if(dest_ptr)
+    dest_allocator->free(dest_ptr);
+  return res;
+}
+
+memcpy_model::link_key memcpy_model::make_key(device_id source,
+                                              device_id dest) {
+  return link_key{static_cast<int>(source.get_backend()), source.get_id(),
+                  static_cast<int>(dest.get_backend()), dest.get_id()};
+}
+
+memcpy_model::link_parameters
+memcpy_model::get_parameters(device_id source, device_id dest) const {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _links.find(make_key(source, dest));
+    if(it != _links.end() && it->second.num_samples > 0.0) {
+      const link_statistics& s = it->second;
+      double mean_bytes = s.sum_bytes / s.num_samples;
+      double mean_ns = s.sum_ns / s.num_samples;
+      double variance_bytes =
+          s.sum_bytes_squared / s.num_samples - mean_bytes * mean_bytes;
+
+      // If transfers of sufficiently different sizes were observed,
+      // fit latency and bandwidth separately
+      if (variance_bytes > 0.01 * mean_bytes * mean_bytes) {
+        double ns_per_byte =
+            (s.sum_bytes_ns / s.num_samples - mean_bytes * mean_ns) /
+            variance_bytes;
+        double latency_ns = mean_ns - ns_per_byte * mean_bytes;
+        if(ns_per_byte > 0.0)
+          return link_parameters{std::max(latency_ns, 0.0), 1.0 / ns_per_byte};
+      }
+      // Otherwise, attribute everything to bandwidth
+      if(mean_ns > 0.0 && mean_bytes > 0.0)
+        return link_parameters{0.0, mean_bytes / mean_ns};
+    }
+  }
+
+  // Strongly prefer transfers from the same device to the same device
+  if(source == dest)
+    return link_parameters{0.0, std::numeric_limits<double>::max()};
+
+  if (source.get_full_backend_descriptor().hw_platform ==
+      dest.get_full_backend_descriptor().hw_platform)
+    return link_parameters{default_latency_ns,
+                           default_same_platform_bytes_per_ns};
+
+  return link_parameters{default_latency_ns,
+                         default_cross_platform_bytes_per_ns};
+}
+
+void memcpy_model::process_tracked_transfers() {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto is_processed = [this](const tracked_transfer &t) -> bool {
+    if(t.node->is_cancelled())
+      return true;
+    if(!t.node->is_complete())
+      return false;
+
+    const instrumentation_set &instr = t.op->get_instrumentations();
+    auto start = instr.get<instrumentations::execution_start_timestamp>();
+    auto finish = instr.get<instrumentations::execution_finish_timestamp>();
+    if(start && finish) {
+      auto start_ns = profiler_clock::ns_ticks(start->get_time_point());
+      auto finish_ns = profiler_clock::ns_ticks(finish->get_time_point());
+      if(finish_ns > start_ns)
+        add_measurement_impl(
+            make_key(t.op->source().get_device(), t.op->dest().get_device()),
+            t.op->get_num_transferred_bytes(),
+            static_cast<double>(finish_ns - start_ns));
+    }
+    return true;
+  };
+
+  _tracked_transfers.erase(std::remove_if(_tracked_transfers.begin(),
+                                          _tracked_transfers.end(),
+                                          is_processed),
+                           _tracked_transfers.end());
+}
+
+void memcpy_model::add_measurement_impl(const link_key &key,
+                                        std::size_t num_bytes,
+                                        double nanoseconds) {
+  link_statistics& s = _links[key];
+  double x = static_cast<double>(num_bytes);
+  s.num_samples += 1.0;
+  s.sum_bytes += x;
+  s.sum_ns += nanoseconds;
+  s.sum_bytes_squared += x * x;
+  s.sum_bytes_ns += x * nanoseconds;
+  _is_modified = true;
+}
+
+void memcpy_model::load() {
+  std::ifstream file{_persistent_file};
+  if(!file.is_open())
+    return;
+
+  std::string header;
+  if(!std::getline(file, header) || header != persistent_file_header) {
+    HIPSYCL_DEBUG_WARNING << "memcpy_model: Ignoring " << _persistent_file
+                          << " due to unknown format" << std::endl;
+    return;
+  }
+
+  std::string line;
+  while(std::getline(file, line)) {
+    std::istringstream line_stream{line};
+    link_key key;
+    link_statistics s;
+    if (line_stream >> key.source_backend >> key.source_device >>
+        key.dest_backend >> key.dest_device >> s.num_samples >> s.sum_bytes >>
+        s.sum_ns >> s.sum_bytes_squared >> s.sum_bytes_ns)
+      _links[key] = s;
+  }
+  HIPSYCL_DEBUG_INFO << "memcpy_model: Loaded parameters for " << _links.size()
+                     << " device pairs from " << _persistent_file << std::endl;
+}
+
+void memcpy_model::store() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  std::ostringstream out;
+  out.precision(17);
+  out << persistent_file_header << "\n";
+  for(const auto& entry : _links) {
+    const link_key& key = entry.first;
+    const link_statistics& s = entry.second;
+    out << key.source_backend << " " << key.source_device << " "
+        << key.dest_backend << " " << key.dest_device << " " << s.num_samples
+        << " " << s.sum_bytes << " " << s.sum_ns << " " << s.sum_bytes_squared
+        << " " << s.sum_bytes_ns << "\n";
+  }
+  if(!common::filesystem::atomic_write(_persistent_file, out.str())) {
+    HIPSYCL_DEBUG_WARNING << "memcpy_model: Could not write "
+                          << _persistent_file << std::endl;
+  }
+}
+
 }
 }
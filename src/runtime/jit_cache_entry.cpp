@@ -0,0 +1,333 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/jit_cache_entry.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef HIPSYCL_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+void store_u16(char* out, uint16_t x) {
+  for(int i = 0; i < 2; ++i)
+    out[i] = static_cast<char>((x >> (8 * i)) & 0xff);
+}
+
+void store_u64(char* out, uint64_t x) {
+  for(int i = 0; i < 8; ++i)
+    out[i] = static_cast<char>((x >> (8 * i)) & 0xff);
+}
+
+uint16_t load_u16(const char* in) {
+  uint16_t x = 0;
+  for(int i = 0; i < 2; ++i)
+    x |= static_cast<uint16_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+  return x;
+}
+
+uint64_t load_u64(const char* in) {
+  uint64_t x = 0;
+  for(int i = 0; i < 8; ++i)
+    x |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+  return x;
+}
+
+// Non-cryptographic 64-bit checksum that processes 8 bytes per step, so that
+// verifying large binaries is cheap compared to reading them.
+uint64_t compute_checksum(std::string_view data) {
+  constexpr uint64_t prime = 0x100000001b3ull;
+  uint64_t h = 0xcbf29ce484222325ull ^ data.size();
+
+  std::size_t num_words = data.size() / sizeof(uint64_t);
+  for(std::size_t i = 0; i < num_words; ++i) {
+    uint64_t word;
+    std::memcpy(&word, data.data() + i * sizeof(uint64_t), sizeof(uint64_t));
+    h = (h ^ word) * prime;
+    h ^= h >> 29;
+  }
+  for(std::size_t i = num_words * sizeof(uint64_t); i < data.size(); ++i) {
+    h = (h ^ static_cast<unsigned char>(data[i])) * prime;
+  }
+  return h;
+}
+
+void encode_header(const jit_cache_entry_header& header, char* out) {
+  std::memset(out, 0, jit_cache_entry_header::size);
+  std::memcpy(out, jit_cache_entry_header::magic,
+              sizeof(jit_cache_entry_header::magic));
+  store_u16(out + 8, static_cast<uint16_t>(header.algorithm));
+  store_u64(out + 16, header.uncompressed_size);
+  store_u64(out + 24, header.payload_size);
+  store_u64(out + 32, header.checksum);
+}
+
+bool decode_header(std::string_view file_content,
+                   jit_cache_entry_header &header) {
+  if(file_content.size() < jit_cache_entry_header::size)
+    return false;
+  if(std::memcmp(file_content.data(), jit_cache_entry_header::magic,
+                 sizeof(jit_cache_entry_header::magic)) != 0)
+    return false;
+
+  const char* data = file_content.data();
+  header.algorithm = static_cast<jit_cache_compression>(load_u16(data + 8));
+  header.uncompressed_size = load_u64(data + 16);
+  header.payload_size = load_u64(data + 24);
+  header.checksum = load_u64(data + 32);
+  return true;
+}
+
+bool compress(jit_cache_compression algorithm, std::string_view data,
+              std::string &out) {
+#ifdef HIPSYCL_WITH_ZLIB
+  if(algorithm == jit_cache_compression::zlib) {
+    uLongf compressed_size = compressBound(data.size());
+    out.resize(compressed_size);
+    int err = compress2(reinterpret_cast<Bytef *>(out.data()), &compressed_size,
+                        reinterpret_cast<const Bytef *>(data.data()),
+                        data.size(), Z_DEFAULT_COMPRESSION);
+    if(err != Z_OK)
+      return false;
+    out.resize(compressed_size);
+    return true;
+  }
+#endif
+  return false;
+}
+
+bool decompress(jit_cache_compression algorithm, std::string_view payload,
+                std::size_t uncompressed_size, std::string &out) {
+#ifdef HIPSYCL_WITH_ZLIB
+  if(algorithm == jit_cache_compression::zlib) {
+    out.resize(uncompressed_size);
+    uLongf decompressed_size = uncompressed_size;
+    int err = uncompress(reinterpret_cast<Bytef *>(out.data()),
+                         &decompressed_size,
+                         reinterpret_cast<const Bytef *>(payload.data()),
+                         payload.size());
+    return err == Z_OK && decompressed_size == uncompressed_size;
+  }
+#endif
+  return false;
+}
+
+#ifndef _WIN32
+class mapped_jit_cache_binary : public jit_cache_binary {
+public:
+  mapped_jit_cache_binary(void* mapping, std::size_t mapping_size)
+      : _mapping{mapping}, _mapping_size{mapping_size}, _offset{0},
+        _size{mapping_size} {}
+
+  ~mapped_jit_cache_binary() {
+    munmap(_mapping, _mapping_size);
+  }
+
+  virtual std::string_view get_data() const override {
+    return std::string_view{static_cast<const char *>(_mapping) + _offset,
+                            _size};
+  }
+
+  // Restricts the exposed data to a subrange of the mapping
+  void restrict_view(std::size_t offset, std::size_t size) {
+    _offset = offset;
+    _size = size;
+  }
+
+private:
+  void* _mapping;
+  std::size_t _mapping_size;
+  std::size_t _offset;
+  std::size_t _size;
+};
+#endif
+
+std::shared_ptr<owned_jit_cache_binary>
+read_file_to_memory(const std::string &filename) {
+  std::ifstream file{filename, std::ios::in | std::ios::binary | std::ios::ate};
+  if(!file.is_open())
+    return nullptr;
+
+  auto result = std::make_shared<owned_jit_cache_binary>();
+  std::streamsize file_size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  result->get_storage().resize(file_size);
+  file.read(result->get_storage().data(), file_size);
+  return result;
+}
+
+// Decodes the content of a persistent cache file. Compressed payloads are
+// decompressed into \c decompressed; otherwise \c payload_offset and
+// \c payload_size describe the location of the payload inside \c file_content.
+// Returns false if the file is corrupt.
+bool decode_entry(const std::string &filename, std::string_view file_content,
+                  std::size_t &payload_offset, std::size_t &payload_size,
+                  std::shared_ptr<owned_jit_cache_binary> &decompressed) {
+  jit_cache_entry_header header;
+  if(!decode_header(file_content, header)) {
+    // Raw binary from older versions
+    payload_offset = 0;
+    payload_size = file_content.size();
+    return true;
+  }
+
+  if(file_content.size() != jit_cache_entry_header::size + header.payload_size) {
+    HIPSYCL_DEBUG_WARNING << "jit_cache_entry: Invalid size of cache file "
+                          << filename << ", ignoring" << std::endl;
+    return false;
+  }
+  payload_offset = jit_cache_entry_header::size;
+  payload_size = header.payload_size;
+  std::string_view data = file_content.substr(payload_offset, payload_size);
+
+  if(header.algorithm != jit_cache_compression::none) {
+    decompressed = std::make_shared<owned_jit_cache_binary>();
+    if(!decompress(header.algorithm, data, header.uncompressed_size,
+                   decompressed->get_storage())) {
+      HIPSYCL_DEBUG_WARNING
+          << "jit_cache_entry: Could not decompress cache file " << filename
+          << " (algorithm " << static_cast<int>(header.algorithm)
+          << "), ignoring" << std::endl;
+      return false;
+    }
+    data = decompressed->get_data();
+  }
+
+  if(data.size() != header.uncompressed_size ||
+     compute_checksum(data) != header.checksum) {
+    HIPSYCL_DEBUG_WARNING << "jit_cache_entry: Checksum mismatch in cache file "
+                          << filename << ", ignoring" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}
+
+bool is_jit_cache_compression_supported(jit_cache_compression algorithm) {
+  if(algorithm == jit_cache_compression::none)
+    return true;
+#ifdef HIPSYCL_WITH_ZLIB
+  if(algorithm == jit_cache_compression::zlib)
+    return true;
+#endif
+  return false;
+}
+
+std::size_t write_jit_cache_entry(const std::string &filename,
+                                  std::string_view data,
+                                  jit_cache_compression algorithm) {
+  jit_cache_entry_header header;
+  header.uncompressed_size = data.size();
+  header.checksum = compute_checksum(data);
+
+  std::string compressed;
+  std::string_view payload = data;
+  if(algorithm != jit_cache_compression::none &&
+     compress(algorithm, data, compressed) && compressed.size() < data.size()) {
+    header.algorithm = algorithm;
+    payload = compressed;
+  }
+  header.payload_size = payload.size();
+
+  std::string file_content;
+  file_content.resize(jit_cache_entry_header::size + payload.size());
+  encode_header(header, file_content.data());
+  std::memcpy(file_content.data() + jit_cache_entry_header::size,
+              payload.data(), payload.size());
+
+  if(!common::filesystem::atomic_write(filename, file_content))
+    return 0;
+  return file_content.size();
+}
+
+std::shared_ptr<const jit_cache_binary>
+read_jit_cache_entry(const std::string &filename) {
+  std::size_t payload_offset = 0;
+  std::size_t payload_size = 0;
+  std::shared_ptr<owned_jit_cache_binary> decompressed;
+#ifndef _WIN32
+  int fd = open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+    return nullptr;
+
+  struct stat file_info;
+  if(fstat(fd, &file_info) != 0) {
+    close(fd);
+    return nullptr;
+  }
+  std::size_t file_size = static_cast<std::size_t>(file_info.st_size);
+
+  void* mapping = MAP_FAILED;
+  if(file_size > 0)
+    mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping remains valid after closing the file descriptor. Since
+  // cache files are only ever replaced atomically and never modified
+  // in-place, the mapped content cannot change underneath us.
+  close(fd);
+
+  if(mapping != MAP_FAILED) {
+    auto file_binary =
+        std::make_shared<mapped_jit_cache_binary>(mapping, file_size);
+    if(!decode_entry(filename, file_binary->get_data(), payload_offset,
+                     payload_size, decompressed))
+      return nullptr;
+    if(decompressed)
+      return decompressed;
+    file_binary->restrict_view(payload_offset, payload_size);
+    return file_binary;
+  }
+#endif
+  auto file_binary = read_file_to_memory(filename);
+  if(!file_binary)
+    return nullptr;
+  if(!decode_entry(filename, file_binary->get_data(), payload_offset,
+                   payload_size, decompressed))
+    return nullptr;
+  if(decompressed)
+    return decompressed;
+  file_binary->get_storage().erase(0, payload_offset);
+  return file_binary;
+}
+
+}
+}
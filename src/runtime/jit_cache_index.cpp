@@ -0,0 +1,355 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/jit_cache_index.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+#include "hipSYCL/common/config.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include HIPSYCL_CXX_FILESYSTEM_HEADER
+namespace fs = HIPSYCL_CXX_FILESYSTEM_NAMESPACE;
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+constexpr const char* index_header = "acpp-jit-cache-index-v1";
+
+uint64_t current_time() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+// Advisory lock that serializes index modifications across processes.
+class scoped_file_lock {
+public:
+  scoped_file_lock(const std::string& lock_file) {
+#ifndef _WIN32
+    _fd = open(lock_file.c_str(), O_RDWR | O_CREAT, 0644);
+    if(_fd >= 0) {
+      if(flock(_fd, LOCK_EX) != 0) {
+        close(_fd);
+        _fd = -1;
+      }
+    }
+    if(_fd < 0) {
+      HIPSYCL_DEBUG_WARNING << "jit_cache_index: Could not lock " << lock_file
+                            << ", concurrent modifications of the JIT cache "
+                               "index by other processes might get lost."
+                            << std::endl;
+    }
+#endif
+  }
+
+  ~scoped_file_lock() {
+#ifndef _WIN32
+    if(_fd >= 0) {
+      flock(_fd, LOCK_UN);
+      close(_fd);
+    }
+#endif
+  }
+private:
+  int _fd = -1;
+};
+
+}
+
+jit_cache_index::jit_cache_index(const std::string &cache_dir,
+                                 std::size_t max_size)
+    : _cache_dir{cache_dir},
+      _index_file{common::filesystem::join_path(cache_dir, index_filename)},
+      _lock_file{_index_file + ".lock"}, _max_size{max_size} {}
+
+jit_cache_index::~jit_cache_index() {
+  flush();
+}
+
+bool jit_cache_index::contains(const std::string &filename) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  ensure_initialized();
+
+  if(_entries.find(filename) != _entries.end())
+    return true;
+
+  // Another process might have added the entry in the meantime
+  if(is_on_disk_state_modified()) {
+    entry_map reloaded;
+    if(load_from_disk(reloaded))
+      _entries = std::move(reloaded);
+  }
+  return _entries.find(filename) != _entries.end();
+}
+
+void jit_cache_index::record_hit(const std::string &filename) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  ensure_initialized();
+
+  uint64_t now = current_time();
+  auto& pending = _pending_hits[filename];
+  ++pending.hit_count;
+  pending.last_access = now;
+
+  auto it = _entries.find(filename);
+  if(it != _entries.end()) {
+    ++it->second.hit_count;
+    it->second.last_access = now;
+  }
+}
+
+void jit_cache_index::insert(const std::string &filename, std::size_t size) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  _is_initialized = true;
+
+  modify_on_disk_index([&](entry_map& entries){
+    entry& e = entries[filename];
+    e.size = size;
+    e.last_access = current_time();
+
+    if(_max_size > 0)
+      evict(entries, filename);
+  });
+}
+
+void jit_cache_index::remove(const std::string &filename) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  _is_initialized = true;
+
+  _pending_hits.erase(filename);
+  modify_on_disk_index([&](entry_map& entries){
+    entries.erase(filename);
+  });
+}
+
+void jit_cache_index::flush() {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  if(!_pending_hits.empty())
+    modify_on_disk_index([](entry_map&){});
+}
+
+std::size_t jit_cache_index::get_total_size() {
+  std::lock_guard<std::mutex> lock{_mutex};
+  ensure_initialized();
+  std::size_t total = 0;
+  for(const auto& e : _entries)
+    total += e.second.size;
+  return total;
+}
+
+std::size_t jit_cache_index::get_num_entries() {
+  std::lock_guard<std::mutex> lock{_mutex};
+  ensure_initialized();
+  return _entries.size();
+}
+
+void jit_cache_index::ensure_initialized() {
+  if(_is_initialized)
+    return;
+  _is_initialized = true;
+
+  if(!load_from_disk(_entries)) {
+    // No index yet (e.g. a cache populated by an older version) - reconstruct
+    // it from the cache files that exist.
+    modify_on_disk_index([](entry_map&){});
+  }
+  HIPSYCL_DEBUG_INFO << "jit_cache_index: Loaded index with " << _entries.size()
+                     << " entries from " << _index_file << std::endl;
+}
+
+bool jit_cache_index::is_on_disk_state_modified() {
+  auto now = std::chrono::steady_clock::now();
+  if(now - _last_on_disk_check < on_disk_check_interval)
+    return false;
+  _last_on_disk_check = now;
+  return get_on_disk_state() != _on_disk_state;
+}
+
+template<class F>
+void jit_cache_index::modify_on_disk_index(F&& f) {
+  scoped_file_lock file_lock{_lock_file};
+
+  entry_map entries;
+  if(!load_from_disk(entries))
+    rebuild_from_directory(entries);
+
+  for(const auto& hit : _pending_hits) {
+    auto it = entries.find(hit.first);
+    // Entries might have been evicted by other processes
+    if(it != entries.end()) {
+      it->second.hit_count += hit.second.hit_count;
+      it->second.last_access =
+          std::max(it->second.last_access, hit.second.last_access);
+    }
+  }
+
+  f(entries);
+
+  if(store_to_disk(entries)) {
+    _pending_hits.clear();
+    _on_disk_state = get_on_disk_state();
+  }
+  _entries = std::move(entries);
+}
+
+bool jit_cache_index::load_from_disk(entry_map &out) {
+  // Query state before reading, such that concurrent modifications
+  // will be detected upon the next check.
+  auto state = get_on_disk_state();
+
+  std::ifstream file{_index_file, std::ios::in};
+  if(!file.is_open())
+    return false;
+
+  std::string header;
+  if(!std::getline(file, header) || header != index_header) {
+    HIPSYCL_DEBUG_WARNING << "jit_cache_index: Ignoring index file "
+                          << _index_file << " with invalid header" << std::endl;
+    return false;
+  }
+
+  out.clear();
+  std::string line;
+  while(std::getline(file, line)) {
+    std::istringstream sstr{line};
+    std::string filename;
+    entry e;
+    if(sstr >> filename >> e.size >> e.last_access >> e.hit_count)
+      out[filename] = e;
+  }
+
+  _on_disk_state = state;
+  return true;
+}
+
+bool jit_cache_index::store_to_disk(const entry_map &entries) const {
+  std::ostringstream sstr;
+  sstr << index_header << "\n";
+  for(const auto& e : entries) {
+    sstr << e.first << " " << e.second.size << " " << e.second.last_access
+         << " " << e.second.hit_count << "\n";
+  }
+
+  if(!common::filesystem::atomic_write(_index_file, sstr.str())) {
+    HIPSYCL_DEBUG_ERROR << "jit_cache_index: Could not write index file "
+                        << _index_file << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void jit_cache_index::rebuild_from_directory(entry_map &out) const {
+  out.clear();
+  uint64_t now = current_time();
+  try {
+    for(const auto& filename :
+        common::filesystem::list_regular_files(_cache_dir, ".jit")) {
+      entry e;
+      e.size = fs::file_size(filename);
+      e.last_access = now;
+      out[common::filesystem::get_filename(filename)] = e;
+    }
+  } catch(const fs::filesystem_error& err) {
+    HIPSYCL_DEBUG_WARNING << "jit_cache_index: Could not scan cache directory "
+                          << _cache_dir << ": " << err.what() << std::endl;
+  }
+}
+
+void jit_cache_index::evict(entry_map &entries,
+                            const std::string &protected_entry) const {
+  std::size_t total_size = 0;
+  for(const auto& e : entries)
+    total_size += e.second.size;
+
+  if(total_size <= _max_size)
+    return;
+
+  std::vector<std::pair<std::string, entry>> candidates{entries.begin(),
+                                                        entries.end()};
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto &a, const auto &b) {
+              return a.second.last_access < b.second.last_access;
+            });
+
+  for(const auto& candidate : candidates) {
+    if(total_size <= _max_size)
+      break;
+    if(candidate.first == protected_entry)
+      continue;
+
+    HIPSYCL_DEBUG_INFO << "jit_cache_index: Evicting " << candidate.first
+                       << " (" << candidate.second.size << " bytes)"
+                       << std::endl;
+    // Processes that currently have the file opened can still read it
+    common::filesystem::remove(
+        common::filesystem::join_path(_cache_dir, candidate.first));
+    entries.erase(candidate.first);
+    total_size -= candidate.second.size;
+  }
+}
+
+std::pair<int64_t, std::size_t> jit_cache_index::get_on_disk_state() const {
+#ifndef _WIN32
+  // A single stat() instead of separate queries for time and size
+  struct stat info;
+  if(::stat(_index_file.c_str(), &info) != 0)
+    return std::make_pair(int64_t{-1}, std::size_t{0});
+  return std::make_pair(
+      static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 +
+          static_cast<int64_t>(info.st_mtim.tv_nsec),
+      static_cast<std::size_t>(info.st_size));
+#else
+  std::error_code ec;
+  auto timestamp = fs::last_write_time(_index_file, ec);
+  if(ec)
+    return std::make_pair(int64_t{-1}, std::size_t{0});
+  auto size = fs::file_size(_index_file, ec);
+  if(ec)
+    return std::make_pair(int64_t{-1}, std::size_t{0});
+  return std::make_pair(
+      static_cast<int64_t>(timestamp.time_since_epoch().count()),
+      static_cast<std::size_t>(size));
+#endif
+}
+
+}
+}
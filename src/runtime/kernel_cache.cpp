@@ -36,6 +36,7 @@
 #include <fstream>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 namespace hipsycl {
 namespace rt {
@@ -103,6 +104,10 @@ hcf_kernel_info::hcf_kernel_info(
     std::size_t arg_original_index = std::stoll(*original_index);
     if(*type == "pointer") {
       _arg_types.push_back(pointer);
+    } else if(*type == "integer") {
+      _arg_types.push_back(integer);
+    } else if(*type == "floating-point") {
+      _arg_types.push_back(floating_point);
     } else {
       _arg_types.push_back(other);
     }
@@ -424,6 +429,14 @@ hcf_cache::get_image_info(hcf_object_id obj,
 
 
 
+kernel_cache::kernel_cache() {
+  std::size_t max_size_mib =
+      application::get_settings().get<setting::jit_cache_max_size>();
+  _persistent_cache_index = std::make_unique<jit_cache_index>(
+      common::filesystem::tuningdb::get().get_jit_cache_dir(),
+      max_size_mib * 1024 * 1024);
+}
+
 std::shared_ptr<kernel_cache> kernel_cache::get() {
   // required since kernel_cache has a private default constructor
   struct make_shared_enabler : public kernel_cache {};
@@ -434,7 +447,10 @@ std::shared_ptr<kernel_cache> kernel_cache::get() {
 void kernel_cache::unload() {
   std::lock_guard<std::mutex> lock{_mutex};
 
+  _epoch.fetch_add(1, std::memory_order_acq_rel);
   _code_objects.clear();
+  _prefetched_binaries.clear();
+  _persistent_cache_index->flush();
 }
 
 const code_object* kernel_cache::get_code_object(code_object_id id) const {
@@ -449,34 +465,72 @@ const code_object* kernel_cache::get_code_object_impl(code_object_id id) const {
   return it->second.get();
 }
 
+kernel_cache::jit_slot_guard::jit_slot_guard(kernel_cache& cache)
+: _cache{cache} {
+  std::size_t max_jit_compilations = application::get_settings()
+                                .get<setting::max_parallel_jit_compilations>();
+  if(max_jit_compilations == 0)
+    max_jit_compilations =
+        std::max(std::thread::hardware_concurrency(), 1u);
+
+  std::unique_lock<std::mutex> lock{_cache._jit_slot_mutex};
+  _cache._jit_slot_available.wait(lock, [&]() {
+    return _cache._num_active_jit_compilations < max_jit_compilations;
+  });
+  ++_cache._num_active_jit_compilations;
+}
+
+kernel_cache::jit_slot_guard::~jit_slot_guard() {
+  {
+    std::lock_guard<std::mutex> lock{_cache._jit_slot_mutex};
+    --_cache._num_active_jit_compilations;
+  }
+  _cache._jit_slot_available.notify_one();
+}
+
 std::string kernel_cache::get_persistent_cache_file(code_object_id id_of_binary) {
   using namespace common::filesystem;
   std::string cache_dir = tuningdb::get().get_jit_cache_dir();
   return join_path(cache_dir, glue::kernel_configuration::to_string(id_of_binary)+".jit");
 }
 
-bool kernel_cache::persistent_cache_lookup(code_object_id id_of_binary,
-                                           std::string &out) const {
+bool kernel_cache::is_in_persistent_cache(code_object_id id_of_binary) const {
+  return _persistent_cache_index->contains(
+      common::filesystem::get_filename(get_persistent_cache_file(id_of_binary)));
+}
+
+void kernel_cache::store_in_persistent_cache(code_object_id id_of_binary,
+                                             std::string_view binary) const {
+  persistent_cache_store(id_of_binary, binary);
+}
+
+kernel_cache::binary_ptr
+kernel_cache::persistent_cache_lookup(code_object_id id_of_binary) const {
   std::string filename = get_persistent_cache_file(id_of_binary);
-  std::ifstream file{filename, std::ios::in | std::ios::binary | std::ios::ate};
-  
-  if(!file.is_open())
-    return false;
+  std::string index_entry = common::filesystem::get_filename(filename);
+
+  // Avoid touching the file system for binaries that are not in the cache
+  if(!_persistent_cache_index->contains(index_entry))
+    return nullptr;
+
+  binary_ptr binary = read_jit_cache_entry(filename);
+  if(!binary) {
+    // File was removed behind the index' back, or is corrupt
+    _persistent_cache_index->remove(index_entry);
+    return nullptr;
+  }
 
   HIPSYCL_DEBUG_INFO << "kernel_cache: Persistent cache hit for id "
                      << glue::kernel_configuration::to_string(id_of_binary)
                      << " in file " << filename << std::endl;
 
-  std::streamsize file_size = file.tellg();
-  file.seekg(0, std::ios::beg);
-  out.resize(file_size);
-  file.read(out.data(), file_size);
+  _persistent_cache_index->record_hit(index_entry);
   
-  return true;
+  return binary;
 }
 
 void kernel_cache::persistent_cache_store(code_object_id id_of_binary,
-                                          const std::string &data) const {
+                                          std::string_view data) const {
   if(application::get_settings().get<setting::no_jit_cache_population>())
     return;
 
@@ -486,11 +540,24 @@ void kernel_cache::persistent_cache_store(code_object_id id_of_binary,
                      << glue::kernel_configuration::to_string(id_of_binary)
                      << " in persistent cache file " << filename << std::endl;
   
+  jit_cache_compression compression =
+      application::get_settings().get<setting::jit_cache_compression>();
+  if(!is_jit_cache_compression_supported(compression)) {
+    HIPSYCL_DEBUG_WARNING << "kernel_cache: Requested JIT cache compression is "
+                             "not supported by this build, storing "
+                             "uncompressed binary"
+                          << std::endl;
+    compression = jit_cache_compression::none;
+  }
 
-  if(!common::filesystem::atomic_write(filename, data)) {
+  std::size_t file_size = write_jit_cache_entry(filename, data, compression);
+  if(file_size == 0) {
     HIPSYCL_DEBUG_ERROR
         << "Could not store JIT result in persistent kernel cache in file "
         << filename << std::endl;
+  } else {
+    _persistent_cache_index->insert(common::filesystem::get_filename(filename),
+                                    file_size);
   }
 }
 
@@ -0,0 +1,325 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+std::string get_backend_name(backend_id b) {
+  switch(b) {
+  case backend_id::cuda:
+    return "cuda";
+  case backend_id::hip:
+    return "hip";
+  case backend_id::level_zero:
+    return "ze";
+  case backend_id::musa:
+    return "musa";
+  case backend_id::ocl:
+    return "ocl";
+  case backend_id::omp:
+    return "omp";
+  }
+  return "unknown";
+}
+
+bool get_backend_from_name(const std::string& name, backend_id& out) {
+  for(backend_id b : {backend_id::cuda, backend_id::hip, backend_id::level_zero,
+                      backend_id::musa, backend_id::ocl, backend_id::omp}) {
+    if(get_backend_name(b) == name) {
+      out = b;
+      return true;
+    }
+  }
+  return false;
+}
+
+}
+
+std::string serialize(const recorded_kernel_configuration& entry) {
+  std::stringstream sstr;
+  sstr << get_backend_name(entry.backend) << " " << entry.hcf_object << " "
+       << entry.image_name << " " << entry.kernel_names.size();
+  for(const auto& kernel : entry.kernel_names)
+    sstr << " " << kernel;
+  sstr << " ";
+  entry.config.serialize(sstr);
+  return sstr.str();
+}
+
+bool deserialize(const std::string &line, recorded_kernel_configuration &out) {
+  std::stringstream sstr{line};
+
+  recorded_kernel_configuration result;
+  std::string backend_name;
+  std::size_t num_kernels = 0;
+  sstr >> backend_name >> result.hcf_object >> result.image_name >> num_kernels;
+  if(sstr.fail() || !get_backend_from_name(backend_name, result.backend))
+    return false;
+
+  for(std::size_t i = 0; i < num_kernels && sstr; ++i) {
+    std::string kernel;
+    sstr >> kernel;
+    result.kernel_names.push_back(kernel);
+  }
+  if(sstr.fail() ||
+     !glue::kernel_configuration::deserialize(sstr, result.config))
+    return false;
+
+  out = result;
+  return true;
+}
+
+bool read_kernel_configuration_log(
+    const std::string &filename,
+    std::vector<recorded_kernel_configuration> &out) {
+  std::ifstream file{filename};
+  if(!file.is_open())
+    return false;
+
+  std::string line;
+  std::size_t line_number = 0;
+  while(std::getline(file, line)) {
+    ++line_number;
+    if(line.empty() || line[0] == '#')
+      continue;
+
+    recorded_kernel_configuration entry;
+    if(deserialize(line, entry)) {
+      out.push_back(entry);
+    } else {
+      HIPSYCL_DEBUG_WARNING << "kernel_configuration_log: Skipping invalid "
+                               "entry in line "
+                            << line_number << " of " << filename << std::endl;
+    }
+  }
+  return true;
+}
+
+bool append_to_kernel_configuration_log(
+    const std::string &filename,
+    const std::vector<recorded_kernel_configuration> &entries) {
+  // Assemble everything first, so that concurrent writers from
+  // different processes are unlikely to interleave within a line.
+  std::string data;
+  for(const auto& entry : entries)
+    data += serialize(entry) + "\n";
+
+  std::ofstream file{filename, std::ios::out | std::ios::app};
+  if(!file.is_open())
+    return false;
+  file << data;
+  file.flush();
+  return file.good();
+}
+
+kernel_configuration_recorder &kernel_configuration_recorder::get() {
+  static kernel_configuration_recorder recorder;
+  return recorder;
+}
+
+kernel_configuration_recorder::kernel_configuration_recorder()
+    : _log_file{application::get_settings()
+                    .get<setting::record_kernel_configurations>()} {
+  _is_enabled = !_log_file.empty();
+
+  if(_is_enabled) {
+    // Don't record configurations again that are already in the log,
+    // e.g. from previous runs.
+    std::vector<recorded_kernel_configuration> existing_entries;
+    if(read_kernel_configuration_log(_log_file, existing_entries)) {
+      for(const auto& entry : existing_entries)
+        _recorded_binaries.insert(entry.config.generate_id());
+    }
+    HIPSYCL_DEBUG_INFO << "kernel_configuration_recorder: Recording kernel "
+                          "configurations to "
+                       << _log_file << " (" << _recorded_binaries.size()
+                       << " already recorded)" << std::endl;
+  }
+}
+
+bool kernel_configuration_recorder::mark_as_recorded(
+    const glue::kernel_configuration::id_type &binary_id) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _recorded_binaries.insert(binary_id).second;
+}
+
+void kernel_configuration_recorder::append(
+    const recorded_kernel_configuration &entry) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(!append_to_kernel_configuration_log(_log_file, {entry})) {
+    HIPSYCL_DEBUG_WARNING << "kernel_configuration_recorder: Could not write "
+                             "to kernel configuration log "
+                          << _log_file << std::endl;
+  }
+}
+
+kernel_configuration_replayer::kernel_configuration_replayer(
+    backend_manager &backends, const std::string &log_file)
+    : _backends{&backends}, _stop_requested{false},
+      _initialization_state{std::make_shared<backend_initialization_state>()} {
+
+  std::vector<recorded_kernel_configuration> entries;
+  if(!read_kernel_configuration_log(log_file, entries)) {
+    HIPSYCL_DEBUG_WARNING << "kernel_configuration_replayer: Could not open "
+                             "kernel configuration log "
+                          << log_file << std::endl;
+    return;
+  }
+
+  HIPSYCL_DEBUG_INFO << "kernel_configuration_replayer: Replaying "
+                     << entries.size() << " kernel configurations from "
+                     << log_file << std::endl;
+
+  // Capture the state by value, since backends might still be created
+  // after the replayer has been destroyed.
+  _backends->add_initialization_listener(
+      [state = _initialization_state](backend *) {
+        std::lock_guard<std::mutex> lock{state->mutex};
+        ++state->num_initialized_backends;
+        state->cv.notify_all();
+      });
+
+  _worker = std::thread{[this, entries = std::move(entries)]() mutable {
+    replay(std::move(entries));
+  }};
+}
+
+kernel_configuration_replayer::~kernel_configuration_replayer() {
+  _stop_requested = true;
+  {
+    std::lock_guard<std::mutex> lock{_initialization_state->mutex};
+    _initialization_state->stop_requested = true;
+  }
+  _initialization_state->cv.notify_all();
+  if(_worker.joinable())
+    _worker.join();
+}
+
+void kernel_configuration_replayer::replay(
+    std::vector<recorded_kernel_configuration> entries) {
+  std::size_t num_entries = entries.size();
+  std::size_t num_compiled = 0;
+
+  while(!entries.empty() && !_stop_requested) {
+    std::size_t num_initialized_backends = 0;
+    {
+      std::lock_guard<std::mutex> lock{_initialization_state->mutex};
+      num_initialized_backends =
+          _initialization_state->num_initialized_backends;
+    }
+
+    // Entries for backends that have not been created yet
+    std::vector<recorded_kernel_configuration> deferred;
+    for(auto& entry : entries) {
+      if(_stop_requested)
+        break;
+
+      const backend *b = _backends->get_if_initialized(entry.backend);
+      if(!b && _backends->is_initialization_pending(entry.backend)) {
+        deferred.push_back(std::move(entry));
+        continue;
+      }
+      // The backend might have been created in the meantime
+      if(!b)
+        b = _backends->get_if_initialized(entry.backend);
+      if(!b) {
+        HIPSYCL_DEBUG_INFO << "kernel_configuration_replayer: Skipping entry "
+                              "for unavailable backend"
+                           << std::endl;
+        continue;
+      }
+
+      if(replay_entry(b, entry))
+        ++num_compiled;
+    }
+
+    entries = std::move(deferred);
+    if(!entries.empty()) {
+      HIPSYCL_DEBUG_INFO << "kernel_configuration_replayer: Deferring "
+                         << entries.size()
+                         << " entries until their backends are initialized"
+                         << std::endl;
+      std::unique_lock<std::mutex> lock{_initialization_state->mutex};
+      _initialization_state->cv.wait(lock, [&]() {
+        return _initialization_state->stop_requested ||
+               _initialization_state->num_initialized_backends !=
+                   num_initialized_backends;
+      });
+    }
+  }
+
+  HIPSYCL_DEBUG_INFO << "kernel_configuration_replayer: " << num_compiled
+                     << " of " << num_entries
+                     << " recorded kernel configurations are ready"
+                     << std::endl;
+}
+
+bool kernel_configuration_replayer::replay_entry(
+    const backend *b, const recorded_kernel_configuration &entry) {
+  const common::hcf_container *hcf =
+      hcf_cache::get().get_hcf(entry.hcf_object);
+  if(!hcf) {
+    // The log might also contain entries from other applications or
+    // from objects that have not been loaded.
+    HIPSYCL_DEBUG_INFO << "kernel_configuration_replayer: Skipping entry "
+                          "for unknown HCF object "
+                       << entry.hcf_object << std::endl;
+    return false;
+  }
+
+  auto binary_id = entry.config.generate_id();
+  return kernel_cache::get()->prefetch_jit_binary(
+      binary_id, [&](std::string &compiled_image) -> bool {
+        result err =
+            b->jit_compile_recorded_configuration(hcf, entry, compiled_image);
+        if(!err.is_success()) {
+          HIPSYCL_DEBUG_WARNING
+              << "kernel_configuration_replayer: JIT compilation of "
+                 "recorded configuration "
+              << glue::kernel_configuration::to_string(binary_id)
+              << " failed: " << err.what() << std::endl;
+          return false;
+        }
+        return true;
+      });
+}
+
+}
+}
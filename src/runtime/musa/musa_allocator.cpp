@@ -38,7 +38,7 @@ musa_allocator::musa_allocator(backend_descriptor desc, int musa_device)
     : _backend_descriptor{desc}, _dev{musa_device}
 {}
       
-void *musa_allocator::allocate(size_t min_alignment, size_t size_bytes)
+void *musa_allocator::raw_allocate(size_t min_alignment, size_t size_bytes)
 {
   void *ptr;
   musa_device_manager::get().activate_device(_dev);
@@ -55,8 +55,8 @@ void *musa_allocator::allocate(size_t min_alignment, size_t size_bytes)
   return ptr;
 }
 
-void *musa_allocator::allocate_optimized_host(size_t min_alignment,
-                                             size_t bytes) {
+void *musa_allocator::raw_allocate_optimized_host(size_t min_alignment,
+                                                 size_t bytes) {
   void *ptr;
   musa_device_manager::get().activate_device(_dev);
 
@@ -72,7 +72,7 @@ void *musa_allocator::allocate_optimized_host(size_t min_alignment,
   return ptr;
 }
 
-void musa_allocator::free(void *mem) {
+void musa_allocator::raw_free(void *mem) {
 
   pointer_info info;
   result query_result = query_pointer(mem, info);
@@ -96,7 +96,7 @@ void musa_allocator::free(void *mem) {
   }
 }
 
-void * musa_allocator::allocate_usm(size_t bytes)
+void * musa_allocator::raw_allocate_usm(size_t bytes)
 {
   musa_device_manager::get().activate_device(_dev);
   
@@ -113,6 +113,10 @@ void * musa_allocator::allocate_usm(size_t bytes)
   return ptr;
 }
 
+device_id musa_allocator::get_device() const {
+  return device_id{_backend_descriptor, _dev};
+}
+
 bool musa_allocator::is_usm_accessible_from(backend_descriptor b) const
 {
   // TODO: Formulate this better - this assumes that either CUDA+CPU or
@@ -52,6 +52,7 @@
 
 #include "hipSYCL/compiler/llvm-to-backend/musa/LLVMToMusaFactory.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
 
 #endif
 
@@ -606,8 +607,8 @@ result musa_queue::submit_sscp_kernel_from_code_object(
   }
 
   kernel_adaptivity_engine adaptivity_engine{
-      hcf_object, kernel_name, kernel_info, num_groups,
-      group_size, args,        arg_sizes,   num_args, local_mem_size};
+      this->get_device(), hcf_object, kernel_name, kernel_info, num_groups,
+      group_size,         args,       arg_sizes,   num_args,    local_mem_size};
 
   static thread_local glue::kernel_configuration config;
   config = initial_config;
@@ -638,6 +639,10 @@ result musa_queue::submit_sscp_kernel_from_code_object(
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
+  kernel_configuration_recorder::get().record(
+      backend_id::musa, hcf_object, binary_configuration_id, config,
+      get_image_and_kernel_names);
+
   auto jit_compiler = [&](std::string& compiled_image) -> bool {
     const common::hcf_container* hcf = rt::hcf_cache::get().get_hcf(hcf_object);
     
@@ -34,10 +34,10 @@
 namespace hipsycl {
 namespace rt {
 
-ocl_allocator::ocl_allocator(ocl_usm* usm)
-: _usm{usm} {}
+ocl_allocator::ocl_allocator(device_id dev, ocl_usm* usm)
+: _dev_id{dev}, _usm{usm} {}
 
-void* ocl_allocator::allocate(size_t min_alignment, size_t size_bytes) {
+void* ocl_allocator::raw_allocate(size_t min_alignment, size_t size_bytes) {
   if(!_usm->is_available()) {
     register_error(__hipsycl_here(),
                    error_info{"ocl_allocator: OpenCL device does not have valid USM provider",
@@ -57,8 +57,8 @@ void* ocl_allocator::allocate(size_t min_alignment, size_t size_bytes) {
   return ptr;
 }
 
-void *ocl_allocator::allocate_optimized_host(size_t min_alignment,
-                                             size_t bytes) {
+void *ocl_allocator::raw_allocate_optimized_host(size_t min_alignment,
+                                                 size_t bytes) {
   if(!_usm->is_available()) {
     register_error(__hipsycl_here(),
                    error_info{"ocl_allocator: OpenCL device does not have valid USM provider",
@@ -77,7 +77,7 @@ void *ocl_allocator::allocate_optimized_host(size_t min_alignment,
   return ptr;
 }
 
-void ocl_allocator::free(void *mem) {
+void ocl_allocator::raw_free(void *mem) {
   if(!_usm->is_available()) {
     register_error(__hipsycl_here(),
                    error_info{"ocl_allocator: OpenCL device does not have valid USM provider",
@@ -93,7 +93,7 @@ void ocl_allocator::free(void *mem) {
   }
 }
 
-void *ocl_allocator::allocate_usm(size_t bytes) {
+void *ocl_allocator::raw_allocate_usm(size_t bytes) {
   if(!_usm->is_available()) {
     register_error(__hipsycl_here(),
                    error_info{"ocl_allocator: OpenCL device does not have valid USM provider",
@@ -112,6 +112,10 @@ void *ocl_allocator::allocate_usm(size_t bytes) {
   return ptr;
 }
 
+device_id ocl_allocator::get_device() const {
+  return _dev_id;
+}
+
 bool ocl_allocator::is_usm_accessible_from(backend_descriptor b) const {
   // TODO: This is INCORRECT. We would need to compare the OpenCL platform, not
   // just the backend descriptor. The current API does not allow for that.
@@ -35,6 +35,14 @@
 #include "hipSYCL/runtime/ocl/ocl_backend.hpp"
 #include "hipSYCL/runtime/ocl/ocl_hardware_manager.hpp"
 #include "hipSYCL/runtime/ocl/ocl_queue.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+#include "hipSYCL/compiler/llvm-to-backend/spirv/LLVMToSpirvFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#endif
+
 #include <memory>
 
 HIPSYCL_PLUGIN_API_EXPORT
@@ -124,5 +132,17 @@ ocl_backend::create_inorder_executor(device_id dev, int priority) {
   return std::make_unique<inorder_executor>(std::move(q));
 }
 
+result ocl_backend::jit_compile_recorded_configuration(
+    const common::hcf_container *hcf,
+    const recorded_kernel_configuration &entry,
+    std::string &binary_out) const {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  return glue::jit::compile_recorded_configuration(
+      compiler::createLLVMToSpirvTranslator, hcf, entry, binary_out);
+#else
+  return backend::jit_compile_recorded_configuration(hcf, entry, binary_out);
+#endif
+}
+
 }
 }
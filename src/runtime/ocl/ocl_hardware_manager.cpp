@@ -38,6 +38,8 @@
 #include <cstddef>
 #include <array>
 #include <optional>
+#include <string>
+#include <vector>
 
 
 namespace hipsycl {
@@ -53,6 +55,42 @@ constexpr std::array incompatible_ocl_platforms = {
     "NVIDIA CUDA", "Intel(R) FPGA Emulation Platform for OpenCL(TM)",
     "AMD Accelerated Parallel Processing"};
 
+// Copies num_slices x num_rows rows of row_size elements. Pitches are in
+// elements. Work items in dimension 0 stride over the row, while
+// dimensions 1 and 2 select the row and the slice.
+// The USM pointers are passed as integers, since clSetKernelArg expects
+// cl_mem handles for __global pointer arguments.
+constexpr const char* builtin_kernel_source = R"(
+#define ACPP_STRIDED_MEMCPY(T)                                                 \
+  __kernel void acpp_strided_memcpy_##T(                                       \
+      ulong dest_addr, ulong src_addr, ulong row_size, ulong num_rows,         \
+      ulong dest_row_pitch, ulong dest_slice_pitch, ulong src_row_pitch,       \
+      ulong src_slice_pitch) {                                                 \
+    ulong row = get_global_id(1);                                              \
+    ulong slice = get_global_id(2);                                            \
+    if (row >= num_rows)                                                       \
+      return;                                                                  \
+    __global T *dest = (__global T *)dest_addr;                                \
+    __global const T *src = (__global const T *)src_addr;                      \
+    __global T *d = dest + slice * dest_slice_pitch + row * dest_row_pitch;    \
+    __global const T *s = src + slice * src_slice_pitch + row * src_row_pitch; \
+    for (ulong i = get_global_id(0); i < row_size; i += get_global_size(0))    \
+      d[i] = s[i];                                                             \
+  }
+
+ACPP_STRIDED_MEMCPY(uchar)
+ACPP_STRIDED_MEMCPY(ushort)
+ACPP_STRIDED_MEMCPY(uint)
+ACPP_STRIDED_MEMCPY(ulong)
+ACPP_STRIDED_MEMCPY(uint4)
+)";
+
+// Indexed by log2 of the element size
+constexpr std::array strided_memcpy_kernel_names = {
+    "acpp_strided_memcpy_uchar", "acpp_strided_memcpy_ushort",
+    "acpp_strided_memcpy_uint", "acpp_strided_memcpy_ulong",
+    "acpp_strided_memcpy_uint4"};
+
 template<int Query, class ResultT>
 ResultT info_query(const cl::Device& dev) {
   ResultT r{};
@@ -513,6 +551,58 @@ cl::Context ocl_hardware_context::get_cl_context() const {
   return _ctx;
 }
 
+result ocl_hardware_context::get_strided_memcpy_kernel(std::size_t element_size,
+                                                       cl::Kernel &out) {
+  builtin_kernels& kernels = *_builtin_kernels;
+
+  std::call_once(kernels.build_flag, [&](){
+    cl_int err;
+    cl::Program program{_ctx, std::string{builtin_kernel_source}, false, &err};
+    if(err == CL_SUCCESS)
+      err = program.build(std::vector<cl::Device>{_dev});
+
+    if(err != CL_SUCCESS) {
+      std::string build_log;
+      program.getBuildInfo(_dev, CL_PROGRAM_BUILD_LOG, &build_log);
+      kernels.build_result = make_error(
+          __hipsycl_here(),
+          error_info{"ocl_hardware_context: Building built-in kernels failed, "
+                     "build log: " + build_log,
+                     error_code{"CL", static_cast<int>(err)}});
+      HIPSYCL_DEBUG_WARNING << kernels.build_result.what() << std::endl;
+      return;
+    }
+
+    for(std::size_t i = 0; i < kernels.strided_memcpy.size(); ++i) {
+      kernels.strided_memcpy[i] =
+          cl::Kernel{program, strided_memcpy_kernel_names[i], &err};
+      if(err != CL_SUCCESS) {
+        kernels.build_result = make_error(
+            __hipsycl_here(),
+            error_info{"ocl_hardware_context: Could not construct built-in "
+                       "kernel " + std::string{strided_memcpy_kernel_names[i]},
+                       error_code{"CL", static_cast<int>(err)}});
+        return;
+      }
+    }
+    kernels.build_result = make_success();
+  });
+
+  if(!kernels.build_result.is_success())
+    return kernels.build_result;
+
+  for(std::size_t i = 0; i < kernels.strided_memcpy.size(); ++i) {
+    if(element_size == (std::size_t{1} << i)) {
+      out = kernels.strided_memcpy[i];
+      return make_success();
+    }
+  }
+  return make_error(
+      __hipsycl_here(),
+      error_info{"ocl_hardware_context: Invalid element size for strided "
+                 "memcpy kernel: " + std::to_string(element_size)});
+}
+
 void ocl_hardware_context::init_allocator(ocl_hardware_manager *mgr) {
   _usm_provider = ocl_usm::from_intel_extension(mgr, _dev_id);
   if(!_usm_provider->is_available()) {
@@ -532,7 +622,7 @@ void ocl_hardware_context::init_allocator(ocl_hardware_manager *mgr) {
                              "allocations are not possible on that device."
                           << std::endl;
   }
-  _alloc = ocl_allocator{_usm_provider.get()};
+  _alloc = ocl_allocator{mgr->get_device_id(_dev_id), _usm_provider.get()};
 }
 
 ocl_hardware_manager::ocl_hardware_manager()
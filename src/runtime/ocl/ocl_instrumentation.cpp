@@ -0,0 +1,90 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/ocl/ocl_instrumentation.hpp"
+#include "hipSYCL/runtime/ocl/ocl_event.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/util.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+cl_ulong get_profiling_counter(const dag_node_event &evt,
+                               cl_profiling_info counter) {
+  cl::Event cl_evt = cast<const ocl_node_event>(&evt)->get_event();
+
+  cl_ulong ns = 0;
+  cl_int err = cl_evt.getProfilingInfo(counter, &ns);
+  if(err != CL_SUCCESS) {
+    register_error(
+        __hipsycl_here(),
+        error_info{"ocl_instrumentation: clGetEventProfilingInfo() failed",
+                   error_code{"CL", static_cast<int>(err)}});
+  }
+  return ns;
+}
+
+profiler_clock::duration profiling_counter_delta(const dag_node_event &t0,
+                                                 const dag_node_event &t1,
+                                                 cl_profiling_info counter) {
+  assert(t0.is_complete());
+  assert(t1.is_complete());
+
+  // The reference event t0 is the point at which the host timestamp
+  // was taken, so we measure from the end of its execution.
+  cl_ulong t0_ns = get_profiling_counter(t0, CL_PROFILING_COMMAND_END);
+  cl_ulong t1_ns = get_profiling_counter(t1, counter);
+
+  // The device counters are 64-bit nanosecond values, so
+  // the difference is already in the profiler_clock resolution.
+  // Unsigned wrap-around preserves the result should the device
+  // report t1 slightly before t0.
+  return profiler_clock::duration{
+      static_cast<profiler_clock::rep>(t1_ns - t0_ns)};
+}
+
+}
+
+profiler_clock::duration
+ocl_event_start_time_delta::operator()(const dag_node_event& t0,
+                                       const dag_node_event& t1) const {
+  return profiling_counter_delta(t0, t1, CL_PROFILING_COMMAND_START);
+}
+
+profiler_clock::duration
+ocl_event_finish_time_delta::operator()(const dag_node_event& t0,
+                                        const dag_node_event& t1) const {
+  return profiling_counter_delta(t0, t1, CL_PROFILING_COMMAND_END);
+}
+
+}
+}
@@ -28,22 +28,29 @@
 
 #include "hipSYCL/glue/kernel_configuration.hpp"
 #include "hipSYCL/runtime/adaptivity_engine.hpp"
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
 #include "hipSYCL/runtime/kernel_cache.hpp"
 #include "hipSYCL/runtime/inorder_queue.hpp"
 #include "hipSYCL/runtime/executor.hpp"
 #include "hipSYCL/runtime/code_object_invoker.hpp"
+#include "hipSYCL/runtime/generic/strided_memcpy.hpp"
 #include "hipSYCL/runtime/ocl/ocl_code_object.hpp"
 #include "hipSYCL/runtime/queue_completion_event.hpp"
 #include "hipSYCL/runtime/ocl/ocl_event.hpp"
+#include "hipSYCL/runtime/ocl/ocl_instrumentation.hpp"
 #include "hipSYCL/runtime/ocl/ocl_queue.hpp"
 #include "hipSYCL/runtime/ocl/ocl_hardware_manager.hpp"
 
+#include <algorithm>
+#include <cstdint>
+
 #ifdef HIPSYCL_WITH_SSCP_COMPILER
 
 #include "hipSYCL/compiler/llvm-to-backend/spirv/LLVMToSpirvFactory.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
 #include <CL/cl.h>
 
 #endif
@@ -127,13 +134,102 @@ result submit_ocl_kernel(cl::Kernel& kernel,
 
 }
 
+class ocl_instrumentation_guard {
+public:
+  ocl_instrumentation_guard(ocl_queue *q,
+                            operation &op, dag_node_ptr node)
+                            : _queue{q}, _operation{&op}, _node{node} {
+    assert(q);
+
+    if(!_node)
+      return;
+
+    const execution_hints& hints = _node->get_execution_hints();
+
+    if (hints.has_hint<
+            rt::hints::request_instrumentation_submission_timestamp>()) {
+      op.get_instrumentations()
+          .add_instrumentation<instrumentations::submission_timestamp>(
+            std::make_shared<ocl_submission_timestamp>(profiler_clock::now()));
+    }
+
+    // Execution timestamps require a profiling queue
+    if(!_queue->is_profiling_enabled())
+      return;
+
+    _needs_start =
+        hints.has_hint<rt::hints::request_instrumentation_start_timestamp>();
+    _needs_finish =
+        hints.has_hint<rt::hints::request_instrumentation_finish_timestamp>();
+
+    // The reference must be enqueued before the operation so that
+    // all timestamps of the operation are measured relative to
+    // a point in the past.
+    if((_needs_start || _needs_finish) && !_queue->get_timing_reference()) {
+      _needs_start = false;
+      _needs_finish = false;
+    }
+  }
+
+  bool needs_execution_timestamps() const {
+    return _needs_start || _needs_finish;
+  }
+
+  // Attaches the requested execution timestamps. Must only be called once
+  // all commands of the operation have been enqueued successfully. Start
+  // and finish are read from the profiling information of the first and
+  // last command of the operation, respectively.
+  void instrument(const cl::Event& first, const cl::Event& last) {
+    if(!needs_execution_timestamps())
+      return;
+
+    auto last_event =
+        std::make_shared<ocl_node_event>(_queue->get_device(), last);
+    if(first.get() == last.get())
+      instrument_events(last_event, last_event);
+    else
+      instrument_events(
+          std::make_shared<ocl_node_event>(_queue->get_device(), first),
+          last_event);
+  }
+
+  void instrument_events(std::shared_ptr<dag_node_event> first,
+                         std::shared_ptr<dag_node_event> last) {
+    if(_needs_start) {
+      _operation->get_instrumentations()
+          .add_instrumentation<instrumentations::execution_start_timestamp>(
+              std::make_shared<ocl_execution_start_timestamp>(
+                  *_queue->get_timing_reference(), first));
+    }
+    if(_needs_finish) {
+      _operation->get_instrumentations()
+          .add_instrumentation<instrumentations::execution_finish_timestamp>(
+              std::make_shared<ocl_execution_finish_timestamp>(
+                  *_queue->get_timing_reference(), last));
+    }
+  }
+
+private:
+  ocl_queue* _queue;
+  operation* _operation;
+  dag_node_ptr _node;
+  bool _needs_start = false;
+  bool _needs_finish = false;
+};
+
 class ocl_hardware_manager;
 
 ocl_queue::ocl_queue(ocl_hardware_manager* hw_manager, std::size_t device_index)
   : _hw_manager{hw_manager}, _device_index{device_index}, _sscp_invoker{this},
     _kernel_cache{kernel_cache::get()} {
 
-  cl_command_queue_properties props = 0;
+  // Profiling has to be enabled at queue construction. This only makes
+  // the OpenCL implementation record timestamps; we query them
+  // exclusively for operations that request instrumentation.
+  _is_profiling_enabled =
+      application::get_settings().get<setting::ocl_enable_profiling>();
+  cl_command_queue_properties props =
+      _is_profiling_enabled ? CL_QUEUE_PROFILING_ENABLE : 0;
   ocl_hardware_context *dev_ctx =
       static_cast<ocl_hardware_context *>(hw_manager->get_device(device_index));
   cl::Device cl_dev = dev_ctx->get_cl_device();
@@ -184,7 +280,7 @@ std::shared_ptr<dag_node_event> ocl_queue::create_queue_completion_event() {
       this);
 }
 
-result ocl_queue::submit_memcpy(memcpy_operation &op, dag_node_ptr) {
+result ocl_queue::submit_memcpy(memcpy_operation &op, dag_node_ptr node) {
 
   HIPSYCL_DEBUG_INFO << "ocl_queue: On device "
                      << _hw_manager->get_device_id(_device_index)
@@ -192,39 +288,21 @@ result ocl_queue::submit_memcpy(memcpy_operation &op, dag_node_ptr) {
                      << op.source().get_device() << " to "
                      << op.dest().get_device() << std::endl;
 
-  // TODO We could probably unify some of the logic here between
-  // backends
-
   assert(op.source().get_access_ptr());
   assert(op.dest().get_access_ptr());
 
-  range<3> transfer_range = op.get_num_transferred_elements();
-
-  int dimension = 0;
-  if (transfer_range[0] > 1)
-    dimension = 3;
-  else if (transfer_range[1] > 1)
-    dimension = 2;
-  else
-    dimension = 1;
-
-  // If we transfer the entire buffer, treat it as 1D memcpy for performance.
-  // TODO: The same optimization could also be applied for the general case
-  // when regions are contiguous
-  if (op.get_num_transferred_elements() == op.source().get_allocation_shape() &&
-      op.get_num_transferred_elements() == op.dest().get_allocation_shape() &&
-      op.source().get_access_offset() == id<3>{} &&
-      op.dest().get_access_offset() == id<3>{})
-    dimension = 1;
-  
-  assert(dimension >= 1 && dimension <= 3);
+  strided_memcpy_layout layout{op};
+
+  ocl_hardware_context *ocl_ctx = static_cast<ocl_hardware_context *>(
+      _hw_manager->get_device(_device_index));
+  ocl_usm* usm = ocl_ctx->get_usm_provider();
 
   cl::Event evt;
+  // Only differs from evt if the operation consists of multiple commands
+  cl::Event first_evt;
+  ocl_instrumentation_guard instrumentation{this, op, node};
 
-  if(dimension == 1) {
-    ocl_hardware_context *ocl_ctx = static_cast<ocl_hardware_context *>(
-        _hw_manager->get_device(_device_index));
-    ocl_usm* usm = ocl_ctx->get_usm_provider();
+  if(layout.get_dimension() == 1) {
     cl_int err = usm->enqueue_memcpy(_queue, op.dest().get_access_ptr(),
                         op.source().get_access_ptr(),
                         op.get_num_transferred_bytes(), {}, &evt);
@@ -236,14 +314,65 @@ result ocl_queue::submit_memcpy(memcpy_operation &op, dag_node_ptr) {
                      error_code{"CL", static_cast<int>(err)}});
     }
   } else {
-    return make_error(
-        __hipsycl_here(),
-        error_info{
-            "ocl_queue: Multidimensional memory copies are not yet supported.",
-            error_type::unimplemented});
+    // USM has no rectangular copy API. Between device allocations of our
+    // context we can use a copy kernel, which handles many short rows
+    // much better than a separate memcpy command per row.
+    auto is_in_queue_context = [&](device_id dev) {
+      return dev.get_backend() == backend_id::ocl &&
+             _hw_manager->get_context(dev).get() ==
+                 ocl_ctx->get_cl_context().get();
+    };
+
+    bool is_submitted = false;
+    if(is_in_queue_context(op.source().get_device()) &&
+       is_in_queue_context(op.dest().get_device())) {
+      result res = submit_strided_memcpy_kernel(
+          layout, op.dest().get_access_ptr(), op.source().get_access_ptr(),
+          &evt);
+      if(res.is_success()) {
+        is_submitted = true;
+      } else {
+        HIPSYCL_DEBUG_WARNING
+            << "ocl_queue: Strided memcpy kernel unavailable, falling back to "
+               "row-wise copies"
+            << std::endl;
+      }
+    }
+
+    if(!is_submitted) {
+      char *dest = static_cast<char *>(op.dest().get_access_ptr());
+      const char *src = static_cast<const char *>(op.source().get_access_ptr());
+
+      // The queue is in-order, so only the last row needs an event for
+      // synchronization. The first row needs one for the start timestamp.
+      const std::size_t num_rows = layout.get_num_total_rows();
+      for(std::size_t i = 0; i < num_rows; ++i) {
+        std::size_t slice = i / layout.num_rows;
+        std::size_t row = i % layout.num_rows;
+
+        cl::Event *row_evt = nullptr;
+        if(i + 1 == num_rows)
+          row_evt = &evt;
+        else if(i == 0 && instrumentation.needs_execution_timestamps())
+          row_evt = &first_evt;
+
+        cl_int err = usm->enqueue_memcpy(
+            _queue, dest + layout.get_dest_row_offset(slice, row),
+            src + layout.get_src_row_offset(slice, row), layout.row_size, {},
+            row_evt);
+
+        if(err != CL_SUCCESS) {
+          return make_error(
+              __hipsycl_here(),
+              error_info{"ocl_queue: enqueuing memcpy failed",
+                         error_code{"CL", static_cast<int>(err)}});
+        }
+      }
+    }
   }
 
   register_submitted_op(evt);
+  instrumentation.instrument(first_evt.get() ? first_evt : evt, evt);
   return make_success();
 }
 
@@ -260,18 +389,31 @@ result ocl_queue::submit_kernel(kernel_operation &op, dag_node_ptr node) {
   cap.provide_sscp_invoker(&_sscp_invoker);
   l->set_backend_capabilities(cap);
   
-  // TODO: Instrumentation
+  ocl_instrumentation_guard instrumentation{this, op, node};
+  std::shared_ptr<dag_node_event> previous_event;
+  if(instrumentation.needs_execution_timestamps())
+    previous_event = _state.get_most_recent_event();
+
   l->invoke(node.get(), op.get_launcher().get_kernel_configuration());
 
+  // A successful launch has registered the event of the kernel
+  if(instrumentation.needs_execution_timestamps()) {
+    std::shared_ptr<dag_node_event> kernel_event =
+        _state.get_most_recent_event();
+    if(kernel_event != previous_event)
+      instrumentation.instrument_events(kernel_event, kernel_event);
+  }
+
   return make_success();
 }
 
-result ocl_queue::submit_prefetch(prefetch_operation &op, dag_node_ptr) {
+result ocl_queue::submit_prefetch(prefetch_operation &op, dag_node_ptr node) {
   ocl_hardware_context *ocl_ctx = static_cast<ocl_hardware_context *>(
         _hw_manager->get_device(_device_index));
   ocl_usm* usm = ocl_ctx->get_usm_provider();
 
   cl::Event evt;
+  ocl_instrumentation_guard instrumentation{this, op, node};
   cl_int err = 0;
   if(op.get_target().is_host()) {
     err = usm->enqueue_prefetch(_queue, op.get_pointer(), op.get_num_bytes(),
@@ -289,15 +431,17 @@ result ocl_queue::submit_prefetch(prefetch_operation &op, dag_node_ptr) {
   }
 
   register_submitted_op(evt);
+  instrumentation.instrument(evt, evt);
   return make_success();
 }
 
-result ocl_queue::submit_memset(memset_operation& op, dag_node_ptr) {
+result ocl_queue::submit_memset(memset_operation& op, dag_node_ptr node) {
   ocl_hardware_context *ocl_ctx = static_cast<ocl_hardware_context *>(
         _hw_manager->get_device(_device_index));
   ocl_usm* usm = ocl_ctx->get_usm_provider();
 
   cl::Event evt;
+  ocl_instrumentation_guard instrumentation{this, op, node};
   cl_int err = usm->enqueue_memset(_queue, op.get_pointer(), op.get_pattern(),
                                    op.get_num_bytes(), {}, &evt);
   if(err != CL_SUCCESS) {
@@ -308,6 +452,7 @@ result ocl_queue::submit_memset(memset_operation& op, dag_node_ptr) {
   }
 
   register_submitted_op(evt);
+  instrumentation.instrument(evt, evt);
   return make_success();
 }
 
@@ -404,6 +549,101 @@ ocl_hardware_manager *ocl_queue::get_hardware_manager() const {
   return _hw_manager;
 }
 
+result ocl_queue::submit_strided_memcpy_kernel(
+    const strided_memcpy_layout &layout, void *dest, const void *src,
+    cl::Event *evt_out) {
+
+  // Use the widest element type that all addresses and pitches are
+  // aligned to.
+  std::size_t element_size = 16;
+  auto is_aligned = [&](std::size_t x) { return x % element_size == 0; };
+  while (element_size > 1 &&
+         !(is_aligned(layout.row_size) &&
+           is_aligned(layout.src_row_pitch) &&
+           is_aligned(layout.src_slice_pitch) &&
+           is_aligned(layout.dest_row_pitch) &&
+           is_aligned(layout.dest_slice_pitch) &&
+           is_aligned(reinterpret_cast<std::uintptr_t>(dest)) &&
+           is_aligned(reinterpret_cast<std::uintptr_t>(src))))
+    element_size /= 2;
+
+  ocl_hardware_context *ocl_ctx = static_cast<ocl_hardware_context *>(
+      _hw_manager->get_device(_device_index));
+
+  cl::Kernel kernel;
+  result res = ocl_ctx->get_strided_memcpy_kernel(element_size, kernel);
+  if(!res.is_success())
+    return res;
+
+  cl_ulong row_size = layout.row_size / element_size;
+  cl_ulong num_rows = layout.num_rows;
+  cl_ulong dest_row_pitch = layout.dest_row_pitch / element_size;
+  cl_ulong dest_slice_pitch = layout.dest_slice_pitch / element_size;
+  cl_ulong src_row_pitch = layout.src_row_pitch / element_size;
+  cl_ulong src_slice_pitch = layout.src_slice_pitch / element_size;
+
+  // See the kernel source in ocl_hardware_manager.cpp
+  cl_ulong dest_addr = reinterpret_cast<std::uintptr_t>(dest);
+  cl_ulong src_addr = reinterpret_cast<std::uintptr_t>(src);
+
+  void *args[] = {&dest_addr,     &src_addr,       &row_size,
+                  &num_rows,      &dest_row_pitch, &dest_slice_pitch,
+                  &src_row_pitch, &src_slice_pitch};
+  std::size_t arg_sizes[] = {sizeof(cl_ulong), sizeof(cl_ulong),
+                             sizeof(cl_ulong), sizeof(cl_ulong),
+                             sizeof(cl_ulong), sizeof(cl_ulong),
+                             sizeof(cl_ulong), sizeof(cl_ulong)};
+
+  // Work groups of 64 work items, which are spread across multiple
+  // rows if the rows are short.
+  const std::size_t group_items = 64;
+  std::size_t row_items = 1;
+  while (row_items < group_items && row_items < row_size)
+    row_items *= 2;
+  std::size_t rows_per_group = group_items / row_items;
+
+  const std::size_t max_groups_per_row = 256;
+  std::size_t groups_per_row =
+      std::min((row_size + row_items - 1) / row_items, max_groups_per_row);
+
+  rt::range<3> group_size{row_items, rows_per_group, 1};
+  rt::range<3> num_groups{groups_per_row,
+                          (layout.num_rows + rows_per_group - 1) /
+                              rows_per_group,
+                          layout.num_slices};
+
+  return submit_ocl_kernel(kernel, _queue, group_size, num_groups, args,
+                           arg_sizes, 8, ocl_ctx->get_usm_provider(), nullptr,
+                           evt_out);
+}
+
+const host_timestamped_event* ocl_queue::get_timing_reference() {
+  std::call_once(_reference_event_init, [this](){
+    // Use a fresh marker instead of the most recent event: The latter may
+    // have completed long ago, which would break the correlation between
+    // its device timestamp and the host timestamp taken after waiting.
+    cl::Event marker;
+    cl_int err = _queue.enqueueMarkerWithWaitList(nullptr, &marker);
+
+    if(err != CL_SUCCESS) {
+      register_error(
+          __hipsycl_here(),
+          error_info{"ocl_queue: enqueueMarkerWithWaitList() failed, "
+                     "execution timestamps will be unavailable",
+                     error_code{"CL", err}});
+      return;
+    }
+    register_submitted_op(marker);
+    _reference_event = host_timestamped_event{_state.get_most_recent_event()};
+    _is_reference_event_valid = true;
+  });
+  return _is_reference_event_valid ? &_reference_event : nullptr;
+}
+
+bool ocl_queue::is_profiling_enabled() const {
+  return _is_profiling_enabled;
+}
+
 result ocl_queue::submit_sscp_kernel_from_code_object(
     const kernel_operation &op, hcf_object_id hcf_object,
     const std::string &kernel_name, const rt::range<3> &num_groups,
@@ -424,8 +664,8 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
   }
 
   kernel_adaptivity_engine adaptivity_engine{
-      hcf_object, kernel_name, kernel_info, num_groups,
-      group_size, args,        arg_sizes,   num_args, local_mem_size};
+      this->get_device(), hcf_object, kernel_name, kernel_info, num_groups,
+      group_size,         args,       arg_sizes,   num_args,    local_mem_size};
 
   ocl_hardware_context *hw_ctx = static_cast<ocl_hardware_context *>(
       _hw_manager->get_device(_device_index));
@@ -469,12 +709,20 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
  
 
   
+  auto get_image_and_kernel_names =
+      [&](std::vector<std::string> &contained_kernels) -> std::string {
+    return adaptivity_engine.select_image_and_kernels(&contained_kernels);
+  };
+
+  kernel_configuration_recorder::get().record(
+      backend_id::ocl, hcf_object, binary_configuration_id, config,
+      get_image_and_kernel_names);
+
   auto jit_compiler = [&](std::string& compiled_image) -> bool {
     const common::hcf_container* hcf = rt::hcf_cache::get().get_hcf(hcf_object);
     
     std::vector<std::string> kernel_names;
-    std::string selected_image_name =
-        adaptivity_engine.select_image_and_kernels(&kernel_names);
+    std::string selected_image_name = get_image_and_kernel_names(kernel_names);
 
     // Construct SPIR-V translator to compile the specified kernels
     std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
@@ -37,7 +37,7 @@ namespace rt {
 omp_allocator::omp_allocator(const device_id &my_device)
     : _my_device{my_device} {}
 
-void *omp_allocator::allocate(size_t min_alignment, size_t size_bytes) {
+void *omp_allocator::raw_allocate(size_t min_alignment, size_t size_bytes) {
 #if !defined(_WIN32)
   // posix requires alignment to be a multiple of sizeof(void*)
   if (min_alignment < sizeof(void*))
@@ -66,12 +66,12 @@ void *omp_allocator::allocate(size_t min_alignment, size_t size_bytes) {
 #endif
 }
 
-void *omp_allocator::allocate_optimized_host(size_t min_alignment,
-                                             size_t bytes) {
-  return this->allocate(min_alignment, bytes);
+void *omp_allocator::raw_allocate_optimized_host(size_t min_alignment,
+                                                 size_t bytes) {
+  return this->raw_allocate(min_alignment, bytes);
 };
 
-void omp_allocator::free(void *mem) {
+void omp_allocator::raw_free(void *mem) {
 #if !defined(_WIN32)
   std::free(mem);
 #else
@@ -79,8 +79,12 @@ void omp_allocator::free(void *mem) {
 #endif
 }
 
-void* omp_allocator::allocate_usm(size_t bytes) {
-  return this->allocate(0, bytes);
+void* omp_allocator::raw_allocate_usm(size_t bytes) {
+  return this->raw_allocate(0, bytes);
+}
+
+device_id omp_allocator::get_device() const {
+  return _my_device;
 }
 
 bool omp_allocator::is_usm_accessible_from(backend_descriptor b) const {
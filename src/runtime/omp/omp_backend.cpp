@@ -29,10 +29,19 @@
 #include "hipSYCL/runtime/executor.hpp"
 #include "hipSYCL/runtime/omp/omp_backend.hpp"
 #include "hipSYCL/runtime/omp/omp_queue.hpp"
+#include "hipSYCL/runtime/omp/omp_thread_pool.hpp"
 #include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/inorder_executor.hpp"
 #include "hipSYCL/runtime/multi_queue_executor.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#endif
+
 #include <memory>
 
 
@@ -55,14 +64,15 @@ namespace rt {
 
 namespace {
 
-std::unique_ptr<inorder_queue> make_omp_queue(device_id dev) {
-  return std::make_unique<omp_queue>(dev.get_backend());
+std::unique_ptr<inorder_queue> make_omp_queue(device_id dev,
+                                              omp_thread_pool *pool) {
+  return std::make_unique<omp_queue>(dev.get_backend(), pool);
 }
 
 std::unique_ptr<multi_queue_executor>
-create_multi_queue_executor(omp_backend *b) {
-  return std::make_unique<multi_queue_executor>(*b, [](device_id dev) {
-    return make_omp_queue(dev);
+create_multi_queue_executor(omp_backend *b, omp_thread_pool *pool) {
+  return std::make_unique<multi_queue_executor>(*b, [pool](device_id dev) {
+    return make_omp_queue(dev, pool);
   });
 }
 
@@ -72,10 +82,15 @@ omp_backend::omp_backend()
     : _allocator{device_id{
           backend_descriptor{omp_backend::get_hardware_platform(), omp_backend::get_api_platform()}, 0}},
       _hw{},
+      _thread_pool{application::get_settings().get<setting::omp_thread_pool>()
+                       ? std::make_unique<omp_thread_pool>()
+                       : nullptr},
       _executor([this](){
-        return create_multi_queue_executor(this);
+        return create_multi_queue_executor(this, _thread_pool.get());
       }) {}
 
+omp_backend::~omp_backend() {}
+
 api_platform omp_backend::get_api_platform() const {
   return api_platform::omp;
 }
@@ -119,7 +134,22 @@ std::string omp_backend::get_name() const {
 
 std::unique_ptr<backend_executor>
 omp_backend::create_inorder_executor(device_id dev, int priority){
-  return nullptr;
+  // A dedicated in-order queue allows for instant submission,
+  // bypassing the DAG. Priorities are not supported by the host backend.
+  return std::make_unique<inorder_executor>(
+      make_omp_queue(dev, _thread_pool.get()));
+}
+
+result omp_backend::jit_compile_recorded_configuration(
+    const common::hcf_container *hcf,
+    const recorded_kernel_configuration &entry,
+    std::string &binary_out) const {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  return glue::jit::compile_recorded_configuration(
+      compiler::createLLVMToHostTranslator, hcf, entry, binary_out);
+#else
+  return backend::jit_compile_recorded_configuration(hcf, entry, binary_out);
+#endif
 }
 
 }
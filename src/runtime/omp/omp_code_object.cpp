@@ -39,6 +39,7 @@
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/HostJITLinker.hpp"
 #include "hipSYCL/glue/kernel_configuration.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/dylib_loader.hpp"
@@ -49,7 +50,10 @@ namespace rt {
 
 namespace {
 
-result make_shared_library_from_blob(void *&module, const std::string &blob,
+// Needs to match HostGroupRangeKernelSuffix of the HostKernelWrapperPass
+constexpr const char *group_range_kernel_suffix = "_group_range";
+
+result make_shared_library_from_blob(void *&module, std::string_view blob,
                                      const std::string &cache_file) {
   // Write binary image to temporary file
   if (!common::filesystem::atomic_write(cache_file, blob)) {
@@ -77,7 +81,7 @@ result make_shared_library_from_blob(void *&module, const std::string &blob,
 } // namespace
 
 omp_sscp_executable_object::omp_sscp_executable_object(
-    const std::string &binary, hcf_object_id hcf_source,
+    std::string_view binary, hcf_object_id hcf_source,
     const std::vector<std::string> &kernel_names,
     const glue::kernel_configuration &config)
     : _hcf{hcf_source}, _id{config.generate_id()}, _module{nullptr},
@@ -86,6 +90,10 @@ omp_sscp_executable_object::omp_sscp_executable_object(
 }
 
 omp_sscp_executable_object::~omp_sscp_executable_object() {
+  if (_jit_module) {
+    // Nothing to do, JIT-linked memory is released by the linker
+    return;
+  }
   if (_module)
     detail::close_library(_module, "omp_sscp_executable");
   if(!common::filesystem::remove(_kernel_cache_path)) {
@@ -132,28 +140,51 @@ omp_sscp_executable_object::supported_backend_kernel_names() const {
 void *omp_sscp_executable_object::get_module() const { return _module; }
 
 result omp_sscp_executable_object::build(
-    const std::string &source, const std::vector<std::string> &kernel_names) {
+    std::string_view source, const std::vector<std::string> &kernel_names) {
   if (_module != nullptr)
     return make_success();
 
-  if (auto result = make_shared_library_from_blob(_module, source, _kernel_cache_path);
-      !result.is_success())
+  if (compiler::HostJITLinker::isRelocatableObject(source)) {
+    HIPSYCL_DEBUG_INFO << "omp_sscp_executable_object: Linking object file "
+                          "in-process"
+                       << std::endl;
+    std::string error;
+    _jit_module = compiler::HostJITLinker::create(source, error);
+    if (!_jit_module)
+      return make_error(__hipsycl_here(),
+                        error_info{"omp_sscp_executable_object: " + error});
+    _module = _jit_module.get();
+  } else if (auto result = make_shared_library_from_blob(_module, source,
+                                                         _kernel_cache_path);
+             !result.is_success()) {
     return result;
+  }
 
   // find all kernel symbols
   for (const auto &kernel_name : kernel_names) {
-    if (auto kernel = (omp_sscp_kernel *)detail::get_symbol_from_library(
-            _module, kernel_name, "omp_sscp_exectuable_object")) {
+    if (auto kernel = (omp_sscp_kernel *)get_symbol(kernel_name)) {
       _kernels.emplace(kernel_name, kernel);
     } else {
       return make_error(__hipsycl_here(),
                         error_info{"omp_sscp_executable_object: could not load "
                                    "kernel from shared library"});
     }
+    // Binaries generated by older versions might not contain this entry point
+    if (auto kernel = (omp_sscp_group_range_kernel *)get_symbol(
+            kernel_name + group_range_kernel_suffix))
+      _group_range_kernels.emplace(kernel_name, kernel);
   }
   return make_success();
 }
 
+void *
+omp_sscp_executable_object::get_symbol(const std::string &name) const {
+  if (_jit_module)
+    return _jit_module->getSymbol(name);
+  return detail::get_symbol_from_library(_module, name,
+                                         "omp_sscp_exectuable_object");
+}
+
 bool omp_sscp_executable_object::contains(
     const std::string &backend_kernel_name) const {
   for (const auto &[kernel_name, kernel] : _kernels) {
@@ -170,5 +201,14 @@ omp_sscp_executable_object::omp_sscp_kernel *omp_sscp_executable_object::get_ker
   return nullptr;
 }
 
+omp_sscp_executable_object::omp_sscp_group_range_kernel *
+omp_sscp_executable_object::get_group_range_kernel(
+    const std::string &backend_kernel_name) const {
+  auto it = _group_range_kernels.find(backend_kernel_name);
+  if (it != _group_range_kernels.end())
+    return it->second;
+  return nullptr;
+}
+
 } // namespace rt
 } // namespace hipsycl
@@ -30,12 +30,48 @@
 #include <limits>
 
 #include "hipSYCL/runtime/omp/omp_hardware_manager.hpp"
+#include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+std::size_t get_native_sub_group_size() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx512f"))
+    return 16;
+  if(__builtin_cpu_supports("avx"))
+    return 8;
+#endif
+  // SSE, NEON and other 128-bit SIMD extensions
+  return 4;
+}
+
+}
+
+std::size_t get_omp_sscp_sub_group_size() {
+  static const std::size_t sub_group_size = [](){
+    std::size_t requested =
+        application::get_settings().get<setting::omp_sscp_sub_group_size>();
+    if(requested == 0)
+      return get_native_sub_group_size();
+    if((requested & (requested - 1)) != 0) {
+      HIPSYCL_DEBUG_WARNING
+          << "omp_hardware_manager: Requested SSCP sub-group size "
+          << requested << " is not a power of two, using 1 instead"
+          << std::endl;
+      return std::size_t{1};
+    }
+    return requested;
+  }();
+  return sub_group_size;
+}
 
 bool omp_hardware_context::is_cpu() const {
   return true;
@@ -289,6 +325,11 @@ std::vector<std::size_t> omp_hardware_context::get_property(device_uint_list_pro
 {
   switch(prop) {
   case device_uint_list_property::sub_group_sizes:
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+    // Only SSCP kernels can use sub-groups larger than one work item
+    if(std::size_t sscp_size = get_omp_sscp_sub_group_size(); sscp_size > 1)
+      return std::vector<std::size_t>{1, sscp_size};
+#endif
     return std::vector<std::size_t>{1};
     break;
   }
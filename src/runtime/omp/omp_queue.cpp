@@ -38,6 +38,8 @@
 #include "hipSYCL/runtime/instrumentation.hpp"
 #include "hipSYCL/runtime/kernel_launcher.hpp"
 #include "hipSYCL/runtime/omp/omp_event.hpp"
+#include "hipSYCL/runtime/omp/omp_hardware_manager.hpp"
+#include "hipSYCL/runtime/omp/omp_thread_pool.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/queue_completion_event.hpp"
 #include "hipSYCL/runtime/signal_channel.hpp"
@@ -47,6 +49,7 @@
 #include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
 #include "hipSYCL/glue/kernel_configuration.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
 #include "hipSYCL/runtime/adaptivity_engine.hpp"
 #include "hipSYCL/runtime/omp/omp_code_object.hpp"
 
@@ -204,9 +207,11 @@ std::size_t get_page_size() {
 
 result
 launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
+                      omp_sscp_executable_object::omp_sscp_group_range_kernel
+                          *group_range_kernel,
                       const rt::range<3> &num_groups,
                       const rt::range<3> &local_size, unsigned shared_memory,
-                      void **kernel_args) {
+                      void **kernel_args, omp_thread_pool *pool) {
   if (num_groups.size() == 1 && shared_memory == 0) {
     omp_sscp_executable_object::work_group_info info{
         num_groups, rt::id<3>{0, 0, 0}, local_size, nullptr};
@@ -214,6 +219,34 @@ launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
     return make_success();
   }
 
+  // Executes the groups with linear ids in [begin, end). If available, the
+  // group range entry point is used, which loops over the groups inside the
+  // JIT-compiled code instead of invoking the kernel once per group.
+  auto run_groups = [&](std::size_t begin, std::size_t end,
+                        void *local_memory) {
+    if (group_range_kernel) {
+      omp_sscp_executable_object::work_group_info info{
+          num_groups, rt::id<3>{0, 0, 0}, local_size, local_memory};
+      group_range_kernel(&info, kernel_args, begin, end);
+      return;
+    }
+
+    const std::size_t groups_x = num_groups.get(0);
+    const std::size_t groups_xy = groups_x * num_groups.get(1);
+    for (std::size_t group = begin; group < end; ++group) {
+      rt::id<3> group_id{group % groups_x, (group % groups_xy) / groups_x,
+                         group / groups_xy};
+      omp_sscp_executable_object::work_group_info info{
+          num_groups, group_id, local_size, local_memory};
+      kernel(&info, kernel_args);
+    }
+  };
+
+  if (pool) {
+    pool->parallel_for(num_groups.size(), shared_memory, run_groups);
+    return make_success();
+  }
+
 #ifndef _OPENMP
   HIPSYCL_DEBUG_WARNING << "omp_queue: SSCP kernel launching was built without OpenMP "
                           "support, the kernel will execute sequentially!"
@@ -231,27 +264,92 @@ launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
     local_memory.resize(shared_memory + page_size);
     auto aligned_local_memory = reinterpret_cast<void*>(next_multiple_of(reinterpret_cast<std::uint64_t>(local_memory.data()), page_size));
 
+    if (group_range_kernel) {
+      // Same static distribution of groups as the omp for below, but
+      // with one kernel invocation per thread.
+#ifdef _OPENMP
+      const std::size_t thread_id = omp_get_thread_num();
+      const std::size_t num_threads = omp_get_num_threads();
+#else
+      const std::size_t thread_id = 0;
+      const std::size_t num_threads = 1;
+#endif
+      const std::size_t total_groups = num_groups.size();
+      run_groups(total_groups * thread_id / num_threads,
+                 total_groups * (thread_id + 1) / num_threads,
+                 aligned_local_memory);
+    } else {
 #ifdef _OPENMP
 #pragma omp for collapse(3)
 #endif
-    for (std::size_t k = 0; k < num_groups.get(2); ++k) {
-      for (std::size_t j = 0; j < num_groups.get(1); ++j) {
-        for (std::size_t i = 0; i < num_groups.get(0); ++i) {
-          omp_sscp_executable_object::work_group_info info{
-              num_groups, rt::id<3>{i, j, k}, local_size, aligned_local_memory};
-          kernel(&info, kernel_args);
+      for (std::size_t k = 0; k < num_groups.get(2); ++k) {
+        for (std::size_t j = 0; j < num_groups.get(1); ++j) {
+          for (std::size_t i = 0; i < num_groups.get(0); ++i) {
+            omp_sscp_executable_object::work_group_info info{
+                num_groups, rt::id<3>{i, j, k}, local_size, aligned_local_memory};
+            kernel(&info, kernel_args);
+          }
         }
       }
     }
   }
   return make_success();
 }
+
+// Everything needed to launch a kernel again without consulting
+// the hcf_cache and kernel_cache.
+class omp_sscp_launch_entry : public sscp_launch_site::entry {
+public:
+  omp_sscp_launch_entry(
+      const device_id &dev, const sscp_launch_site::fingerprint_type &fingerprint,
+      std::size_t kernel_cache_epoch, const hcf_kernel_info &kernel_info,
+      omp_sscp_executable_object::omp_sscp_kernel *kernel,
+      omp_sscp_executable_object::omp_sscp_group_range_kernel *group_range_kernel)
+      : sscp_launch_site::entry{dev, fingerprint, kernel_cache_epoch},
+        _kernel{kernel},
+        _group_range_kernel{group_range_kernel} {
+    for (std::size_t i = 0; i < kernel_info.get_num_parameters(); ++i)
+      _argument_mapping.push_back(
+          std::make_pair(kernel_info.get_original_argument_index(i),
+                         kernel_info.get_argument_offset(i)));
+  }
+
+  omp_sscp_executable_object::omp_sscp_kernel *get_kernel() const {
+    return _kernel;
+  }
+
+  omp_sscp_executable_object::omp_sscp_group_range_kernel *
+  get_group_range_kernel() const {
+    return _group_range_kernel;
+  }
+
+  // Same as glue::jit::cxx_argument_mapper, using the precomputed mapping.
+  // Returns false if the mapping is not possible.
+  bool map_arguments(void **args, std::size_t num_args,
+                     std::vector<void *> &mapped_args) const {
+    mapped_args.resize(_argument_mapping.size());
+    for (std::size_t i = 0; i < _argument_mapping.size(); ++i) {
+      std::size_t arg_index = _argument_mapping[i].first;
+      if (arg_index >= num_args)
+        return false;
+      mapped_args[i] =
+          static_cast<char *>(args[arg_index]) + _argument_mapping[i].second;
+    }
+    return true;
+  }
+
+private:
+  omp_sscp_executable_object::omp_sscp_kernel *_kernel;
+  omp_sscp_executable_object::omp_sscp_group_range_kernel *_group_range_kernel;
+  // Original argument index and byte offset for each kernel parameter
+  std::vector<std::pair<std::size_t, std::size_t>> _argument_mapping;
+};
 #endif
 } // namespace
 
-omp_queue::omp_queue(backend_id id)
+omp_queue::omp_queue(backend_id id, omp_thread_pool *pool)
     : _backend_id(id), _sscp_code_object_invoker{this},
-      _kernel_cache{kernel_cache::get()} {}
+      _kernel_cache{kernel_cache::get()}, _thread_pool{pool} {}
 
 omp_queue::~omp_queue() { _worker.halt(); }
 
@@ -387,16 +485,18 @@ result omp_queue::submit_kernel(kernel_operation &op, dag_node_ptr node) {
   cap.provide_sscp_invoker(&_sscp_code_object_invoker);
   launcher->set_backend_capabilities(cap);
 
-  rt::dag_node *node_ptr = node.get();
   const glue::kernel_configuration *config =
       &(op.get_launcher().get_kernel_configuration());
 
   omp_instrumentation_setup instrumentation_setup{op, node};
+  // The launcher and configuration are owned by the node's operation.
+  // Capturing the node keeps them alive until the kernel has run, even
+  // for instantly submitted nodes that are not tracked by the DAG manager.
   _worker([=]() {
     auto instrumentation_guard = instrumentation_setup.instrument_task();
 
     HIPSYCL_DEBUG_INFO << "omp_queue [async]: Invoking kernel!" << std::endl;
-    launcher->invoke(node_ptr, *config);
+    launcher->invoke(node.get(), *config);
   });
 
   return make_success();
@@ -407,11 +507,13 @@ result omp_queue::submit_sscp_kernel_from_code_object(
     const std::string &kernel_name, const rt::range<3> &num_groups,
     const rt::range<3> &group_size, unsigned local_mem_size, void **args,
     std::size_t *arg_sizes, std::size_t num_args,
-    const glue::kernel_configuration &initial_config) {
+    const glue::kernel_configuration &initial_config,
+    sscp_launch_site *launch_site) {
 #ifdef HIPSYCL_WITH_SSCP_COMPILER
 
   const hcf_kernel_info *kernel_info =
-      rt::hcf_cache::get().get_kernel_info(hcf_object, kernel_name);
+      launch_site ? launch_site->get_kernel_info()
+                  : rt::hcf_cache::get().get_kernel_info(hcf_object, kernel_name);
   if (!kernel_info) {
     return make_error(
         __hipsycl_here(),
@@ -420,8 +522,29 @@ result omp_queue::submit_sscp_kernel_from_code_object(
   }
 
   kernel_adaptivity_engine adaptivity_engine{
-      hcf_object, kernel_name, kernel_info, num_groups,
-      group_size, args,        arg_sizes,   num_args, local_mem_size};
+      this->get_device(), hcf_object, kernel_name, kernel_info, num_groups,
+      group_size,         args,       arg_sizes,   num_args,    local_mem_size};
+
+  // Fast path: If this configuration has been launched from the launch site
+  // before, the kernel can be invoked directly.
+  sscp_launch_site::fingerprint_type launch_fingerprint;
+  bool is_cacheable_launch =
+      launch_site && adaptivity_engine.get_launch_fingerprint(
+                         initial_config.generate_id(), launch_fingerprint);
+  // Read before the code object is obtained, such that an unload in between
+  // invalidates the entry published below.
+  const std::size_t kernel_cache_epoch = _kernel_cache->get_epoch();
+  if (is_cacheable_launch) {
+    if (const auto *entry = launch_site->find<omp_sscp_launch_entry>(
+            get_device(), launch_fingerprint, kernel_cache_epoch)) {
+      static thread_local std::vector<void *> mapped_args;
+      if (entry->map_arguments(args, num_args, mapped_args))
+        return launch_kernel_from_so(entry->get_kernel(),
+                                     entry->get_group_range_kernel(), num_groups,
+                                     group_size, local_mem_size,
+                                     mapped_args.data(), _thread_pool);
+    }
+  }
 
   static thread_local glue::kernel_configuration config;
   config = initial_config;
@@ -434,6 +557,15 @@ result omp_queue::submit_sscp_kernel_from_code_object(
   config.append_base_configuration(
       glue::kernel_base_config_parameter::hcf_object_id, hcf_object);
 
+  if (application::get_settings().get<setting::omp_out_of_process_codegen>())
+    config.set_build_flag(
+        glue::kernel_build_flag::host_out_of_process_codegen);
+
+  if (std::size_t sub_group_size = get_omp_sscp_sub_group_size();
+      sub_group_size != 1)
+    config.set_build_option(glue::kernel_build_option::host_sub_group_size,
+                            sub_group_size);
+
   auto binary_configuration_id =
       adaptivity_engine.finalize_binary_configuration(config);
   auto code_object_configuration_id = binary_configuration_id;
@@ -443,6 +575,10 @@ result omp_queue::submit_sscp_kernel_from_code_object(
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
+  kernel_configuration_recorder::get().record(
+      backend_id::omp, hcf_object, binary_configuration_id, config,
+      get_image_and_kernel_names);
+
   auto jit_compiler = [&](std::string &compiled_image) -> bool {
     const common::hcf_container *hcf = rt::hcf_cache::get().get_hcf(hcf_object);
 
@@ -465,7 +601,7 @@ result omp_queue::submit_sscp_kernel_from_code_object(
   };
 
   auto code_object_constructor =
-      [&](const std::string &binary_image) -> code_object * {
+      [&](std::string_view binary_image) -> code_object * {
     std::vector<std::string> kernel_names;
     get_image_and_kernel_names(kernel_names);
 
@@ -495,9 +631,9 @@ result omp_queue::submit_sscp_kernel_from_code_object(
                       error_info{"omp_queue: Code object construction failed"});
   }
 
-  auto kernel =
-      static_cast<const omp_sscp_executable_object *>(obj)->get_kernel(
-          kernel_name);
+  auto exec_obj = static_cast<const omp_sscp_executable_object *>(obj);
+  auto kernel = exec_obj->get_kernel(kernel_name);
+  auto group_range_kernel = exec_obj->get_group_range_kernel(kernel_name);
 
   glue::jit::cxx_argument_mapper arg_mapper{*kernel_info, args, arg_sizes,
                                             num_args};
@@ -508,8 +644,16 @@ result omp_queue::submit_sscp_kernel_from_code_object(
             "omp_queue: Could not map C++ arguments to kernel arguments"});
   }
 
-  return launch_kernel_from_so(kernel, num_groups, group_size, local_mem_size,
-                               arg_mapper.get_mapped_args());
+  if (is_cacheable_launch && kernel)
+    launch_site->publish(get_device(), launch_fingerprint,
+                         std::make_unique<omp_sscp_launch_entry>(
+                             get_device(), launch_fingerprint,
+                             kernel_cache_epoch, *kernel_info, kernel,
+                             group_range_kernel));
+
+  return launch_kernel_from_so(kernel, group_range_kernel, num_groups,
+                               group_size, local_mem_size,
+                               arg_mapper.get_mapped_args(), _thread_pool);
 
 #else
   return make_error(
@@ -622,6 +766,17 @@ result omp_sscp_code_object_invoker::submit_kernel(
       local_mem_size, args, arg_sizes, num_args, config);
 }
 
+result omp_sscp_code_object_invoker::submit_kernel_from_launch_site(
+    const kernel_operation &op, sscp_launch_site &site,
+    const rt::range<3> &num_groups, const rt::range<3> &group_size,
+    unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+    std::size_t num_args, const glue::kernel_configuration &config) {
+
+  return _queue->submit_sscp_kernel_from_code_object(
+      op, site.get_hcf_object(), site.get_kernel_name(), num_groups,
+      group_size, local_mem_size, args, arg_sizes, num_args, config, &site);
+}
+
 rt::range<3> omp_sscp_code_object_invoker::select_group_size(
     const rt::range<3> &global_range, const rt::range<3> &group_size) const {
   rt::range<3> selected_group_size = group_size;
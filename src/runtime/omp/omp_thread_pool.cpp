@@ -0,0 +1,295 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "hipSYCL/runtime/omp/omp_thread_pool.hpp"
+#include "hipSYCL/runtime/util.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef WIN32
+#include <unistd.h>
+#else
+#include <Windows.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// Size of the local memory arena that is allocated for each thread
+// when the pool is created. Kernels requiring more local memory grow
+// the arenas on demand.
+constexpr std::size_t initial_local_memory_size = 64 * 1024;
+
+// Targeted number of chunks per thread. More chunks improve load balancing
+// for irregular kernels, fewer chunks reduce scheduling overhead.
+constexpr std::size_t chunks_per_thread = 16;
+
+// Number of times an idle thread checks for a new job before going to
+// sleep. This avoids the cost of parking and waking up threads when
+// kernels are launched in quick succession.
+int get_spin_iterations(int iterations) {
+  static const bool can_spin = std::thread::hardware_concurrency() > 1;
+  return can_spin ? iterations : 0;
+}
+
+const int idle_spin_iterations = get_spin_iterations(1 << 14);
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+std::size_t get_page_size() {
+#ifndef WIN32
+  return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+  SYSTEM_INFO si;
+  GetSystemInfo(&si);
+  return si.dwPageSize;
+#endif
+}
+
+std::size_t get_default_num_threads() {
+#ifdef _OPENMP
+  return static_cast<std::size_t>(omp_get_max_threads());
+#else
+  return std::max(1u, std::thread::hardware_concurrency());
+#endif
+}
+
+inline std::uint64_t pack_chunks(std::uint32_t begin, std::uint32_t end) {
+  return (static_cast<std::uint64_t>(begin) << 32) | end;
+}
+
+inline std::uint32_t chunks_begin(std::uint64_t chunks) {
+  return static_cast<std::uint32_t>(chunks >> 32);
+}
+
+inline std::uint32_t chunks_end(std::uint64_t chunks) {
+  return static_cast<std::uint32_t>(chunks);
+}
+
+}
+
+omp_thread_pool::omp_thread_pool(std::size_t num_threads)
+    : _page_size{get_page_size()}, _job{}, _generation{0},
+      _num_busy_threads{0}, _shutdown{false} {
+  if(num_threads == 0)
+    num_threads = get_default_num_threads();
+
+  for(std::size_t i = 0; i < num_threads; ++i) {
+    _workers.emplace_back(std::make_unique<worker>());
+    reserve_local_memory(*_workers.back(), initial_local_memory_size);
+  }
+  // Threads are only started once the first job arrives, such that
+  // the pool does not cost anything if it remains unused.
+}
+
+omp_thread_pool::~omp_thread_pool() {
+  {
+    std::lock_guard<std::mutex> lock{_wakeup_mutex};
+    _shutdown.store(true);
+  }
+  _wakeup.notify_all();
+  for(auto& t : _threads)
+    t.join();
+}
+
+void omp_thread_pool::parallel_for(std::size_t num_items,
+                                   std::size_t local_memory_size,
+                                   const chunk_function &f) {
+  if(num_items == 0)
+    return;
+
+  std::lock_guard<std::mutex> submission_lock{_submission_mutex};
+
+  if(_threads.empty() && _workers.size() > 1)
+    start_threads();
+
+  // All threads are idle at this point, so it is safe to
+  // touch their arenas.
+  for(auto& w : _workers)
+    reserve_local_memory(*w, local_memory_size);
+
+  const std::size_t num_workers = _workers.size();
+  std::size_t chunk_size =
+      std::max(std::size_t{1}, num_items / (num_workers * chunks_per_thread));
+  // Chunk indices must fit into 32 bits
+  const std::size_t max_chunks = std::numeric_limits<std::uint32_t>::max();
+  chunk_size = std::max<std::size_t>(chunk_size,
+                                      ceil_division(num_items, max_chunks));
+
+  const std::size_t num_chunks = ceil_division(num_items, chunk_size);
+
+  for(std::size_t i = 0; i < num_workers; ++i) {
+    auto begin = static_cast<std::uint32_t>(i * num_chunks / num_workers);
+    auto end = static_cast<std::uint32_t>((i + 1) * num_chunks / num_workers);
+    _workers[i]->chunks.store(pack_chunks(begin, end),
+                              std::memory_order_relaxed);
+  }
+
+  _job = job{num_items, chunk_size, &f};
+
+  if(num_workers > 1) {
+    _num_busy_threads.store(num_workers - 1, std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> lock{_wakeup_mutex};
+      _generation.fetch_add(1, std::memory_order_release);
+    }
+    _wakeup.notify_all();
+  }
+
+  run_job(0);
+
+  while(_num_busy_threads.load(std::memory_order_acquire) != 0)
+    cpu_relax();
+}
+
+void omp_thread_pool::start_threads() {
+  for(std::size_t i = 1; i < _workers.size(); ++i)
+    _threads.emplace_back([this, i]() { thread_main(i); });
+}
+
+void omp_thread_pool::thread_main(std::size_t worker_id) {
+  std::uint64_t seen_generation = 0;
+
+  for(;;) {
+    std::uint64_t generation = _generation.load(std::memory_order_acquire);
+
+    for(int i = 0;
+        i < idle_spin_iterations && generation == seen_generation &&
+        !_shutdown.load(std::memory_order_relaxed);
+        ++i) {
+      cpu_relax();
+      generation = _generation.load(std::memory_order_acquire);
+    }
+
+    if(generation == seen_generation) {
+      std::unique_lock<std::mutex> lock{_wakeup_mutex};
+      _wakeup.wait(lock, [&]() {
+        return _shutdown.load() ||
+               _generation.load(std::memory_order_acquire) != seen_generation;
+      });
+      if(_shutdown.load())
+        return;
+      generation = _generation.load(std::memory_order_acquire);
+    }
+
+    seen_generation = generation;
+    run_job(worker_id);
+    _num_busy_threads.fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
+void omp_thread_pool::run_job(std::size_t worker_id) {
+  worker& w = *_workers[worker_id];
+  const job& j = _job;
+
+  for(;;) {
+    std::uint32_t chunk;
+    while(pop_chunk(w, chunk)) {
+      std::size_t begin = chunk * j.chunk_size;
+      std::size_t end = std::min(begin + j.chunk_size, j.num_items);
+      (*j.f)(begin, end, w.aligned_local_memory);
+    }
+    // Chunks are never added to a job once it has started, so if there
+    // is nothing left to steal, all remaining chunks are already being
+    // processed by other threads.
+    if(!steal_chunks(worker_id))
+      return;
+  }
+}
+
+bool omp_thread_pool::pop_chunk(worker &w, std::uint32_t &chunk) {
+  std::uint64_t chunks = w.chunks.load(std::memory_order_acquire);
+  for(;;) {
+    std::uint32_t begin = chunks_begin(chunks);
+    std::uint32_t end = chunks_end(chunks);
+    if(begin >= end)
+      return false;
+    if(w.chunks.compare_exchange_weak(chunks, pack_chunks(begin + 1, end),
+                                      std::memory_order_acq_rel)) {
+      chunk = begin;
+      return true;
+    }
+  }
+}
+
+bool omp_thread_pool::steal_chunks(std::size_t thief_id) {
+  const std::size_t num_workers = _workers.size();
+
+  for(std::size_t i = 1; i < num_workers; ++i) {
+    worker& victim = *_workers[(thief_id + i) % num_workers];
+
+    std::uint64_t chunks = victim.chunks.load(std::memory_order_acquire);
+    for(;;) {
+      std::uint32_t begin = chunks_begin(chunks);
+      std::uint32_t end = chunks_end(chunks);
+      if(begin >= end)
+        break;
+
+      std::uint32_t num_stolen = (end - begin + 1) / 2;
+      std::uint32_t split = end - num_stolen;
+      if(victim.chunks.compare_exchange_weak(chunks, pack_chunks(begin, split),
+                                             std::memory_order_acq_rel)) {
+        // Our own range is empty at this point, and other threads only
+        // ever shrink it, so we can simply overwrite it.
+        _workers[thief_id]->chunks.store(pack_chunks(split, end),
+                                         std::memory_order_release);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void omp_thread_pool::reserve_local_memory(worker &w, std::size_t size) {
+  if(w.local_memory_capacity >= size && w.aligned_local_memory)
+    return;
+
+  w.local_memory.resize(size + _page_size);
+  w.aligned_local_memory = reinterpret_cast<void *>(next_multiple_of(
+      reinterpret_cast<std::uint64_t>(w.local_memory.data()), _page_size));
+  w.local_memory_capacity = size;
+}
+
+}
+}
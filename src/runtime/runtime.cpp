@@ -27,6 +27,7 @@
 
 #include "hipSYCL/runtime/runtime.hpp"
 #include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/runtime/application.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -36,6 +37,12 @@ runtime::runtime()
 {
   HIPSYCL_DEBUG_INFO << "runtime: ******* rt launch initiated ********"
                       << std::endl;
+
+  std::string replay_log =
+      application::get_settings().get<setting::replay_kernel_configurations>();
+  if(!replay_log.empty())
+    _replayer =
+        std::make_unique<kernel_configuration_replayer>(_backends, replay_log);
 }
 
 runtime::~runtime()
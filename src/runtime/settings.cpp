@@ -42,6 +42,8 @@ std::istream &operator>>(std::istream &istr, scheduler_type &out) {
     out = scheduler_type::direct;
   else if (str == "unbound")
     out = scheduler_type::unbound;
+  else if (str == "load_aware")
+    out = scheduler_type::load_aware;
   else
     istr.setstate(std::ios_base::failbit);
   return istr;
@@ -215,5 +217,17 @@ std::istream &operator>>(std::istream &istr, default_selector_behavior& out) {
   return istr;
 }
 
+std::istream &operator>>(std::istream &istr, jit_cache_compression& out) {
+  std::string str;
+  istr >> str;
+  if (str == "none")
+    out = jit_cache_compression::none;
+  else if (str == "zlib")
+    out = jit_cache_compression::zlib;
+  else
+    istr.setstate(std::ios_base::failbit);
+  return istr;
+}
+
 }
 }
@@ -0,0 +1,82 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hipSYCL/runtime/sscp_launch_site.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+sscp_launch_site::sscp_launch_site(hcf_object_id hcf_object,
+                                   const std::string &kernel_name)
+    : _hcf_object{hcf_object}, _kernel_name{kernel_name},
+      _kernel_info{nullptr} {
+  for (auto &slot : _slots)
+    slot.store(nullptr, std::memory_order_relaxed);
+}
+
+const hcf_kernel_info *sscp_launch_site::get_kernel_info() {
+  const hcf_kernel_info *info = _kernel_info.load(std::memory_order_acquire);
+  if (info)
+    return info;
+
+  // hcf_cache retains kernel info objects even if the HCF object
+  // is unregistered, so the pointer can be kept.
+  info = hcf_cache::get().get_kernel_info(_hcf_object, _kernel_name);
+  if (info)
+    _kernel_info.store(info, std::memory_order_release);
+  return info;
+}
+
+void sscp_launch_site::publish(const device_id &dev,
+                               const fingerprint_type &fingerprint,
+                               std::unique_ptr<entry> e) {
+  if (!e)
+    return;
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  for (auto &slot : _slots) {
+    const entry *existing = slot.load(std::memory_order_relaxed);
+    if (!existing) {
+      _entries.push_back(std::move(e));
+      slot.store(_entries.back().get(), std::memory_order_release);
+      return;
+    }
+    if (existing->matches(dev, fingerprint)) {
+      // Stale entry from before the kernel_cache was unloaded
+      if (!existing->is_valid(e->get_kernel_cache_epoch())) {
+        _entries.push_back(std::move(e));
+        slot.store(_entries.back().get(), std::memory_order_release);
+      }
+      // Otherwise, another thread has already published this configuration
+      return;
+    }
+  }
+}
+
+}
+}
@@ -35,12 +35,13 @@ namespace hipsycl {
 namespace rt {
 
 ze_allocator::ze_allocator(const ze_hardware_context *device,
-                           const ze_hardware_manager *hw_manager)
+                           const ze_hardware_manager *hw_manager,
+                           device_id dev_id)
     : _ctx{device->get_ze_context()}, _dev{device->get_ze_device()},
       _global_mem_ordinal{device->get_ze_global_memory_ordinal()},
-      _hw_manager{hw_manager} {}
+      _hw_manager{hw_manager}, _dev_id{dev_id} {}
 
-void* ze_allocator::allocate(size_t min_alignment, size_t size_bytes) {
+void* ze_allocator::raw_allocate(size_t min_alignment, size_t size_bytes) {
   
   void* out = nullptr;
 
@@ -64,8 +65,8 @@ void* ze_allocator::allocate(size_t min_alignment, size_t size_bytes) {
   return out;
 }
 
-void* ze_allocator::allocate_optimized_host(size_t min_alignment,
-                                            size_t bytes) {
+void* ze_allocator::raw_allocate_optimized_host(size_t min_alignment,
+                                                size_t bytes) {
   void* out = nullptr;
   ze_host_mem_alloc_desc_t desc;
   
@@ -86,7 +87,7 @@ void* ze_allocator::allocate_optimized_host(size_t min_alignment,
   return out;
 }
   
-void ze_allocator::free(void *mem) {
+void ze_allocator::raw_free(void *mem) {
   ze_result_t err = zeMemFree(_ctx, mem);
 
   if(err != ZE_RESULT_SUCCESS) {
@@ -96,7 +97,7 @@ void ze_allocator::free(void *mem) {
   }
 }
 
-void* ze_allocator::allocate_usm(size_t bytes) {
+void* ze_allocator::raw_allocate_usm(size_t bytes) {
 
   void* out = nullptr;
 
@@ -127,6 +128,10 @@ void* ze_allocator::allocate_usm(size_t bytes) {
   return out;
 }
 
+device_id ze_allocator::get_device() const {
+  return _dev_id;
+}
+
 bool ze_allocator::is_usm_accessible_from(backend_descriptor b) const {
   return b.hw_platform == hardware_platform::cpu ||
          b.hw_platform == hardware_platform::level_zero;
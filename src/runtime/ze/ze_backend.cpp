@@ -35,6 +35,13 @@
 #include "hipSYCL/runtime/ze/ze_queue.hpp"
 #include "hipSYCL/runtime/backend_loader.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+#include "hipSYCL/compiler/llvm-to-backend/spirv/LLVMToSpirvFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#endif
 
 HIPSYCL_PLUGIN_API_EXPORT
 hipsycl::rt::backend *hipsycl_backend_plugin_create() {
@@ -77,7 +84,7 @@ ze_backend::ze_backend() {
   for(std::size_t i = 0; i < _hardware_manager->get_num_devices(); ++i) {
     _allocators.push_back(ze_allocator{
         static_cast<ze_hardware_context *>(_hardware_manager->get_device(i)),
-        _hardware_manager.get()});
+        _hardware_manager.get(), _hardware_manager->get_device_id(i)});
   }
 
   _executor =
@@ -125,5 +132,17 @@ ze_backend::create_inorder_executor(device_id dev, int priority){
   return std::make_unique<inorder_executor>(std::move(q));
 }
 
+result ze_backend::jit_compile_recorded_configuration(
+    const common::hcf_container *hcf,
+    const recorded_kernel_configuration &entry,
+    std::string &binary_out) const {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  return glue::jit::compile_recorded_configuration(
+      compiler::createLLVMToSpirvTranslator, hcf, entry, binary_out);
+#else
+  return backend::jit_compile_recorded_configuration(hcf, entry, binary_out);
+#endif
+}
+
 }
 }
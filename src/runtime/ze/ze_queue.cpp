@@ -28,6 +28,7 @@
 #include <cassert>
 #include <chrono>
 #include <future>
+#include <limits>
 #include <utility>
 #include <level_zero/ze_api.h>
 #include <vector>
@@ -39,6 +40,7 @@
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/event.hpp"
+#include "hipSYCL/runtime/generic/strided_memcpy.hpp"
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/inorder_queue.hpp"
 #include "hipSYCL/runtime/ze/ze_code_object.hpp"
@@ -52,6 +54,7 @@
 
 #include "hipSYCL/compiler/llvm-to-backend/spirv/LLVMToSpirvFactory.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
 
 #endif
 
@@ -260,35 +263,29 @@ result ze_queue::submit_memcpy(memcpy_operation& op, dag_node_ptr node) {
   assert(op.source().get_access_ptr());
   assert(op.dest().get_access_ptr());
 
-  range<3> transfer_range = op.get_num_transferred_elements();
-
-  int dimension = 0;
-  if (transfer_range[0] > 1)
-    dimension = 3;
-  else if (transfer_range[1] > 1)
-    dimension = 2;
-  else
-    dimension = 1;
-
-  // If we transfer the entire buffer, treat it as 1D memcpy for performance.
-  // TODO: The same optimization could also be applied for the general case
-  // when regions are contiguous
-  if (op.get_num_transferred_elements() == op.source().get_allocation_shape() &&
-      op.get_num_transferred_elements() == op.dest().get_allocation_shape() &&
-      op.source().get_access_offset() == id<3>{} &&
-      op.dest().get_access_offset() == id<3>{})
-    dimension = 1;
-
-  assert(dimension >= 1 && dimension <= 3);
+  strided_memcpy_layout layout{op};
 
   std::shared_ptr<dag_node_event> completion_evt = create_event();
+  ze_event_handle_t completion_evt_handle =
+      static_cast<ze_node_event *>(completion_evt.get())->get_event_handle();
   std::vector<ze_event_handle_t> wait_events = get_enqueued_event_handles();
 
-  if(dimension == 1) {
+  // zeCommandListAppendMemoryCopyRegion() describes regions
+  // with 32-bit sizes and pitches.
+  auto fits_region = [](std::size_t x) {
+    return x <= std::numeric_limits<uint32_t>::max();
+  };
+  bool is_region_representable =
+      fits_region(layout.row_size) && fits_region(layout.num_rows) &&
+      fits_region(layout.num_slices) && fits_region(layout.src_row_pitch) &&
+      fits_region(layout.dest_row_pitch) &&
+      fits_region(layout.src_slice_pitch) &&
+      fits_region(layout.dest_slice_pitch);
+
+  if(layout.get_dimension() == 1) {
     ze_result_t err = zeCommandListAppendMemoryCopy(
         _command_list, op.dest().get_access_ptr(), op.source().get_access_ptr(),
-        op.get_num_transferred_bytes(),
-        static_cast<ze_node_event *>(completion_evt.get())->get_event_handle(),
+        op.get_num_transferred_bytes(), completion_evt_handle,
         static_cast<uint32_t>(wait_events.size()), wait_events.data());
 
     if(err != ZE_RESULT_SUCCESS) {
@@ -297,12 +294,62 @@ result ze_queue::submit_memcpy(memcpy_operation& op, dag_node_ptr node) {
           error_info{"ze_queue: zeCommandListAppendMemoryCopy() failed",
                      error_code{"ze", static_cast<int>(err)}});
     }
+  } else if(is_region_representable) {
+    // Regions start at the access pointers, so the origins are zero
+    ze_copy_region_t src_region{0,
+                                0,
+                                0,
+                                static_cast<uint32_t>(layout.row_size),
+                                static_cast<uint32_t>(layout.num_rows),
+                                static_cast<uint32_t>(layout.num_slices)};
+    ze_copy_region_t dest_region = src_region;
+
+    ze_result_t err = zeCommandListAppendMemoryCopyRegion(
+        _command_list, op.dest().get_access_ptr(), &dest_region,
+        static_cast<uint32_t>(layout.dest_row_pitch),
+        static_cast<uint32_t>(layout.dest_slice_pitch),
+        op.source().get_access_ptr(), &src_region,
+        static_cast<uint32_t>(layout.src_row_pitch),
+        static_cast<uint32_t>(layout.src_slice_pitch), completion_evt_handle,
+        static_cast<uint32_t>(wait_events.size()), wait_events.data());
+
+    if(err != ZE_RESULT_SUCCESS) {
+      return make_error(
+          __hipsycl_here(),
+          error_info{"ze_queue: zeCommandListAppendMemoryCopyRegion() failed",
+                     error_code{"ze", static_cast<int>(err)}});
+    }
   } else {
-    return make_error(
-        __hipsycl_here(),
-        error_info{
-            "ze_queue: Multidimensional memory copies are not yet supported.",
-            error_type::unimplemented});
+    // Fall back to one copy per row. The barrier signals completion
+    // once all previously appended row copies have finished.
+    char* dest = static_cast<char*>(op.dest().get_access_ptr());
+    const char* src = static_cast<const char*>(op.source().get_access_ptr());
+
+    for(std::size_t slice = 0; slice < layout.num_slices; ++slice) {
+      for(std::size_t row = 0; row < layout.num_rows; ++row) {
+        ze_result_t err = zeCommandListAppendMemoryCopy(
+            _command_list, dest + layout.get_dest_row_offset(slice, row),
+            src + layout.get_src_row_offset(slice, row), layout.row_size,
+            nullptr, static_cast<uint32_t>(wait_events.size()),
+            wait_events.data());
+
+        if(err != ZE_RESULT_SUCCESS) {
+          return make_error(
+              __hipsycl_here(),
+              error_info{"ze_queue: zeCommandListAppendMemoryCopy() failed",
+                         error_code{"ze", static_cast<int>(err)}});
+        }
+      }
+    }
+
+    ze_result_t err = zeCommandListAppendBarrier(
+        _command_list, completion_evt_handle, 0, nullptr);
+    if(err != ZE_RESULT_SUCCESS) {
+      return make_error(
+          __hipsycl_here(),
+          error_info{"ze_queue: zeCommandListAppendBarrier() failed",
+                     error_code{"ze", static_cast<int>(err)}});
+    }
   }
 
   register_submitted_op(completion_evt);
@@ -572,8 +619,8 @@ result ze_queue::submit_sscp_kernel_from_code_object(
   }
 
   kernel_adaptivity_engine adaptivity_engine{
-      hcf_object, kernel_name, kernel_info, num_groups,
-      group_size, args,        arg_sizes,   num_args, local_mem_size};
+      this->get_device(), hcf_object, kernel_name, kernel_info, num_groups,
+      group_size,         args,       arg_sizes,   num_args,    local_mem_size};
 
 
   // Need to create custom config to ensure we can distinguish other
@@ -610,12 +657,20 @@ result ze_queue::submit_sscp_kernel_from_code_object(
       code_object_configuration_id,
       glue::kernel_base_config_parameter::runtime_context, ctx);
 
+  auto get_image_and_kernel_names =
+      [&](std::vector<std::string> &contained_kernels) -> std::string {
+    return adaptivity_engine.select_image_and_kernels(&contained_kernels);
+  };
+
+  kernel_configuration_recorder::get().record(
+      backend_id::level_zero, hcf_object, binary_configuration_id, config,
+      get_image_and_kernel_names);
+
   auto jit_compiler = [&](std::string& compiled_image) -> bool {
     const common::hcf_container* hcf = rt::hcf_cache::get().get_hcf(hcf_object);
     
     std::vector<std::string> kernel_names;
-    std::string selected_image_name =
-        adaptivity_engine.select_image_and_kernels(&kernel_names);
+    std::string selected_image_name = get_image_and_kernel_names(kernel_names);
 
     // Construct SPIR-V translator to compile the specified kernels
     std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
@@ -0,0 +1,345 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <llvm/Object/Binary.h>
+#include <llvm/Object/ELFObjectFile.h>
+#include <llvm/Object/ObjectFile.h>
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/Error.h>
+
+#include "hipSYCL/common/filesystem.hpp"
+#include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/LLVMToBackend.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/kernel_configuration_log.hpp"
+
+#ifdef HIPSYCL_WITH_LLVM_TO_PTX
+#include "hipSYCL/compiler/llvm-to-backend/ptx/LLVMToPtxFactory.hpp"
+#endif
+#ifdef HIPSYCL_WITH_LLVM_TO_AMDGPU
+#include "hipSYCL/compiler/llvm-to-backend/amdgpu/LLVMToAmdgpuFactory.hpp"
+#endif
+#ifdef HIPSYCL_WITH_LLVM_TO_SPIRV
+#include "hipSYCL/compiler/llvm-to-backend/spirv/LLVMToSpirvFactory.hpp"
+#endif
+#ifdef HIPSYCL_WITH_LLVM_TO_HOST
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
+#endif
+#ifdef HIPSYCL_WITH_LLVM_TO_MUSA
+#include "hipSYCL/compiler/llvm-to-backend/musa/LLVMToMusaFactory.hpp"
+#endif
+
+using namespace hipsycl;
+
+namespace {
+
+// Name of the global that the SSCP compiler uses to embed
+// the HCF object of a translation unit.
+constexpr const char* embedded_hcf_symbol = "__hipsycl_local_sscp_hcf_content";
+
+void help() {
+  std::cout
+      << "Usage: acpp-jit-cache-warmup [options] <configuration-log> "
+         "[<configuration-log> ...]\n"
+      << "Compiles all kernel configurations recorded in the given logs and "
+         "stores the\nresults in the persistent JIT cache, such that "
+         "applications do not need to JIT\ncompile these kernels at runtime.\n"
+      << "Options:\n"
+      << "  --hcf <path>   Load HCF object from a file, or all .hcf files in a "
+         "directory\n"
+      << "                 (e.g. as dumped using ACPP_HCF_DUMP_DIRECTORY)\n"
+      << "  --app <path>   Load HCF objects embedded in an application binary "
+         "or shared\n                 library (requires a symbol table)\n"
+      << "  -j <n>         Number of parallel compilations (default: number of "
+         "hardware threads)\n"
+      << "  --force        Recompile configurations that are already cached\n"
+      << "The JIT cache directory is determined in the same way as by the "
+         "AdaptiveCpp runtime." << std::endl;
+}
+
+bool read_file(const std::string& filename, std::string& out) {
+  std::ifstream file{filename, std::ios::binary|std::ios::ate};
+  if(!file.is_open())
+    return false;
+
+  auto size = file.tellg();
+  out = std::string(size, '\0');
+  file.seekg(0, std::ios::beg);
+  file.read(out.data(), size);
+  return true;
+}
+
+bool load_hcf_files(const std::string& path) {
+  std::vector<std::string> files;
+  try {
+    files = common::filesystem::list_regular_files(path, ".hcf");
+  } catch(...) {
+    // Not a directory
+    files = {path};
+  }
+
+  for(const auto& file : files) {
+    std::string content;
+    if(!read_file(file, content)) {
+      std::cerr << "Could not read HCF file " << file << std::endl;
+      return false;
+    }
+    rt::hcf_cache::get().register_hcf_object(common::hcf_container{content});
+  }
+  return true;
+}
+
+bool load_embedded_hcf_objects(const std::string& path) {
+  auto binary = llvm::object::createBinary(path);
+  if(!binary) {
+    std::cerr << "Could not open " << path << ": "
+              << llvm::toString(binary.takeError()) << std::endl;
+    return false;
+  }
+
+  auto *obj = llvm::dyn_cast<llvm::object::ELFObjectFileBase>(
+      binary->getBinary());
+  if(!obj) {
+    std::cerr << path << " is not an ELF file" << std::endl;
+    return false;
+  }
+
+  std::size_t num_objects = 0;
+  for(const llvm::object::ELFSymbolRef symbol : obj->symbols()) {
+    auto name = symbol.getName();
+    if(!name) {
+      llvm::consumeError(name.takeError());
+      continue;
+    }
+    if(*name != embedded_hcf_symbol)
+      continue;
+
+    auto section = symbol.getSection();
+    auto address = symbol.getAddress();
+    if(!section || !address || *section == obj->section_end()) {
+      if(!section)
+        llvm::consumeError(section.takeError());
+      if(!address)
+        llvm::consumeError(address.takeError());
+      continue;
+    }
+
+    auto content = (*section)->getContents();
+    if(!content) {
+      llvm::consumeError(content.takeError());
+      continue;
+    }
+    uint64_t offset = *address - (*section)->getAddress();
+    uint64_t size = symbol.getSize();
+    if(offset + size > content->size())
+      continue;
+
+    rt::hcf_cache::get().register_hcf_object(
+        common::hcf_container{content->substr(offset, size).str()});
+    ++num_objects;
+  }
+
+  if(num_objects == 0) {
+    std::cerr << "No embedded HCF objects found in " << path
+              << "; it may be stripped or not compiled with the generic SSCP "
+                 "target."
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<compiler::LLVMToBackendTranslator>
+create_translator(rt::backend_id backend,
+                  const std::vector<std::string>& kernel_names) {
+  switch(backend) {
+#ifdef HIPSYCL_WITH_LLVM_TO_PTX
+  case rt::backend_id::cuda:
+    return compiler::createLLVMToPtxTranslator(kernel_names);
+#endif
+#ifdef HIPSYCL_WITH_LLVM_TO_AMDGPU
+  case rt::backend_id::hip:
+    return compiler::createLLVMToAmdgpuTranslator(kernel_names);
+#endif
+#ifdef HIPSYCL_WITH_LLVM_TO_SPIRV
+  case rt::backend_id::level_zero:
+  case rt::backend_id::ocl:
+    return compiler::createLLVMToSpirvTranslator(kernel_names);
+#endif
+#ifdef HIPSYCL_WITH_LLVM_TO_HOST
+  case rt::backend_id::omp:
+    return compiler::createLLVMToHostTranslator(kernel_names);
+#endif
+#ifdef HIPSYCL_WITH_LLVM_TO_MUSA
+  case rt::backend_id::musa:
+    return compiler::createLLVMToMusaTranslator(kernel_names);
+#endif
+  default:
+    return nullptr;
+  }
+}
+
+}
+
+int main(int argc, char** argv) {
+  std::vector<std::string> logs;
+  std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  bool force = false;
+
+  for(int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if(arg == "--help" || arg == "-h") {
+      help();
+      return 0;
+    } else if(arg == "--hcf" && has_value) {
+      if(!load_hcf_files(argv[++i]))
+        return -1;
+    } else if(arg == "--app" && has_value) {
+      if(!load_embedded_hcf_objects(argv[++i]))
+        return -1;
+    } else if(arg == "-j" && has_value) {
+      num_threads = std::max(std::strtoul(argv[++i], nullptr, 10), 1ul);
+    } else if(arg == "--force") {
+      force = true;
+    } else if(arg.find("-") == 0) {
+      help();
+      return -1;
+    } else {
+      logs.push_back(arg);
+    }
+  }
+
+  if(logs.empty()) {
+    help();
+    return -1;
+  }
+
+  std::vector<rt::recorded_kernel_configuration> entries;
+  for(const auto& log : logs) {
+    if(!rt::read_kernel_configuration_log(log, entries)) {
+      std::cerr << "Could not read kernel configuration log " << log
+                << std::endl;
+      return -1;
+    }
+  }
+
+  // Logs may contain duplicates, e.g. if they were recorded in
+  // multiple runs or processes.
+  std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+    return a.config.generate_id() < b.config.generate_id();
+  });
+  entries.erase(std::unique(entries.begin(), entries.end(),
+                            [](const auto &a, const auto &b) {
+                              return a.config.generate_id() ==
+                                     b.config.generate_id();
+                            }),
+                entries.end());
+
+  auto cache = rt::kernel_cache::get();
+
+  std::atomic<std::size_t> next_entry = 0;
+  std::atomic<std::size_t> num_compiled = 0;
+  std::atomic<std::size_t> num_skipped = 0;
+  std::atomic<std::size_t> num_failed = 0;
+  std::mutex output_mutex;
+
+  auto worker = [&]() {
+    for(std::size_t i = next_entry++; i < entries.size(); i = next_entry++) {
+      const auto& entry = entries[i];
+      auto id = entry.config.generate_id();
+      std::string id_string = glue::kernel_configuration::to_string(id);
+
+      auto report = [&](const std::string& msg) {
+        std::lock_guard<std::mutex> lock{output_mutex};
+        std::cout << "[" << i + 1 << "/" << entries.size() << "] " << id_string
+                  << " (" << entry.image_name << "): " << msg << std::endl;
+      };
+
+      if(!force && cache->is_in_persistent_cache(id)) {
+        ++num_skipped;
+        report("already cached");
+        continue;
+      }
+
+      const common::hcf_container *hcf =
+          rt::hcf_cache::get().get_hcf(entry.hcf_object);
+      if(!hcf) {
+        ++num_failed;
+        report("HCF object " + std::to_string(entry.hcf_object) +
+               " has not been loaded");
+        continue;
+      }
+
+      auto translator = create_translator(entry.backend, entry.kernel_names);
+      if(!translator) {
+        ++num_failed;
+        report("backend is not supported by this build");
+        continue;
+      }
+
+      std::string binary;
+      auto err = glue::jit::compile(translator.get(), hcf, entry.image_name,
+                                    entry.config, binary);
+      if(!err.is_success()) {
+        ++num_failed;
+        report("compilation failed: " + err.what());
+        continue;
+      }
+
+      cache->store_in_persistent_cache(id, binary);
+      ++num_compiled;
+      report("compiled");
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for(std::size_t i = 0; i < std::min(num_threads, entries.size()); ++i)
+    workers.emplace_back(worker);
+  for(auto& w : workers)
+    w.join();
+
+  // Flushes the persistent cache index
+  cache->unload();
+
+  std::cout << num_compiled << " compiled, " << num_skipped
+            << " already cached, " << num_failed << " failed" << std::endl;
+
+  return num_failed > 0 ? -1 : 0;
+}
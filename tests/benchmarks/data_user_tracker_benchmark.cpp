@@ -0,0 +1,109 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures kernel submission throughput for many kernels that access
+// disjoint sub-ranges of the same buffer, as in tiled algorithms or
+// halo exchanges. The buffer page size is set to the tile size, such that
+// the runtime can track each tile separately. All submissions go through
+// DAG construction, which needs to find conflicting users of the buffer
+// for each accessor.
+//
+// Usage: data_user_tracker_benchmark [num_tiles] [tile_size] [num_rounds]
+//
+// On the OpenMP backend, the CPU device should be selected, e.g. using
+// ACPP_VISIBILITY_MASK=omp.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sycl/sycl.hpp>
+
+int main(int argc, char **argv) {
+  std::size_t num_tiles = 4096;
+  std::size_t tile_size = 16;
+  std::size_t num_rounds = 4;
+  if(argc > 1)
+    num_tiles = std::stoull(argv[1]);
+  if(argc > 2)
+    tile_size = std::stoull(argv[2]);
+  if(argc > 3)
+    num_rounds = std::stoull(argv[3]);
+
+  sycl::queue q;
+  std::cout << "Device: " << q.get_device().get_info<sycl::info::device::name>()
+            << std::endl;
+
+  std::vector<float> host_data(num_tiles * tile_size, 0.f);
+  sycl::buffer<float> buff{
+      host_data.data(), sycl::range<1>{num_tiles * tile_size},
+      sycl::property_list{sycl::property::buffer::hipSYCL_page_size<1>{
+          sycl::range<1>{tile_size}}}};
+
+  auto submit_tile = [&](std::size_t tile, bool read_only) {
+    q.submit([&](sycl::handler &cgh) {
+      sycl::range<1> r{tile_size};
+      sycl::id<1> offset{tile * tile_size};
+      if(read_only) {
+        sycl::accessor<float, 1, sycl::access_mode::read> acc{buff, cgh, r,
+                                                               offset};
+        cgh.single_task([=]() { (void)acc[0]; });
+      } else {
+        sycl::accessor<float, 1, sycl::access_mode::read_write> acc{
+            buff, cgh, r, offset};
+        cgh.single_task([=]() { acc[0] += 1.f; });
+      }
+    });
+  };
+
+  // Warm up
+  for(std::size_t tile = 0; tile < num_tiles; ++tile)
+    submit_tile(tile, false);
+  q.wait();
+
+  for(bool read_only : {false, true}) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for(std::size_t round = 0; round < num_rounds; ++round)
+      for(std::size_t tile = 0; tile < num_tiles; ++tile)
+        submit_tile(tile, read_only);
+    q.wait();
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    double seconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+            .count() *
+        1.e-9;
+    std::cout << (read_only ? "read" : "read_write") << " accessors on "
+              << num_tiles << " disjoint tiles: "
+              << num_rounds * num_tiles / seconds << " submissions/s"
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures the number of kernel submissions per second for in-order queues,
+// which may use the instant submission path, compared to out-of-order queues,
+// which always go through DAG construction and scheduling.
+// Kernels are empty or trivial, such that the numbers are dominated
+// by submission overheads.
+//
+// Usage: instant_submission_benchmark [num_submissions]
+//
+// On the OpenMP backend, the CPU device should be selected, e.g. using
+// ACPP_VISIBILITY_MASK=omp.
+
+#define HIPSYCL_ALLOW_INSTANT_SUBMISSION 1
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <sycl/sycl.hpp>
+
+namespace {
+
+template<class F>
+double measure_submissions_per_second(sycl::queue& q, std::size_t n, F&& f) {
+  // Warm up, so that allocations and kernel setup are not measured
+  f(q);
+  q.wait();
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for(std::size_t i = 0; i < n; ++i)
+    f(q);
+  q.wait();
+  auto stop = std::chrono::high_resolution_clock::now();
+  return n / std::chrono::duration<double>(stop - start).count();
+}
+
+template<class F>
+void run(const std::string& name, std::size_t n, F&& f) {
+  sycl::queue in_order_q{sycl::property::queue::in_order{}};
+  sycl::queue out_of_order_q{in_order_q.get_device()};
+
+  double in_order = measure_submissions_per_second(in_order_q, n, f);
+  double out_of_order = measure_submissions_per_second(out_of_order_q, n, f);
+
+  std::cout << name << ": in-order " << in_order
+            << " submissions/s, out-of-order " << out_of_order
+            << " submissions/s" << std::endl;
+}
+
+}
+
+int main(int argc, char** argv) {
+  std::size_t n = 100000;
+  if(argc > 1)
+    n = std::strtoul(argv[1], nullptr, 10);
+
+  sycl::queue q;
+  std::cout << "Running on " << q.get_device().get_info<sycl::info::device::name>()
+            << std::endl;
+
+  int* usm_data = sycl::malloc_device<int>(1, q);
+  sycl::buffer<int> buff{sycl::range<1>{1}};
+  // Make sure the buffer data is resident on the device
+  q.submit([&](sycl::handler& cgh){
+    sycl::accessor acc{buff, cgh, sycl::no_init};
+    cgh.single_task([=](){ acc[0] = 0; });
+  });
+  q.wait();
+
+  run("USM", n, [&](sycl::queue& q){
+    q.single_task([=](){ *usm_data += 1; });
+  });
+
+  run("buffer accessor", n, [&](sycl::queue& q){
+    q.submit([&](sycl::handler& cgh){
+      sycl::accessor acc{buff, cgh, sycl::read_write};
+      cgh.single_task([=](){ acc[0] += 1; });
+    });
+  });
+
+  run("reduction", n / 10, [&](sycl::queue& q){
+    q.parallel_for(sycl::range<1>{256}, sycl::reduction(usm_data, sycl::plus<int>{}),
+      [=](sycl::id<1> idx, auto& sum){ sum += 1; });
+  });
+
+  sycl::free(usm_data, q);
+}
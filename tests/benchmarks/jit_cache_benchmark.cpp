@@ -0,0 +1,174 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures the time required to load a persistent JIT cache with a few
+// hundred entries, comparing the legacy raw format (read into memory),
+// uncompressed (memory-mapped) and compressed entries.
+//
+// Usage: jit_cache_benchmark [num_kernels] [kernel_size_in_KiB]
+//
+// Note that the operating system's page cache is not dropped between runs,
+// so for truly cold numbers the page cache should be dropped externally
+// between invocations.
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hipSYCL/common/filesystem.hpp"
+#include "hipSYCL/runtime/jit_cache_entry.hpp"
+
+using namespace hipsycl;
+
+namespace {
+
+// Generates data that roughly resembles compiled code: Mostly random
+// instruction bytes from a limited alphabet, interspersed with repeated
+// symbol names.
+std::string generate_binary(std::size_t size, unsigned seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> byte_dist{0, 63};
+  std::string result;
+  result.reserve(size);
+  while(result.size() < size) {
+    if(gen() % 16 == 0)
+      result += "__acpp_sscp_kernel_" + std::to_string(gen() % 32);
+    else
+      result += static_cast<char>(byte_dist(gen));
+  }
+  result.resize(size);
+  return result;
+}
+
+std::string read_legacy(const std::string& filename) {
+  std::ifstream file{filename, std::ios::in | std::ios::binary | std::ios::ate};
+  std::string out;
+  if(!file.is_open())
+    return out;
+  std::streamsize file_size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  out.resize(file_size);
+  file.read(out.data(), file_size);
+  return out;
+}
+
+std::size_t directory_size(const std::string& dir) {
+  std::size_t size = 0;
+  for(const auto& f : common::filesystem::list_regular_files(dir)) {
+    std::ifstream file{f, std::ios::in | std::ios::binary | std::ios::ate};
+    size += static_cast<std::size_t>(file.tellg());
+  }
+  return size;
+}
+
+template<class F>
+double measure_ms(F&& f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  auto stop = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+}
+
+int main(int argc, char** argv) {
+  std::size_t num_kernels = 300;
+  std::size_t kernel_size = 512 * 1024;
+  if(argc > 1)
+    num_kernels = std::strtoul(argv[1], nullptr, 10);
+  if(argc > 2)
+    kernel_size = std::strtoul(argv[2], nullptr, 10) * 1024;
+
+  std::string dir =
+      (std::filesystem::temp_directory_path() / "acpp_jit_cache_benchmark")
+          .string();
+  std::filesystem::create_directories(dir);
+
+  struct variant {
+    std::string name;
+    bool legacy;
+    rt::jit_cache_compression compression;
+  };
+  std::vector<variant> variants{
+      {"raw (ifstream, legacy)", true, rt::jit_cache_compression::none},
+      {"uncompressed (mmap)", false, rt::jit_cache_compression::none}};
+  if(rt::is_jit_cache_compression_supported(rt::jit_cache_compression::zlib))
+    variants.push_back(
+        {"zlib compressed", false, rt::jit_cache_compression::zlib});
+
+  std::vector<std::string> binaries;
+  for(std::size_t i = 0; i < num_kernels; ++i)
+    binaries.push_back(generate_binary(kernel_size, i));
+
+  std::cout << "Loading " << num_kernels << " kernels of "
+            << kernel_size / 1024 << " KiB each" << std::endl;
+
+  for(const auto& v : variants) {
+    std::vector<std::string> files;
+    for(std::size_t i = 0; i < num_kernels; ++i) {
+      std::string f =
+          common::filesystem::join_path(dir, std::to_string(i) + ".jit");
+      files.push_back(f);
+      if(v.legacy)
+        common::filesystem::atomic_write(f, binaries[i]);
+      else
+        rt::write_jit_cache_entry(f, binaries[i], v.compression);
+    }
+
+    std::size_t checksum = 0;
+    double ms = measure_ms([&]() {
+      for(const auto& f : files) {
+        if(v.legacy) {
+          std::string binary = read_legacy(f);
+          // The old code path passed a copy on to the backend code object
+          std::string code_object_copy = binary;
+          checksum += code_object_copy.size();
+        } else {
+          auto binary = rt::read_jit_cache_entry(f);
+          if(!binary) {
+            std::cout << "Error reading " << f << std::endl;
+            std::exit(-1);
+          }
+          checksum += binary->get_data().size();
+        }
+      }
+    });
+
+    std::cout << v.name << ": " << ms << " ms, "
+              << directory_size(dir) / (1024 * 1024) << " MiB on disk"
+              << " (checksum " << checksum << ")" << std::endl;
+
+    for(const auto& f : files)
+      common::filesystem::remove(f);
+  }
+  std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+// Measures the execution time of nd_range kernels on the host device,
+// comparing the OpenMP based work group scheduling with the runtime-owned
+// thread pool (ACPP_RT_OMP_THREAD_POOL=1). Three workloads are measured:
+//  * uniform: all work groups perform the same amount of work
+//  * irregular: a small, contiguous subset of work groups performs
+//    much more work than the rest, which defeats static partitioning
+//  * launch: a stream of tiny kernels, dominated by launch overhead
+//
+// Usage: omp_kernel_launch_benchmark [num_groups] [group_size] [num_runs]
+//
+// The thread pool is only used for kernels compiled for the generic
+// SSCP target (--acpp-targets=generic), and the CPU device should be
+// selected, e.g. using ACPP_VISIBILITY_MASK=omp.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <sycl/sycl.hpp>
+
+namespace {
+
+template <class F> double measure_ms(std::size_t num_runs, F &&f) {
+  // Warm-up, this also triggers JIT compilation
+  f();
+  auto start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < num_runs; ++i)
+    f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count() /
+         num_runs;
+}
+
+}
+
+int main(int argc, char **argv) {
+  std::size_t num_groups = 4096;
+  std::size_t group_size = 64;
+  std::size_t num_runs = 20;
+  if(argc > 1)
+    num_groups = std::stoull(argv[1]);
+  if(argc > 2)
+    group_size = std::stoull(argv[2]);
+  if(argc > 3)
+    num_runs = std::stoull(argv[3]);
+
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  std::cout << "Device: " << q.get_device().get_info<sycl::info::device::name>()
+            << std::endl;
+
+  const char *pool_setting = std::getenv("ACPP_RT_OMP_THREAD_POOL");
+  std::cout << "Thread pool: "
+            << ((pool_setting && std::string{pool_setting} == "1") ? "on"
+                                                                    : "off")
+            << std::endl;
+
+  const std::size_t num_items = num_groups * group_size;
+  float *data = sycl::malloc_shared<float>(num_items, q);
+  q.fill(data, 1.f, num_items).wait();
+
+  auto run_kernel = [&](std::size_t groups, auto work_per_group) {
+    q.parallel_for(sycl::nd_range<1>{groups * group_size, group_size},
+                   [=](sycl::nd_item<1> idx) {
+                     std::size_t gid = idx.get_global_linear_id();
+                     int iterations = work_per_group(idx.get_group_linear_id());
+                     float x = data[gid];
+                     for(int i = 0; i < iterations; ++i)
+                       x = x * 0.999f + 0.001f;
+                     data[gid] = x;
+                   });
+    q.wait();
+  };
+
+  const std::size_t heavy_groups = num_groups / 16;
+
+  double uniform_ms = measure_ms(num_runs, [&]() {
+    run_kernel(num_groups, [](std::size_t) { return 64; });
+  });
+  double irregular_ms = measure_ms(num_runs, [&]() {
+    // Same total work as the uniform case, concentrated in the first
+    // 1/16th of the work groups.
+    run_kernel(num_groups, [=](std::size_t group) {
+      return group < heavy_groups ? 16 * 64 - 15 : 1;
+    });
+  });
+
+  const std::size_t num_launches = 100 * num_runs;
+  double launch_ms = measure_ms(num_launches, [&]() {
+    run_kernel(64, [](std::size_t) { return 1; });
+  });
+
+  std::cout << "uniform:   " << uniform_ms << " ms/kernel" << std::endl;
+  std::cout << "irregular: " << irregular_ms << " ms/kernel" << std::endl;
+  std::cout << "launch:    " << launch_ms * 1000.0 << " us/kernel"
+            << std::endl;
+
+  sycl::free(data, q);
+}
@@ -0,0 +1,143 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures the cost of the page table operations that the scheduler
+// performs for each buffer requirement, mark_range_current() and
+// get_outdated_regions(), on buffers with a large number of pages.
+// The dense page table representation, which stores one entry per page,
+// is compared against the sparse representation, which stores disjoint
+// boxes of valid pages (see HIPSYCL_EXT_BUFFER_SPARSE_PAGE_TABLE).
+//
+// Usage: range_store_benchmark [num_pages_per_dimension] [num_iterations]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hipSYCL/runtime/data.hpp>
+#include <hipSYCL/runtime/device_id.hpp>
+
+namespace rt = hipsycl::rt;
+
+namespace {
+
+rt::device_id make_device(int idx) {
+  return rt::device_id{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                              rt::api_platform::omp},
+                       idx};
+}
+
+struct access_pattern {
+  std::string name;
+  rt::id<3> offset;
+  rt::range<3> size;
+};
+
+double measure_us_per_iteration(rt::range_store::representation rep,
+                                rt::range<3> num_pages,
+                                const access_pattern &pattern,
+                                std::size_t num_iterations,
+                                std::size_t &num_outdated_regions) {
+  // Page size of 1 element, so that each element corresponds to one page
+  rt::buffer_data_region data{num_pages, sizeof(float), rt::range<3>{1, 1, 1},
+                              rep};
+  rt::device_id dev0 = make_device(0);
+  rt::device_id dev1 = make_device(1);
+
+  // The allocations are never accessed, so dummy pointers suffice
+  static char dummy_memory[2];
+  data.add_empty_allocation(dev0, &dummy_memory[0], nullptr, false);
+  data.add_empty_allocation(dev1, &dummy_memory[1], nullptr, false);
+  data.mark_range_current(dev0, rt::id<3>{0, 0, 0}, num_pages);
+
+  std::vector<rt::range_store::rect> outdated;
+  num_outdated_regions = 0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for(std::size_t i = 0; i < num_iterations; ++i) {
+    // Alternate the writing device, as a kernel sequence running
+    // on two devices would do.
+    rt::device_id writer = (i % 2 == 0) ? dev1 : dev0;
+    rt::device_id reader = (i % 2 == 0) ? dev0 : dev1;
+    data.get_outdated_regions(writer, pattern.offset, pattern.size, outdated);
+    num_outdated_regions += outdated.size();
+    data.mark_range_current(writer, pattern.offset, pattern.size);
+    data.get_outdated_regions(reader, pattern.offset, pattern.size, outdated);
+    num_outdated_regions += outdated.size();
+  }
+  auto stop = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+             .count() *
+         1.e-3 / num_iterations;
+}
+
+}
+
+int main(int argc, char **argv) {
+  std::size_t pages_per_dim = 100;
+  std::size_t num_iterations = 20;
+  if(argc > 1)
+    pages_per_dim = std::stoull(argv[1]);
+  if(argc > 2)
+    num_iterations = std::stoull(argv[2]);
+
+  rt::range<3> num_pages{pages_per_dim, pages_per_dim, pages_per_dim};
+  std::size_t half = pages_per_dim / 2;
+
+  std::vector<access_pattern> patterns = {
+      {"entire buffer", rt::id<3>{0, 0, 0}, num_pages},
+      {"upper half", rt::id<3>{half, 0, 0},
+       rt::range<3>{pages_per_dim - half, pages_per_dim, pages_per_dim}},
+      {"inner half (dim 2)", rt::id<3>{0, 0, half / 2},
+       rt::range<3>{pages_per_dim, pages_per_dim, half}},
+      {"single plane", rt::id<3>{half, 0, 0},
+       rt::range<3>{1, pages_per_dim, pages_per_dim}}};
+
+  std::cout << "Buffer with " << num_pages.size() << " pages, "
+            << num_iterations << " iterations" << std::endl;
+
+  for(const auto &pattern : patterns) {
+    std::size_t dense_regions = 0;
+    std::size_t sparse_regions = 0;
+    double dense = measure_us_per_iteration(
+        rt::range_store::representation::dense, num_pages, pattern,
+        num_iterations, dense_regions);
+    double sparse = measure_us_per_iteration(
+        rt::range_store::representation::sparse, num_pages, pattern,
+        num_iterations, sparse_regions);
+
+    std::cout << pattern.name << ": dense " << dense << " us/iteration ("
+              << dense_regions << " outdated regions), sparse " << sparse
+              << " us/iteration (" << sparse_regions
+              << " outdated regions), speedup " << dense / sparse
+              << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures the startup time of the runtime. Each run starts the runtime
+// from scratch and measures
+//  * host queue: the time until a kernel has completed on a queue for the
+//    host device, without enumerating the devices of other backends
+//  * enumeration: the time for sycl::device::get_devices() afterwards,
+//    which creates all backends that have not been created yet
+//
+// Usage: runtime_startup_benchmark [num_runs]
+//
+// Compare e.g. ACPP_RT_PARALLEL_BACKEND_INIT=0/1 and
+// ACPP_RT_LAZY_BACKEND_INIT=0/1. The first run includes loading the
+// backend plugins and their vendor libraries from disk and is therefore
+// reported separately.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <sycl/sycl.hpp>
+
+namespace {
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}
+
+int main(int argc, char **argv) {
+  std::size_t num_runs = 10;
+  if(argc > 1)
+    num_runs = std::stoull(argv[1]);
+
+  double total_host_queue_ms = 0.0;
+  double total_enumeration_ms = 0.0;
+  std::size_t num_devices = 0;
+
+  for(std::size_t run = 0; run <= num_runs; ++run) {
+    double host_queue_ms = 0.0;
+    double enumeration_ms = 0.0;
+    {
+      auto start = std::chrono::steady_clock::now();
+      sycl::queue q{sycl::device{hipsycl::sycl::detail::get_host_device()}};
+      q.single_task([]() {}).wait();
+      host_queue_ms = elapsed_ms(start);
+
+      start = std::chrono::steady_clock::now();
+      num_devices = sycl::device::get_devices().size();
+      enumeration_ms = elapsed_ms(start);
+    }
+    // The runtime shuts down once the queue has been destroyed.
+
+    if(run == 0) {
+      std::cout << "first run: host queue: " << host_queue_ms
+                << " ms, enumeration: " << enumeration_ms << " ms"
+                << std::endl;
+    } else {
+      total_host_queue_ms += host_queue_ms;
+      total_enumeration_ms += enumeration_ms;
+    }
+  }
+
+  std::cout << "Devices: " << num_devices << std::endl;
+  if(num_runs > 0) {
+    std::cout << "average:   host queue: " << total_host_queue_ms / num_runs
+              << " ms, enumeration: " << total_enumeration_ms / num_runs
+              << " ms" << std::endl;
+  }
+}
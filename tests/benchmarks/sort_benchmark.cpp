@@ -0,0 +1,137 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures the throughput of hipsycl::algorithms::sort for problem sizes from 1K
+// to 1G elements. Three variants are measured:
+//  * radix: 32-bit unsigned keys using the onesweep radix sort
+//  * radix (key-value): 32-bit keys with 32-bit values
+//  * merge: 32-bit keys with a custom comparator, which uses merge sort
+//
+// Usage: sort_benchmark [max_problem_size] [num_runs]
+//
+// Sizes that do not fit into device memory are skipped.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <sycl/sycl.hpp>
+#include <hipSYCL/algorithms/algorithm.hpp>
+
+namespace {
+
+template <class F> double measure_ms(std::size_t num_runs, F &&f) {
+  // Warm-up, this also triggers JIT compilation
+  f();
+  double total = 0.0;
+  for(std::size_t i = 0; i < num_runs; ++i)
+    total += f();
+  return total / num_runs;
+}
+
+void fill_random(sycl::queue &q, std::uint32_t *data, std::size_t n) {
+  q.parallel_for(sycl::range<1>{n}, [=](sycl::id<1> idx) {
+    // Cheap integer hash of the index
+    std::uint32_t x = static_cast<std::uint32_t>(idx[0]) * 2654435761u;
+    x ^= x >> 16;
+    x *= 0x45d9f3bu;
+    x ^= x >> 16;
+    data[idx[0]] = x;
+  });
+}
+
+}
+
+int main(int argc, char **argv) {
+  std::size_t max_problem_size = std::size_t{1} << 30;
+  std::size_t num_runs = 5;
+  if(argc > 1)
+    max_problem_size = std::stoull(argv[1]);
+  if(argc > 2)
+    num_runs = std::stoull(argv[2]);
+
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  std::cout << "Device: " << q.get_device().get_info<sycl::info::device::name>()
+            << std::endl;
+
+  const std::size_t global_mem_size =
+      q.get_device().get_info<sycl::info::device::global_mem_size>();
+
+  hipsycl::algorithms::util::allocation_cache cache{
+      hipsycl::algorithms::util::allocation_type::device};
+
+  for(std::size_t n = 1024; n <= max_problem_size; n *= 4) {
+    // Keys, values and scratch buffers for both
+    if(4 * n * sizeof(std::uint32_t) > global_mem_size) {
+      std::cout << n << " elements: skipped (insufficient device memory)"
+                << std::endl;
+      continue;
+    }
+
+    std::uint32_t *keys = sycl::malloc_device<std::uint32_t>(n, q);
+    std::uint32_t *values = sycl::malloc_device<std::uint32_t>(n, q);
+
+    auto run = [&](auto sorter) {
+      return measure_ms(num_runs, [&]() {
+        fill_random(q, keys, n);
+        q.wait();
+        hipsycl::algorithms::util::allocation_group scratch{&cache,
+                                                            q.get_device()};
+        auto start = std::chrono::steady_clock::now();
+        sorter(scratch);
+        q.wait();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(stop - start).count();
+      });
+    };
+
+    double radix_ms = run([&](auto &scratch) {
+      hipsycl::algorithms::sort(q, scratch, keys, keys + n);
+    });
+    double radix_kv_ms = run([&](auto &scratch) {
+      hipsycl::algorithms::sort_by_key(q, scratch, keys, keys + n, values);
+    });
+    double merge_ms = run([&](auto &scratch) {
+      hipsycl::algorithms::sort(q, scratch, keys, keys + n,
+                       [](std::uint32_t a, std::uint32_t b) { return a < b; });
+    });
+
+    auto print = [&](const std::string &name, double ms) {
+      std::cout << n << " elements, " << name << ": " << ms << " ms ("
+                << static_cast<double>(n) / (ms * 1.e3) << " Mkeys/s)"
+                << std::endl;
+    };
+    print("radix", radix_ms);
+    print("radix (key-value)", radix_kv_ms);
+    print("merge", merge_ms);
+
+    sycl::free(keys, q);
+    sycl::free(values, q);
+  }
+}
@@ -0,0 +1,107 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures the host-side throughput of kernel launches for each available
+// device. Tiny kernels are submitted back-to-back to an in-order queue, such
+// that the result is dominated by the submission and launch overhead of the
+// runtime. Two workloads are measured:
+//  * single: the same kernel is launched repeatedly
+//  * alternating: two different kernels are launched in turns
+//
+// Usage: sscp_launch_benchmark [num_launches] [num_runs]
+//
+// For kernels compiled for the generic SSCP target (--acpp-targets=generic),
+// repeated launches are served from the per-kernel launch site cache
+// as long as ACPP_ADAPTIVITY_LEVEL is at most 1.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <sycl/sycl.hpp>
+
+namespace {
+
+template <class F> double measure_ms(std::size_t num_runs, F &&f) {
+  // Warm-up, this also triggers JIT compilation
+  f();
+  auto start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < num_runs; ++i)
+    f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count() /
+         num_runs;
+}
+
+}
+
+int main(int argc, char **argv) {
+  std::size_t num_launches = 10000;
+  std::size_t num_runs = 5;
+  if(argc > 1)
+    num_launches = std::stoull(argv[1]);
+  if(argc > 2)
+    num_runs = std::stoull(argv[2]);
+
+  for(const auto &dev : sycl::device::get_devices()) {
+    sycl::queue q{dev, sycl::property_list{sycl::property::queue::in_order{}}};
+    std::cout << "Device: " << dev.get_info<sycl::info::device::name>()
+              << std::endl;
+
+    int *data = sycl::malloc_device<int>(64, q);
+    q.fill(data, 0, 64).wait();
+
+    double single_ms = measure_ms(num_runs, [&]() {
+      for(std::size_t i = 0; i < num_launches; ++i)
+        q.parallel_for(sycl::range<1>{64},
+                       [=](sycl::id<1> idx) { data[idx[0]] += 1; });
+      q.wait();
+    });
+
+    double alternating_ms = measure_ms(num_runs, [&]() {
+      for(std::size_t i = 0; i < num_launches; i += 2) {
+        q.parallel_for(sycl::range<1>{64},
+                       [=](sycl::id<1> idx) { data[idx[0]] += 1; });
+        q.parallel_for(sycl::range<1>{64},
+                       [=](sycl::id<1> idx) { data[idx[0]] -= 1; });
+      }
+      q.wait();
+    });
+
+    auto print = [&](const std::string &name, double ms) {
+      std::cout << "  " << name << ": "
+                << static_cast<double>(num_launches) / (ms * 1.e-3)
+                << " launches/s (" << ms * 1.e3 / num_launches
+                << " us/launch)" << std::endl;
+    };
+    print("single     ", single_ms);
+    print("alternating", alternating_ms);
+
+    sycl::free(data, q);
+  }
+}
@@ -0,0 +1,149 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures the bandwidth of strided sub-buffer copies as they appear in
+// halo exchanges of 3D stencil codes. For an n^3 grid of doubles, the
+// halo of width w on each face is copied
+//  * d2d: between the same face of two device buffers
+//  * d2h: from the device buffer into a contiguous host array
+//  * h2d: from a contiguous host array into the device buffer
+// The face normal to dimension 0 is contiguous, the face normal to
+// dimension 1 consists of w*n rows of n elements and the face normal to
+// dimension 2 consists of n*n rows of w elements.
+//
+// Usage: strided_memcpy_benchmark [n] [halo_width] [num_runs]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sycl/sycl.hpp>
+
+namespace {
+
+template <class F> double measure_ms(std::size_t num_runs, F &&f) {
+  // Warm-up, this also makes sure that data is resident on the device
+  f();
+  auto start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < num_runs; ++i)
+    f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count() /
+         num_runs;
+}
+
+double linear_id(sycl::id<3> idx, std::size_t n) {
+  return static_cast<double>((idx[0] * n + idx[1]) * n + idx[2]);
+}
+
+}
+
+int main(int argc, char **argv) {
+  std::size_t n = 256;
+  std::size_t halo_width = 1;
+  std::size_t num_runs = 20;
+  if(argc > 1)
+    n = std::stoull(argv[1]);
+  if(argc > 2)
+    halo_width = std::stoull(argv[2]);
+  if(argc > 3)
+    num_runs = std::stoull(argv[3]);
+
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  std::cout << "Device: " << q.get_device().get_info<sycl::info::device::name>()
+            << std::endl;
+
+  sycl::range<3> grid{n, n, n};
+  sycl::buffer<double, 3> a{grid};
+  sycl::buffer<double, 3> b{grid};
+
+  q.submit([&](sycl::handler &cgh) {
+    sycl::accessor acc{a, cgh, sycl::write_only, sycl::no_init};
+    cgh.parallel_for(grid, [=](sycl::id<3> idx) { acc[idx] = linear_id(idx, n); });
+  });
+  q.submit([&](sycl::handler &cgh) {
+    sycl::accessor acc{b, cgh, sycl::write_only, sycl::no_init};
+    cgh.parallel_for(grid, [=](sycl::id<3> idx) { acc[idx] = 0.0; });
+  });
+  q.wait();
+
+  for(int dim = 0; dim < 3; ++dim) {
+    sycl::range<3> face = grid;
+    face[dim] = halo_width;
+    // The far face, where the halo of the neighbor would be received
+    sycl::id<3> offset{};
+    offset[dim] = n - halo_width;
+
+    std::vector<double> host_face(face.size());
+    const double face_bytes = static_cast<double>(face.size() * sizeof(double));
+
+    double d2d_ms = measure_ms(num_runs, [&]() {
+      q.submit([&](sycl::handler &cgh) {
+        sycl::accessor src{a, cgh, face, offset, sycl::read_only};
+        sycl::accessor dest{b, cgh, face, offset, sycl::write_only};
+        cgh.copy(src, dest);
+      });
+      q.wait();
+    });
+    double d2h_ms = measure_ms(num_runs, [&]() {
+      q.submit([&](sycl::handler &cgh) {
+        sycl::accessor src{a, cgh, face, offset, sycl::read_only};
+        cgh.copy(src, host_face.data());
+      });
+      q.wait();
+    });
+
+    bool is_correct = true;
+    for(std::size_t i = 0; i < face[0]; ++i)
+      for(std::size_t j = 0; j < face[1]; ++j)
+        for(std::size_t k = 0; k < face[2]; ++k) {
+          sycl::id<3> idx = offset + sycl::id<3>{i, j, k};
+          if(host_face[(i * face[1] + j) * face[2] + k] != linear_id(idx, n))
+            is_correct = false;
+        }
+
+    double h2d_ms = measure_ms(num_runs, [&]() {
+      q.submit([&](sycl::handler &cgh) {
+        sycl::accessor dest{a, cgh, face, offset, sycl::write_only};
+        cgh.copy(host_face.data(), dest);
+      });
+      q.wait();
+    });
+
+    auto print = [&](const std::string &name, double ms) {
+      std::cout << "face " << dim << ", " << name << ": " << ms << " ms ("
+                << face_bytes / (ms * 1.e6) << " GB/s)" << std::endl;
+    };
+    print("d2d", d2d_ms);
+    print("d2h", d2h_ms);
+    print("h2d", h2d_ms);
+    if(!is_correct)
+      std::cout << "face " << dim << ": d2h result is incorrect!" << std::endl;
+  }
+}
@@ -0,0 +1,118 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures task submission throughput, both of the raw runtime worker
+// thread queue with multiple concurrent producers, and of end-to-end SYCL
+// submission of empty kernels into an in-order queue.
+//
+// Usage: task_submission_benchmark [num_tasks] [num_sycl_kernels]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <sycl/sycl.hpp>
+
+#include "hipSYCL/runtime/generic/async_worker.hpp"
+
+using namespace hipsycl;
+
+namespace {
+
+template<class F>
+double measure_s(F&& f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  auto stop = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+void run_worker_benchmark(std::size_t num_tasks, std::size_t num_producers) {
+  rt::worker_thread worker;
+  std::atomic<std::size_t> counter{0};
+
+  double s = measure_s([&]() {
+    std::vector<std::thread> producers;
+    for(std::size_t p = 0; p < num_producers; ++p) {
+      producers.emplace_back([&, p]() {
+        std::size_t begin = p * num_tasks / num_producers;
+        std::size_t end = (p + 1) * num_tasks / num_producers;
+        for(std::size_t i = begin; i < end; ++i)
+          worker([&counter]() {
+            counter.fetch_add(1, std::memory_order_relaxed);
+          });
+      });
+    }
+    for(auto& t : producers)
+      t.join();
+    worker.wait();
+  });
+
+  if(counter.load() != num_tasks) {
+    std::cout << "Error: Executed " << counter.load() << " tasks, expected "
+              << num_tasks << std::endl;
+    std::exit(-1);
+  }
+  std::cout << "worker_thread, " << num_producers << " producer(s): "
+            << num_tasks / s << " tasks/s" << std::endl;
+}
+
+void run_sycl_benchmark(std::size_t num_kernels) {
+  sycl::queue q{sycl::cpu_selector_v, sycl::property::queue::in_order{}};
+  // Warm up, so that kernel setup costs are not measured
+  q.single_task([](){});
+  q.wait();
+
+  double s = measure_s([&]() {
+    for(std::size_t i = 0; i < num_kernels; ++i)
+      q.single_task([](){});
+    q.wait();
+  });
+
+  std::cout << "SYCL in-order queue ("
+            << q.get_device().get_info<sycl::info::device::name>()
+            << "): " << num_kernels / s << " kernels/s" << std::endl;
+}
+
+}
+
+int main(int argc, char** argv) {
+  std::size_t num_tasks = 1000000;
+  std::size_t num_sycl_kernels = 100000;
+  if(argc > 1)
+    num_tasks = std::strtoul(argv[1], nullptr, 10);
+  if(argc > 2)
+    num_sycl_kernels = std::strtoul(argv[2], nullptr, 10);
+
+  for(std::size_t num_producers : {1, 2, 4})
+    run_worker_benchmark(num_tasks, num_producers);
+
+  run_sycl_benchmark(num_sycl_kernels);
+}
@@ -0,0 +1,37 @@
+// RUN: %acpp %s -o %t --acpp-targets=generic
+// RUN: env ACPP_ADAPTIVITY_LEVEL=2 %t | FileCheck %s
+// RUN: %acpp %s -o %t --acpp-targets=generic -O3
+// RUN: env ACPP_ADAPTIVITY_LEVEL=2 %t | FileCheck %s
+
+#include <iostream>
+
+#include <sycl/sycl.hpp>
+#include "common.hpp"
+
+// All kernel arguments point into distinct allocations, but the kernel
+// writes to the allocation of data through a pointer loaded from table.
+// data must therefore not be treated as noalias.
+int main() {
+  sycl::queue q = get_queue();
+
+  int* data = sycl::malloc_device<int>(2, q);
+  int** table = sycl::malloc_device<int*>(1, q);
+  q.memcpy(table, &data, sizeof(int*)).wait();
+
+  for(int i = 0; i < 2; ++i) {
+    q.single_task([=](){
+      data[0] = 1;
+      *table[0] = 2;
+      data[1] = data[0];
+    }).wait();
+
+    int result = 0;
+    q.memcpy(&result, data + 1, sizeof(int)).wait();
+    // CHECK: 2
+    // CHECK: 2
+    std::cout << result << std::endl;
+  }
+
+  sycl::free(table, q);
+  sycl::free(data, q);
+}
@@ -0,0 +1,103 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <execution>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_sort, enable_unified_shared_memory)
+
+template<class T, class Generator, class Compare>
+void test_sort(std::size_t size, Generator gen, Compare comp) {
+  std::vector<T> data(size);
+  for(std::size_t i = 0; i < data.size(); ++i)
+    data[i] = gen(i);
+
+  std::vector<T> reference = data;
+  std::stable_sort(reference.begin(), reference.end(), comp);
+
+  std::sort(std::execution::par_unseq, data.begin(), data.end(), comp);
+  BOOST_CHECK(data == reference);
+}
+
+template<class T>
+void test_basic_sort(std::size_t size) {
+  std::mt19937 rng{123};
+  auto gen = [&](std::size_t) {
+    return static_cast<T>(static_cast<int>(rng() % 2001) - 1000);
+  };
+  // Arithmetic keys with std::less/std::greater use radix sort
+  test_sort<T>(size, gen, std::less<>{});
+  test_sort<T>(size, gen, std::greater<T>{});
+
+  std::vector<T> data(size);
+  for(std::size_t i = 0; i < data.size(); ++i)
+    data[i] = gen(i);
+  std::vector<T> reference = data;
+  std::sort(reference.begin(), reference.end());
+  std::sort(std::execution::par_unseq, data.begin(), data.end());
+  BOOST_CHECK(data == reference);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  test_basic_sort<int>(0);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  test_basic_sort<int>(1);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_incomplete_single_work_group) {
+  test_basic_sort<int>(127);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_medium_size) {
+  test_basic_sort<float>(1000);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_size) {
+  test_basic_sort<long long>(1000*1000);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_custom_comparator) {
+  // Custom comparators use merge sort. Only compares the first element,
+  // so this also checks that equivalent elements keep their order.
+  auto gen = [](std::size_t i) {
+    return std::make_pair(static_cast<int>((i * 7) % 13), static_cast<int>(i));
+  };
+  test_sort<std::pair<int, int>>(
+      10000, gen,
+      [](const auto &a, const auto &b) { return a.first < b.first; });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -29,13 +29,128 @@
 #include "runtime_test_suite.hpp"
 
 #include <boost/test/tools/old/interface.hpp>
+#include <algorithm>
+#include <random>
 #include <vector>
 #include <memory>
 #include <hipSYCL/runtime/data.hpp>
+#include <hipSYCL/runtime/dag_node.hpp>
+#include <hipSYCL/runtime/operations.hpp>
 #include <hipSYCL/runtime/util.hpp>
 
 using namespace hipsycl;
 
+namespace {
+
+using rect = rt::range_store::rect;
+
+std::size_t linear_page_index(const rt::range<3> &size, std::size_t x,
+                              std::size_t y, std::size_t z) {
+  return x * size[1] * size[2] + y * size[2] + z;
+}
+
+// Marks all pages covered by r
+void rasterize(const rt::range<3> &size, const rect &r,
+               std::vector<bool> &pages) {
+  for(std::size_t x = r.first[0]; x < r.first[0] + r.second[0]; ++x)
+    for(std::size_t y = r.first[1]; y < r.first[1] + r.second[1]; ++y)
+      for(std::size_t z = r.first[2]; z < r.first[2] + r.second[2]; ++z)
+        pages[linear_page_index(size, x, y, z)] = true;
+}
+
+bool contains(const rect &outer, const rect &inner) {
+  for(int i = 0; i < 3; ++i)
+    if(inner.first[i] < outer.first[i] ||
+       inner.first[i] + inner.second[i] > outer.first[i] + outer.second[i])
+      return false;
+  return true;
+}
+
+// Returns the set of pages covered by intersections_with(), and checks
+// that the returned rects are non-empty, disjoint and inside the query.
+std::vector<bool> get_intersection_pages(const rt::range_store &store,
+                                         const rect &query,
+                                         rt::range_store::data_state state) {
+  const rt::range<3> size = store.get_size();
+  std::vector<bool> pages(size.size(), false);
+
+  std::vector<rect> intersections;
+  store.intersections_with(query, state, intersections);
+
+  std::size_t total_volume = 0;
+  for(const auto &r : intersections) {
+    BOOST_CHECK(r.second.size() > 0);
+    BOOST_CHECK(contains(query, r));
+    total_volume += r.second.size();
+    rasterize(size, r, pages);
+  }
+  // Rects are disjoint if their volumes add up to the covered volume
+  BOOST_CHECK_EQUAL(total_volume,
+                    static_cast<std::size_t>(
+                        std::count(pages.begin(), pages.end(), true)));
+  return pages;
+}
+
+rect random_rect(std::mt19937 &gen, const rt::range<3> &size) {
+  rect r;
+  for(int i = 0; i < 3; ++i) {
+    std::uniform_int_distribution<std::size_t> begin_dist{0, size[i] - 1};
+    r.first[i] = begin_dist(gen);
+    std::uniform_int_distribution<std::size_t> extent_dist{
+        1, size[i] - r.first[i]};
+    r.second[i] = extent_dist(gen);
+  }
+  return r;
+}
+
+// Checks that the sparse and dense representations answer all
+// queries identically
+void check_range_store_parity(const rt::range_store &dense,
+                              const rt::range_store &sparse,
+                              const std::vector<rect> &queries) {
+  using state = rt::range_store::data_state;
+  for(const auto &q : queries) {
+    BOOST_CHECK_EQUAL(dense.entire_range_filled(q),
+                      sparse.entire_range_filled(q));
+    BOOST_CHECK_EQUAL(dense.entire_range_empty(q),
+                      sparse.entire_range_empty(q));
+    BOOST_CHECK(get_intersection_pages(dense, q, state::available) ==
+                get_intersection_pages(sparse, q, state::available));
+    BOOST_CHECK(get_intersection_pages(dense, q, state::empty) ==
+                get_intersection_pages(sparse, q, state::empty));
+  }
+}
+
+rt::dag_node_ptr make_dummy_node() {
+  return std::make_shared<rt::dag_node>(rt::execution_hints{},
+                                        rt::node_list_t{}, nullptr, nullptr);
+}
+
+// Users that are visited by for_each_potentially_conflicting_user()
+std::vector<rt::dag_node_ptr>
+get_potentially_conflicting_users(rt::data_user_tracker &tracker,
+                                  rt::id<3> offset, rt::range<3> range,
+                                  sycl::access::mode mode) {
+  std::vector<rt::dag_node_ptr> result;
+  tracker.for_each_potentially_conflicting_user(
+      offset, range, mode,
+      [&](const rt::data_user &user) { result.push_back(user.user.lock()); });
+  return result;
+}
+
+bool is_contained(const std::vector<rt::dag_node_ptr> &nodes,
+                  const rt::dag_node_ptr &node) {
+  return std::find(nodes.begin(), nodes.end(), node) != nodes.end();
+}
+
+void add_user(rt::data_user_tracker &tracker, const rt::dag_node_ptr &node,
+              sycl::access::mode mode, rt::id<3> offset, rt::range<3> range) {
+  tracker.add_user(node, mode, sycl::access::target::device, offset, range,
+                   [](const rt::data_user &) { return false; });
+}
+
+}
+
 BOOST_FIXTURE_TEST_SUITE(data, reset_device_fixture)
 BOOST_AUTO_TEST_CASE(page_table) {
   rt::range_store::rect full_range{rt::id<3>{0, 0, 0},
@@ -96,4 +211,258 @@ BOOST_AUTO_TEST_CASE(page_table) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(sparse_page_table_parity) {
+  using rep = rt::range_store::representation;
+
+  std::vector<rt::range<3>> sizes{rt::range<3>{1, 1, 64},
+                                  rt::range<3>{1, 8, 8},
+                                  rt::range<3>{5, 7, 9}};
+  std::mt19937 gen{42};
+
+  for(const auto &size : sizes) {
+    rt::range_store dense{size, rep::dense};
+    rt::range_store sparse{size, rep::sparse};
+    BOOST_CHECK(sparse.get_representation() == rep::sparse);
+    BOOST_CHECK(sparse.get_size() == size);
+
+    const rect full_range{rt::id<3>{0, 0, 0}, size};
+    // Boxes touching the boundaries of the page table
+    const rect first_page{rt::id<3>{0, 0, 0}, rt::range<3>{1, 1, 1}};
+    const rect last_page{
+        rt::id<3>{size[0] - 1, size[1] - 1, size[2] - 1},
+        rt::range<3>{1, 1, 1}};
+    const rect last_slice{rt::id<3>{size[0] - 1, 0, 0},
+                          rt::range<3>{1, size[1], size[2]}};
+    const rect last_row{rt::id<3>{0, size[1] - 1, 0},
+                        rt::range<3>{size[0], 1, size[2]}};
+    const rect last_column{rt::id<3>{0, 0, size[2] - 1},
+                           rt::range<3>{size[0], size[1], 1}};
+
+    std::vector<rect> queries{full_range, first_page, last_page,
+                              last_slice, last_row,   last_column};
+    for(int i = 0; i < 16; ++i)
+      queries.push_back(random_rect(gen, size));
+
+    check_range_store_parity(dense, sparse, queries);
+
+    // Boundary boxes
+    for(const auto &r : {first_page, last_page, last_column, last_row}) {
+      dense.add(r);
+      sparse.add(r);
+      check_range_store_parity(dense, sparse, queries);
+      BOOST_CHECK(sparse.entire_range_filled(r));
+    }
+
+    // Fully covered queries
+    dense.add(full_range);
+    sparse.add(full_range);
+    check_range_store_parity(dense, sparse, queries);
+    for(const auto &q : queries)
+      BOOST_CHECK(sparse.entire_range_filled(q));
+
+    dense.remove(full_range);
+    sparse.remove(full_range);
+    check_range_store_parity(dense, sparse, queries);
+    for(const auto &q : queries)
+      BOOST_CHECK(sparse.entire_range_empty(q));
+
+    // Random sequences of overlapping additions and removals
+    for(int i = 0; i < 64; ++i) {
+      rect r = random_rect(gen, size);
+      if(i % 3 == 2) {
+        dense.remove(r);
+        sparse.remove(r);
+        BOOST_CHECK(sparse.entire_range_empty(r));
+      } else {
+        dense.add(r);
+        sparse.add(r);
+        BOOST_CHECK(sparse.entire_range_filled(r));
+      }
+      check_range_store_parity(dense, sparse, queries);
+    }
+
+    // Removing a sub-box from a filled range must leave the rest intact
+    dense.add(full_range);
+    sparse.add(full_range);
+    dense.remove(last_page);
+    sparse.remove(last_page);
+    check_range_store_parity(dense, sparse, queries);
+    BOOST_CHECK(!sparse.entire_range_filled(full_range));
+    BOOST_CHECK(sparse.entire_range_filled(first_page) ||
+                first_page == last_page);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(data_user_tracker_buckets) {
+  using mode = sycl::access::mode;
+  // 16 pages of 4 elements along the innermost dimension, such that
+  // every page has its own bucket at the deepest level.
+  rt::data_user_tracker tracker{rt::range<3>{1, 1, 4},
+                                rt::range<3>{1, 1, 16}};
+  auto page = [](std::size_t first_page, std::size_t num_pages) {
+    return std::make_pair(rt::id<3>{0, 0, 4 * first_page},
+                          rt::range<3>{1, 1, 4 * num_pages});
+  };
+
+  // Overlapping and disjoint users within the bucket of page 0
+  auto a = make_dummy_node();
+  auto b = make_dummy_node();
+  auto c = make_dummy_node();
+  add_user(tracker, a, mode::write, rt::id<3>{0, 0, 0}, rt::range<3>{1, 1, 2});
+  add_user(tracker, b, mode::write, rt::id<3>{0, 0, 1}, rt::range<3>{1, 1, 2});
+  add_user(tracker, c, mode::write, rt::id<3>{0, 0, 3}, rt::range<3>{1, 1, 1});
+  // Users in other buckets
+  auto d = make_dummy_node();
+  auto e = make_dummy_node();
+  add_user(tracker, d, mode::write, page(15, 1).first, page(15, 1).second);
+  add_user(tracker, e, mode::read, page(8, 1).first, page(8, 1).second);
+  // User straddling the bucket boundary in the middle of the page table
+  auto f = make_dummy_node();
+  add_user(tracker, f, mode::write, page(7, 2).first, page(7, 2).second);
+
+  BOOST_CHECK_EQUAL(tracker.get_users().size(), 6);
+  for(const auto &node : {a, b, c, d, e, f})
+    BOOST_CHECK(tracker.has_user(node));
+
+  auto users = get_potentially_conflicting_users(
+      tracker, rt::id<3>{0, 0, 1}, rt::range<3>{1, 1, 1}, mode::write);
+  BOOST_CHECK(is_contained(users, a));
+  BOOST_CHECK(is_contained(users, b));
+  BOOST_CHECK(!is_contained(users, d));
+  BOOST_CHECK(!is_contained(users, e));
+
+  // The straddling user is found from both sides of the boundary
+  for(std::size_t p : {7, 8}) {
+    users = get_potentially_conflicting_users(
+        tracker, page(p, 1).first, page(p, 1).second, mode::write);
+    BOOST_CHECK(is_contained(users, f));
+    BOOST_CHECK(!is_contained(users, a));
+    BOOST_CHECK(!is_contained(users, d));
+    BOOST_CHECK_EQUAL(is_contained(users, e), p == 8);
+  }
+
+  // Accesses straddling the boundary find users on both sides
+  users = get_potentially_conflicting_users(
+      tracker, page(6, 4).first, page(6, 4).second, mode::write);
+  BOOST_CHECK(is_contained(users, e));
+  BOOST_CHECK(is_contained(users, f));
+  BOOST_CHECK(!is_contained(users, a));
+  BOOST_CHECK(!is_contained(users, d));
+
+  // Reads never conflict with other reads
+  users = get_potentially_conflicting_users(
+      tracker, page(8, 1).first, page(8, 1).second, mode::read);
+  BOOST_CHECK(!is_contained(users, e));
+  BOOST_CHECK(is_contained(users, f));
+
+  // An access to the entire range conflicts with all users
+  users = get_potentially_conflicting_users(
+      tracker, page(0, 16).first, page(0, 16).second, mode::read_write);
+  BOOST_CHECK_EQUAL(users.size(), 6);
+
+  // Copies and moves preserve all users
+  rt::data_user_tracker copy{tracker};
+  BOOST_CHECK_EQUAL(copy.get_users().size(), 6);
+  rt::data_user_tracker moved{std::move(copy)};
+  BOOST_CHECK_EQUAL(moved.get_users().size(), 6);
+  users = get_potentially_conflicting_users(
+      moved, page(15, 1).first, page(15, 1).second, mode::write);
+  BOOST_CHECK(is_contained(users, d));
+
+  // Release of completed and destroyed users
+  b->cancel();
+  f->cancel();
+  e.reset();
+  tracker.release_dead_users();
+  BOOST_CHECK_EQUAL(tracker.get_users().size(), 3);
+  BOOST_CHECK(tracker.has_user(a));
+  BOOST_CHECK(!tracker.has_user(b));
+  BOOST_CHECK(tracker.has_user(c));
+  BOOST_CHECK(tracker.has_user(d));
+  BOOST_CHECK(!tracker.has_user(f));
+  users = get_potentially_conflicting_users(
+      tracker, page(7, 2).first, page(7, 2).second, mode::write);
+  BOOST_CHECK(users.empty());
+
+  // Removal of users replaced by a new user
+  auto g = make_dummy_node();
+  tracker.add_user(g, mode::discard_write, sycl::access::target::device,
+                   page(0, 1).first, page(0, 1).second,
+                   [&](const rt::data_user &user) {
+                     return user.user.lock() == a;
+                   });
+  BOOST_CHECK(!tracker.has_user(a));
+  BOOST_CHECK(tracker.has_user(c));
+  BOOST_CHECK(tracker.has_user(g));
+  BOOST_CHECK_EQUAL(tracker.get_users().size(), 3);
+
+  for(const auto &node : {a, b, c, d, f, g})
+    node->cancel();
+  tracker.release_dead_users();
+  BOOST_CHECK(tracker.get_users().empty());
+}
+
+BOOST_AUTO_TEST_CASE(data_user_tracker_conflict_superset) {
+  using mode = sycl::access::mode;
+
+  struct user_entry {
+    rt::dag_node_ptr node;
+    mode access_mode;
+    rt::id<3> offset;
+    rt::range<3> range;
+  };
+
+  auto intersects = [](rt::id<3> offset_a, rt::range<3> range_a,
+                       rt::id<3> offset_b, rt::range<3> range_b) {
+    for(int i = 0; i < 3; ++i)
+      if(offset_a[i] >= offset_b[i] + range_b[i] ||
+         offset_b[i] >= offset_a[i] + range_a[i])
+        return false;
+    return true;
+  };
+
+  std::mt19937 gen{1234};
+  // Page counts that do and do not match the bucket structure,
+  // as well as more pages than leaf buckets
+  std::vector<rt::range<3>> num_pages{rt::range<3>{1, 1, 13},
+                                      rt::range<3>{6, 3, 1},
+                                      rt::range<3>{1, 300, 2}};
+  const rt::range<3> page_size{2, 2, 2};
+
+  for(const auto &pages : num_pages) {
+    rt::data_user_tracker tracker{page_size, pages};
+    rt::range<3> size{pages[0] * page_size[0], pages[1] * page_size[1],
+                      pages[2] * page_size[2]};
+
+    std::vector<user_entry> entries;
+    for(int i = 0; i < 64; ++i) {
+      rect r = random_rect(gen, size);
+      mode m = (i % 2 == 0) ? mode::read : mode::write;
+      auto node = make_dummy_node();
+      add_user(tracker, node, m, r.first, r.second);
+      entries.push_back(user_entry{node, m, r.first, r.second});
+    }
+    BOOST_CHECK_EQUAL(tracker.get_users().size(), entries.size());
+
+    for(int i = 0; i < 64; ++i) {
+      rect q = random_rect(gen, size);
+      mode m = (i % 2 == 0) ? mode::read : mode::write;
+      auto users = get_potentially_conflicting_users(tracker, q.first,
+                                                     q.second, m);
+      for(const auto &entry : entries) {
+        bool is_conflict =
+            (m != mode::read || entry.access_mode != mode::read) &&
+            intersects(q.first, q.second, entry.offset, entry.range);
+        if(is_conflict)
+          BOOST_CHECK(is_contained(users, entry.node));
+      }
+    }
+
+    for(const auto &entry : entries)
+      entry.node->cancel();
+    tracker.release_dead_users();
+    BOOST_CHECK(tracker.get_users().empty());
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <hipSYCL/glue/kernel_configuration.hpp>
+#include <hipSYCL/runtime/kernel_cache.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+// Returns a binary id that cannot be present in the persistent cache
+glue::kernel_configuration::id_type unique_binary_id() {
+  static std::atomic<int> counter{0};
+  glue::kernel_configuration config;
+  config.set_build_option(
+      glue::kernel_build_option::amdgpu_target_device,
+      "kernel_cache_test_" +
+          std::to_string(
+              std::chrono::steady_clock::now().time_since_epoch().count()) +
+          "_" + std::to_string(counter++));
+  return config.generate_id();
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(kernel_cache, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(throwing_jit_compilation) {
+  auto cache = rt::kernel_cache::get();
+  auto id = unique_binary_id();
+
+  auto construct = [](const std::string &) -> rt::code_object * {
+    return nullptr;
+  };
+
+  std::promise<void> compilation_started;
+  auto throwing_compile = [&](std::string &) -> bool {
+    compilation_started.set_value();
+    // Give the waiting thread time to find the compilation in flight
+    std::this_thread::sleep_for(std::chrono::milliseconds{200});
+    throw std::runtime_error{"JIT compilation failed"};
+    return false;
+  };
+
+  auto compiling_thread_result = std::async(std::launch::async, [&]() {
+    try {
+      cache->get_or_construct_jit_code_object(id, id, throwing_compile,
+                                              construct);
+    } catch (const std::runtime_error &) {
+      return true;
+    }
+    return false;
+  });
+
+  compilation_started.get_future().wait();
+
+  // The waiting thread is detached so that a hang fails the test
+  // instead of blocking it indefinitely.
+  std::atomic<int> num_compilations{0};
+  auto failing_compile = [&](std::string &) -> bool {
+    ++num_compilations;
+    return false;
+  };
+  auto waiter_result = std::make_shared<std::promise<const rt::code_object *>>();
+  std::future<const rt::code_object *> waiter_future =
+      waiter_result->get_future();
+  std::thread{[=]() mutable {
+    waiter_result->set_value(
+        cache->get_or_construct_jit_code_object(id, id, failing_compile,
+                                                construct));
+  }}.detach();
+
+  BOOST_REQUIRE(waiter_future.wait_for(std::chrono::seconds{30}) ==
+                std::future_status::ready);
+  BOOST_CHECK(waiter_future.get() == nullptr);
+  BOOST_CHECK(compiling_thread_result.get());
+
+  // The in-flight entry must be gone, so new requests compile again
+  // instead of waiting for a compilation that will never finish.
+  int compilations_before = num_compilations;
+  BOOST_CHECK(cache->get_or_construct_jit_code_object(
+                  id, id, failing_compile, construct) == nullptr);
+  BOOST_CHECK(num_compilations == compilations_before + 1);
+
+  // Same for ahead-of-time compilation
+  auto other_id = unique_binary_id();
+  auto throwing_aot_compile = [](std::string &) -> bool {
+    throw std::runtime_error{"JIT compilation failed"};
+    return false;
+  };
+  BOOST_CHECK_THROW(cache->prefetch_jit_binary(other_id, throwing_aot_compile),
+                    std::runtime_error);
+  compilations_before = num_compilations;
+  BOOST_CHECK(cache->get_or_construct_jit_code_object(
+                  other_id, other_id, failing_compile, construct) == nullptr);
+  BOOST_CHECK(num_compilations == compilations_before + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
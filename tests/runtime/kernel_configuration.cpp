@@ -0,0 +1,163 @@
+/*
+ * This file is part of hipSYCL, a SYCL implementation based on CUDA/HIP
+ *
+ * Copyright (c) 2024 Aksel Alpay and contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "runtime_test_suite.hpp"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include <hipSYCL/glue/kernel_configuration.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+glue::kernel_configuration round_trip(const glue::kernel_configuration &config) {
+  std::stringstream sstr;
+  config.serialize(sstr);
+
+  glue::kernel_configuration result;
+  BOOST_REQUIRE(glue::kernel_configuration::deserialize(sstr, result));
+  return result;
+}
+
+std::string serialize(const glue::kernel_configuration &config) {
+  std::stringstream sstr;
+  config.serialize(sstr);
+  return sstr.str();
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(kernel_configuration, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(serialization_round_trip) {
+  glue::kernel_configuration config;
+
+  config.append_base_configuration(
+      glue::kernel_base_config_parameter::backend_id, 3);
+  config.append_base_configuration(
+      glue::kernel_base_config_parameter::hcf_object_id, std::size_t{123456});
+  config.append_base_configuration(
+      glue::kernel_base_config_parameter::target_arch, "sm_80");
+
+  // S2 IR constants of all supported sizes
+  config.set_s2_ir_constant("__acpp_sscp_s2_bool", true);
+  config.set_s2_ir_constant("__acpp_sscp_s2_i8", int8_t{-3});
+  config.set_s2_ir_constant("__acpp_sscp_s2_u16", uint16_t{65535});
+  config.set_s2_ir_constant("__acpp_sscp_s2_i32", int32_t{-123456});
+  config.set_s2_ir_constant("__acpp_sscp_s2_f32", 1.5f);
+  config.set_s2_ir_constant("__acpp_sscp_s2_u64", uint64_t{0xffffffffffffffff});
+  config.set_s2_ir_constant("__acpp_sscp_s2_f64", -2.25);
+
+  // Every build option, alternating between integer and string values.
+  // String values include characters that are significant for
+  // the serialization format.
+  int i = 0;
+  for(const auto &option :
+      glue::string_build_config_mapper::string_to_build_option_map()) {
+    if(i % 3 == 0)
+      config.set_build_option(option.second, uint64_t{1} << (i + 20));
+    else if(i % 3 == 1)
+      config.set_build_option(option.second, "value with spaces\tand\n" +
+                                                 std::to_string(i));
+    else
+      config.set_build_option(option.second, std::string{});
+    ++i;
+  }
+  // Signed integers are stored as strings
+  config.set_build_option(glue::kernel_build_option::known_group_size_x, -1);
+
+  for(const auto &flag :
+      glue::string_build_config_mapper::string_to_build_flag_map())
+    config.set_build_flag(flag.second);
+
+  config.set_specialized_kernel_argument(0, 42);
+  config.set_specialized_kernel_argument(3, 0xffffffffffffffff);
+  config.set_known_alignment(1, 16);
+  config.set_known_alignment(2, 4096);
+  config.set_kernel_param_flag(1, glue::kernel_param_flag::noalias);
+  config.set_kernel_param_flag(2, glue::kernel_param_flag::noalias);
+
+  glue::kernel_configuration deserialized = round_trip(config);
+
+  BOOST_CHECK(deserialized.generate_id() == config.generate_id());
+  // Serializing again must produce the same representation
+  BOOST_CHECK_EQUAL(serialize(deserialized), serialize(config));
+
+  BOOST_CHECK_EQUAL(deserialized.s2_ir_entries().size(),
+                    config.s2_ir_entries().size());
+  BOOST_CHECK_EQUAL(deserialized.build_options().size(),
+                    config.build_options().size());
+  BOOST_CHECK_EQUAL(deserialized.build_flags().size(),
+                    config.build_flags().size());
+  BOOST_CHECK(deserialized.specialized_kernel_args() ==
+              config.specialized_kernel_args());
+  BOOST_CHECK(deserialized.known_alignments() == config.known_alignments());
+  BOOST_CHECK(deserialized.kernel_param_flags() ==
+              config.kernel_param_flags());
+
+  for(std::size_t j = 0; j < config.build_options().size(); ++j) {
+    const auto &expected = config.build_options()[j];
+    const auto &actual = deserialized.build_options()[j];
+    BOOST_CHECK(actual.first == expected.first);
+    BOOST_CHECK(actual.second.int_value == expected.second.int_value);
+    BOOST_CHECK(actual.second.string_value == expected.second.string_value);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(serialization_round_trip_empty) {
+  glue::kernel_configuration config;
+  glue::kernel_configuration deserialized = round_trip(config);
+  BOOST_CHECK(deserialized.generate_id() == config.generate_id());
+
+  config.append_base_configuration(
+      glue::kernel_base_config_parameter::backend_id, 1);
+  deserialized = round_trip(config);
+  BOOST_CHECK(deserialized.generate_id() == config.generate_id());
+}
+
+BOOST_AUTO_TEST_CASE(serialization_distinguishes_configurations) {
+  glue::kernel_configuration a;
+  a.set_known_alignment(0, 16);
+  glue::kernel_configuration b;
+  b.set_known_alignment(0, 32);
+
+  BOOST_CHECK(round_trip(a).generate_id() != round_trip(b).generate_id());
+}
+
+BOOST_AUTO_TEST_CASE(deserialization_rejects_invalid_input) {
+  glue::kernel_configuration out;
+  std::stringstream unknown_option{"0 0 0 1 no-such-option i 1 0"};
+  BOOST_CHECK(!glue::kernel_configuration::deserialize(unknown_option, out));
+
+  std::stringstream truncated{"0 0 1 name 4"};
+  BOOST_CHECK(!glue::kernel_configuration::deserialize(truncated, out));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
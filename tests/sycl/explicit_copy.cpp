@@ -143,7 +143,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(explicit_buffer_copy_host_ptr, _dimensions,
 }
 
 template<int d, typename callback>
-void run_two_accessors_copy_test(const callback& copy_cb) {
+void run_two_accessors_copy_test(const callback& copy_cb,
+                                 cl::sycl::queue queue = cl::sycl::queue{}) {
   namespace s = cl::sycl;
 
   const auto src_buf_size = make_test_value<s::range, d>(
@@ -175,7 +176,6 @@ void run_two_accessors_copy_test(const callback& copy_cb) {
   }
 
   // Copy part of larger buffer into smaller buffer
-  s::queue queue;
   queue.submit([&](s::handler& cgh) {
     copy_cb(cgh, copy_range, src_buf, src_offset, dst_buf, s::id<d>(dst_offset));
   });
@@ -213,4 +213,31 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(explicit_buffer_copy_two_accessors_d2d,
     });
 }
 
+// OpenCL has no rectangular USM copy, so strided device-to-device copies
+// go through a built-in copy kernel.
+BOOST_AUTO_TEST_CASE_TEMPLATE(explicit_buffer_copy_two_accessors_d2d_ocl_cpu,
+  _dimensions, explicit_copy_test_dimensions::type) {
+  constexpr auto d = _dimensions::value;
+  namespace s = cl::sycl;
+
+  auto devs = s::device::get_devices(s::info::device_type::cpu);
+  auto ocl_dev = std::find_if(devs.begin(), devs.end(), [](const s::device &dev) {
+    return dev.get_backend() == s::backend::ocl;
+  });
+  if(ocl_dev == devs.end()) {
+    BOOST_TEST_MESSAGE("No OpenCL CPU device available, skipping test");
+    return;
+  }
+
+  run_two_accessors_copy_test<d>([](s::handler& cgh, s::range<d> copy_range,
+    s::buffer<s::id<d>, d>& src_buf, s::id<d> src_offset,
+    s::buffer<s::id<d>, d>& dst_buf, s::id<d> dst_offset) {
+      auto src_acc = src_buf.template get_access<s::access::mode::read>(
+        cgh, copy_range, src_offset);
+      auto dst_acc = dst_buf.template get_access<s::access::mode::discard_write>(
+        cgh, copy_range, s::id<d>(dst_offset));
+      cgh.copy(src_acc, dst_acc);
+    }, s::queue{*ocl_dev});
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -898,6 +898,70 @@ BOOST_AUTO_TEST_CASE(buffer_page_size) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(buffer_sparse_page_table) {
+  using namespace cl;
+
+  sycl::queue q;
+
+  const std::size_t size = 100;
+  const std::size_t page_size = 16;
+  const std::size_t tile_size = 24;
+  sycl::buffer<int, 2> dense{sycl::range{size, size},
+                             sycl::property::buffer::hipSYCL_page_size<2>{
+                                 sycl::range{page_size, page_size}}};
+  sycl::buffer<int, 2> sparse{
+      sycl::range{size, size},
+      sycl::property_list{sycl::property::buffer::hipSYCL_page_size<2>{
+                              sycl::range{page_size, page_size}},
+                          sycl::property::buffer::hipSYCL_sparse_page_table{}}};
+
+  // Tiles that are not aligned to pages cause partially valid pages,
+  // overlapping accesses and boundary pages.
+  for(auto* buff : {&dense, &sparse}) {
+    for(std::size_t offset_x = 0; offset_x < size; offset_x += tile_size) {
+      for(std::size_t offset_y = 0; offset_y < size; offset_y += tile_size) {
+        q.submit([&](sycl::handler &cgh) {
+          sycl::range range{std::min(tile_size, size - offset_x),
+                            std::min(tile_size, size - offset_y)};
+          sycl::id offset{offset_x, offset_y};
+          sycl::accessor<int, 2> acc{*buff, cgh, range, offset,
+                                     sycl::write_only, sycl::no_init};
+          cgh.parallel_for(range, [=](sycl::id<2> idx) {
+            acc[idx] = static_cast<int>((idx[0] + offset[0]) * size +
+                                        idx[1] + offset[1]);
+          });
+        });
+      }
+    }
+    // Host access to a sub-range invalidates parts of the device data
+    {
+      sycl::host_accessor<int, 2> hacc{*buff, sycl::range{size / 3, size / 2},
+                                       sycl::id{size / 5, size / 7}};
+      for(std::size_t i = 0; i < size / 3; ++i)
+        for(std::size_t j = 0; j < size / 2; ++j)
+          hacc[i][j] = -hacc[i][j];
+    }
+    q.submit([&](sycl::handler &cgh) {
+      sycl::accessor<int, 2> acc{*buff, cgh, sycl::read_write};
+      cgh.parallel_for(sycl::range{size, size},
+                       [=](sycl::id<2> idx) { acc[idx] += 1; });
+    });
+  }
+
+  sycl::host_accessor<int, 2> dense_acc{dense, sycl::read_only};
+  sycl::host_accessor<int, 2> sparse_acc{sparse, sycl::read_only};
+  for(std::size_t i = 0; i < size; ++i) {
+    for(std::size_t j = 0; j < size; ++j) {
+      int expected = static_cast<int>(i * size + j);
+      if(i >= size / 5 && i < size / 5 + size / 3 && j >= size / 7 &&
+         j < size / 7 + size / 2)
+        expected = -expected;
+      BOOST_REQUIRE(dense_acc[i][j] == expected + 1);
+      BOOST_REQUIRE(sparse_acc[i][j] == dense_acc[i][j]);
+    }
+  }
+}
+
 #endif
 #ifdef HIPSYCL_EXT_EXPLICIT_BUFFER_POLICIES
 BOOST_AUTO_TEST_CASE(explicit_buffer_policies) {